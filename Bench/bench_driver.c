@@ -0,0 +1,1330 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <getopt.h>
+#include <signal.h>
+#include <unistd.h>
+#include <net/if.h>
+#include <arpa/inet.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/utsname.h>
+#include <openssl/ssl.h>
+#include <openssl/err.h>
+#include <openssl/crypto.h>
+#include "../Common/metrics.h"
+#include "../Common/json_output.h"
+#include "../Common/tls_context.h"
+#include "../Common/handshake_trace.h"
+#include "../Common/count_bio.h"
+#include "../Common/prim_bench.h"
+#include "../Common/perf_counters.h"
+#include "../Common/mem_track.h"
+#include "../Common/cert_comp.h"
+#include "../Common/net_emu.h"
+#include "../Common/tcp_stats.h"
+#include "../Common/pcap_writer.h"
+#include "../Common/algo_config.h"
+#include "../Server/server_engine.h"
+#include "../Server/verify_cache.h"
+#include "../Client/resume_client.h"
+#include "../Client/load_client.h"
+#include "../Client/bulk_client.h"
+
+#define DEFAULT_CERTS_DIR "certs"
+#define DEFAULT_RESULTS_DIR "results"
+#define DEFAULT_RUNS 30
+#define DEFAULT_WARMUP 5
+#define DEFAULT_PRIM_ITERATIONS 200
+#define CERT_COMP_ITERATIONS 200
+#define BUFFER_SIZE 4096
+#define POOL_COMPARE_CONNECTIONS 8
+#define IO_COMPARE_CONNECTIONS 8
+#define MAX_SERVER_WORKERS 64
+#define SCALING_CONNECTIONS_PER_WORKER 4    // 곡선 전체에서 동시 연결 = 4 × 최대 워커 수 (단계마다 같은 부하)
+#define DEFAULT_SCALING_DURATION 2.0
+#define BULK_MAX_SIZES 8                    // --bulk-writes/--bulk-fragments 목록 최대 길이
+#define BULK_MODES 3
+
+typedef struct {
+    const char *certs_dir;
+    const char *results_dir;
+    const char *only;          // 특정 조합만 ("group:sigalg")
+    int runs;
+    int warmup;
+    int server_threads;
+    int resumptions;           // >0: 조합별 PSK 재개 측정 (모드당 M회)
+    bool early_data;
+    int prim_iterations;       // 조합별 EVP 단일 연산 측정 횟수 (0: 생략)
+    bool alloc_pool;           // OpenSSL 할당을 크기 클래스 풀로 처리
+    const char *cert_comp;     // 인증서 압축 선호 목록 (NULL: 비압축 기준선)
+    bool precompress;          // 서버 체인 미리 압축
+    net_emu_config_t netem;    // 클라이언트와 서버 엔진 사이 링크 에뮬레이션 (미설정: 직접 연결)
+    bool nodelay;              // 클라이언트/서버 소켓에 TCP_NODELAY
+    const char *pcap_dir;      // 측정 핸드셰이크를 조합별 pcap으로 기록 (클라이언트 쪽)
+    const char *client_groups; // 클라이언트 제시 그룹 목록 (NULL: 조합 그룹)
+    const char *server_groups; // 서버 선호 그룹 목록 (NULL: 조합 그룹)
+    int verify_cache;          // >0: 서버 클라이언트 체인 검증 캐시 크기 (워밍업이 캐시를 채움)
+    int ssl_pool;              // 서버 엔진 워커별 SSL 객체 재사용 슬롯 수 (0: 연결마다 SSL_new)
+    bool release_buffers;      // 서버 SSL_MODE_RELEASE_BUFFERS
+    double pool_compare;       // >0: 조합별로 SSL_new 경로와 재사용 경로의 closed-loop 처리율을 S초씩 비교
+    bool reuseport;            // 측정 엔진 워커마다 SO_REUSEPORT 리스너
+    bool cbpf;                 // SO_REUSEPORT 그룹에 수신 CPU 조향 CBPF 연결
+    bool pin_cpus;             // 서버 워커 i를 허용 CPU(sched_getaffinity) 중 i번째에 고정
+    int scaling_max;           // >0: 조합별 워커 1..N 처리율 곡선 (공유 리스너 vs SO_REUSEPORT)
+    double scaling_duration;   // 곡선 단계별 closed-loop 시간(초)
+    bool io_uring;             // 서버 엔진 워커 I/O를 io_uring으로 (처리율 부하 생성기도 같이)
+    double io_compare;         // >0: 조합별로 epoll 경로와 io_uring 경로의 closed-loop 처리율/시스템 콜을 S초씩 비교
+    double bulk_mib;            // >0: 조합별 핸드셰이크 후 대량 전송 (전송 1회 MiB)
+    int bulk_writes[BULK_MAX_SIZES];     // SSL_write(SSL_sendfile) 1회 크기
+    int bulk_write_count;
+    int bulk_fragments[BULK_MAX_SIZES];  // SSL_set_max_send_fragment
+    int bulk_fragment_count;
+    bool ktls;                 // 대량 전송에 kTLS SSL_write / SSL_sendfile 행 추가
+} driver_config_t;
+
+// closed-loop 부하 1회 구성 (서버 엔진을 새로 띄움)
+typedef struct {
+    int workers;
+    int ssl_pool;
+    bool reuseport;
+    bool io_uring;             // 서버 엔진과 부하 생성기 모두
+    int connections;
+    int client_threads;
+    double duration_s;
+} load_plan_t;
+
+// closed-loop 부하 1회 결과
+typedef struct {
+    double handshakes_per_sec;
+    double p99_ms;             // SSL_connect 구간
+    double server_allocs;      // 전체 핸드셰이크당 서버 OpenSSL 할당 횟수
+    double server_cpu_ms;
+    uint64_t listen_overflows; // 시스템 전체 ListenOverflows 증가분 (측정 구간)
+    double imbalance;          // 워커별 최대 수락 수 / 평균 (1.0: 균등)
+    // 연결당 시스템 콜과 소켓 요청 (서버: 수락한 연결, 클라이언트: 시작한 연결 기준, 두 경로 같은 집계)
+    double syscalls_per_conn;
+    double io_ops_per_conn;
+    double client_syscalls_per_conn;
+    double client_io_ops_per_conn;
+    bool client_io_uring;      // 부하 생성기가 실제로 io_uring으로 동작함
+} load_run_t;
+
+// 처리율 곡선의 한 점
+typedef struct {
+    int workers;
+    bool ok;
+    load_run_t shared;         // 모든 워커가 리스너 1개 공유 (EPOLLEXCLUSIVE)
+    load_run_t reuseport;      // 워커별 SO_REUSEPORT 리스너
+} scaling_point_t;
+
+// 대량 전송 경로: 사용자 공간 레코드 암호화, kTLS SSL_write, kTLS SSL_sendfile
+typedef enum {
+    BULK_SSL_WRITE,
+    BULK_KTLS_WRITE,
+    BULK_KTLS_SENDFILE
+} bulk_mode_t;
+
+static const char *bulk_mode_names[BULK_MODES] = { "ssl_write", "ktls_write", "ktls_sendfile" };
+
+// 대량 전송 표의 한 행
+typedef struct {
+    bulk_mode_t mode;
+    int write_size;
+    int fragment;              // max_send_fragment (0: sendfile 행, 커널이 레코드를 나눠 해당 없음)
+    bool ok;
+    bulk_result_t result;
+} bulk_point_t;
+
+// 결과 파일에 넣지 않는 조합별 출력 항목
+typedef struct {
+    verify_stats_t verify;
+    double server_allocs;      // 측정 엔진의 핸드셰이크당 서버 할당 (워밍업 포함)
+    uint64_t ssl_new;
+    uint64_t ssl_reused;
+    bool pool_compared;
+    load_run_t pool_runs[2];   // [0] 연결마다 SSL_new, [1] --ssl-pool 재사용 (미지정 시 동시 연결 수만큼)
+    double server_syscalls;    // 측정 엔진의 연결당 서버 시스템 콜
+    double server_io_ops;      // 측정 엔진의 연결당 서버 소켓 요청
+    bool io_compared;
+    load_run_t io_runs[2];     // [0] epoll, [1] io_uring
+    int scaling_count;
+    scaling_point_t scaling[MAX_SERVER_WORKERS];
+    int bulk_count;
+    bool ktls_unavailable;     // 커널이 kTLS 송신을 켜지 않음 (tls ULP 없음 등), kTLS 행 생략
+    bulk_point_t bulk[BULK_MAX_SIZES * BULK_MAX_SIZES * BULK_MODES];
+} combo_report_t;
+
+// 조합별 인증서/컨텍스트 설정
+typedef struct {
+    char server_cert[600];
+    char server_key[600];
+    char client_cert[600];
+    char client_key[600];
+    char ca_cert[600];
+} combo_files_t;
+
+static void combo_paths(const char *certs_dir, const char *group, const char *sigalg, combo_files_t *f) {
+    snprintf(f->server_cert, sizeof(f->server_cert), "%s/%s_%s_server.crt", certs_dir, group, sigalg);
+    snprintf(f->server_key, sizeof(f->server_key), "%s/%s_%s_server.key", certs_dir, group, sigalg);
+    snprintf(f->client_cert, sizeof(f->client_cert), "%s/%s_%s_client.crt", certs_dir, group, sigalg);
+    snprintf(f->client_key, sizeof(f->client_key), "%s/%s_%s_client.key", certs_dir, group, sigalg);
+    snprintf(f->ca_cert, sizeof(f->ca_cert), "%s/ca.crt", certs_dir);
+}
+
+// 루프백 임시 포트에 리스너 생성 (포트 충돌/재시작 대기 없음)
+static int create_loopback_listener(struct sockaddr_in *addr) {
+    int sock = socket(AF_INET, SOCK_STREAM, 0);
+    if (sock < 0) {
+        perror("Unable to create socket");
+        return -1;
+    }
+
+    memset(addr, 0, sizeof(*addr));
+    addr->sin_family = AF_INET;
+    addr->sin_port = 0;
+    addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    socklen_t len = sizeof(*addr);
+    if (bind(sock, (struct sockaddr*)addr, sizeof(*addr)) < 0 ||
+        listen(sock, SOMAXCONN) < 0 ||
+        getsockname(sock, (struct sockaddr*)addr, &len) < 0) {
+        perror("Unable to listen on loopback");
+        close(sock);
+        return -1;
+    }
+    return sock;
+}
+
+// 단일 핸드셰이크 (tls_client와 동일한 흐름: 핸드셰이크 → 메시지 → 응답)
+static void client_handshake(SSL_CTX *ctx, const struct sockaddr_in *addr, bool nodelay,
+                             pcap_file_t *pcap, handshake_metrics_t *metrics) {
+    bench_timer_t timer;
+    hs_trace_t trace;
+    wire_count_t wire;
+    tcp_sample_t tcp_start, tcp_end;
+    perf_values_t perf_start, perf = {0};
+    mem_account_t heap = {0};
+
+    init_handshake_metrics(metrics);
+
+    int sock = socket(AF_INET, SOCK_STREAM, 0);
+    if (sock < 0 || connect(sock, (const struct sockaddr*)addr, sizeof(*addr)) < 0) {
+        snprintf(metrics->error_msg, sizeof(metrics->error_msg), "connect failed");
+        if (sock >= 0) close(sock);
+        return;
+    }
+    if (nodelay) {
+        tcp_set_nodelay(sock, true);
+    }
+
+    // SSL_new부터 SSL_free까지 이 연결의 OpenSSL 할당을 heap 계정에 기록
+    mem_track_switch(&heap);
+    SSL *ssl = SSL_new(ctx);
+    if (!ssl || !count_bio_attach(ssl, sock, &wire)) {
+        snprintf(metrics->error_msg, sizeof(metrics->error_msg), "SSL_new failed");
+        SSL_free(ssl);
+        mem_track_switch(NULL);
+        close(sock);
+        return;
+    }
+    hs_trace_attach(ssl, &trace);
+    wire.capture = pcap_flow_new(pcap, sock, false);
+
+    tcp_sample(sock, &tcp_start);
+    start_timer(&timer);
+    perf_begin(&perf_start);
+    int ret = SSL_connect(ssl);
+    perf_end(&perf_start, &perf);
+    double elapsed = end_timer(&timer);
+    tcp_sample(sock, &tcp_end);
+    hs_trace_detach(ssl);
+
+    if (ret == 1) {
+        metrics->t_handshake_total_ms = elapsed;
+        metrics->success = true;
+        hs_trace_fill_metrics(&trace, false, metrics);
+        count_bio_fill_traffic(&wire, &metrics->traffic);
+        tcp_fill_traffic(&tcp_start, &tcp_end, false, &metrics->traffic);
+        perf_fill_resources(&perf, &metrics->resources);
+        mem_fill_resources(&heap, &metrics->resources);
+
+        const char *msg = "Hello from client";
+        char buf[BUFFER_SIZE];
+        SSL_write(ssl, msg, strlen(msg));
+        SSL_read(ssl, buf, sizeof(buf));
+    } else {
+        snprintf(metrics->error_msg, sizeof(metrics->error_msg),
+                 "SSL_connect failed with error %d", SSL_get_error(ssl, ret));
+    }
+
+    SSL_shutdown(ssl);
+    SSL_free(ssl);
+    mem_track_switch(NULL);
+    pcap_flow_free(wire.capture);
+    close(sock);
+    ERR_clear_error();
+}
+
+// 엔진 리스너: 공유 소켓 1개 또는 워커별 SO_REUSEPORT 소켓 (fds[0]이 listen_fd), 반환: 연 소켓 수 (실패 0)
+static int open_listeners(const driver_config_t *config, int workers, bool reuseport, struct sockaddr_in *addr,
+                          int *fds) {
+    if (!reuseport) {
+        fds[0] = create_loopback_listener(addr);
+        return fds[0] < 0 ? 0 : 1;
+    }
+    memset(addr, 0, sizeof(*addr));
+    addr->sin_family = AF_INET;
+    addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return engine_reuseport_listeners(addr, workers, SOMAXCONN, config->cbpf, fds) == 0 ? workers : 0;
+}
+
+static void close_listeners(const int *fds, int count) {
+    for (int i = 0; i < count; i++) {
+        close(fds[i]);
+    }
+}
+
+// 같은 컨텍스트로 엔진을 새로 띄워 closed-loop 부하 실행
+static bool engine_load(const driver_config_t *config, SSL_CTX *server_ctx, SSL_CTX *client_ctx,
+                        const load_plan_t *plan, load_run_t *run) {
+    struct sockaddr_in addr;
+    int fds[MAX_SERVER_WORKERS];
+    int nfds = open_listeners(config, plan->workers, plan->reuseport, &addr, fds);
+    if (nfds == 0) {
+        return false;
+    }
+    engine_config_t engine_config = {
+        .ctx = server_ctx,
+        .listen_fd = fds[0],
+        .worker_listen_fds = plan->reuseport ? fds : NULL,
+        .pin_cpus = config->pin_cpus,
+        .num_workers = plan->workers,
+        .verbose = false,
+        .nodelay = config->nodelay,
+        .ssl_pool = plan->ssl_pool,
+        .release_buffers = config->release_buffers,
+        .io_uring = plan->io_uring
+    };
+    server_engine_t *engine = engine_start(&engine_config);
+    if (!engine) {
+        close_listeners(fds, nfds);
+        return false;
+    }
+    load_config_t load = {
+        .ctx = client_ctx,
+        .host = "127.0.0.1",
+        .port = ntohs(addr.sin_port),
+        .connections = plan->connections,
+        .threads = plan->client_threads,
+        .duration_s = plan->duration_s,
+        .io_uring = plan->io_uring
+    };
+    load_result_t result;
+    uint64_t overflows_start, overflows_end, drops;
+    bool counted = tcp_listen_overflows(&overflows_start, &drops);
+    int rc = run_closed_loop(&load, &result);
+    counted = tcp_listen_overflows(&overflows_end, &drops) && counted;
+    engine_stats_t stats;
+    engine_stop(engine, &stats);
+    close_listeners(fds, nfds);
+
+    uint64_t full = stats.handshakes_ok - stats.resumed;
+    if (rc != 0 || full == 0) {
+        return false;
+    }
+    run->handshakes_per_sec = result.handshakes_per_sec;
+    run->p99_ms = result.latency_ms.p99;
+    run->server_allocs = (double)stats.heap_allocs_sum / full;
+    run->server_cpu_ms = stats.cpu_ns_sum / 1e6 / full;
+    run->listen_overflows = counted ? overflows_end - overflows_start : 0;
+    run->imbalance = (double)stats.accepted_max * plan->workers / stats.accepted;
+    run->syscalls_per_conn = (double)stats.syscalls / stats.accepted;
+    run->io_ops_per_conn = (double)stats.io_ops / stats.accepted;
+    run->client_syscalls_per_conn = result.connects ? (double)result.syscalls / result.connects : 0;
+    run->client_io_ops_per_conn = result.connects ? (double)result.io_ops / result.connects : 0;
+    run->client_io_uring = result.io_uring;
+    return true;
+}
+
+// 워커 1..N 처리율 곡선: 같은 부하(동시 연결 고정)에서 공유 리스너와 SO_REUSEPORT 리스너를 각각 측정
+static void scaling_curve(const driver_config_t *config, SSL_CTX *server_ctx, SSL_CTX *client_ctx,
+                          combo_report_t *report) {
+    int ncpu = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    load_plan_t plan = {
+        .ssl_pool = config->ssl_pool,
+        .io_uring = config->io_uring,
+        .connections = SCALING_CONNECTIONS_PER_WORKER * config->scaling_max,
+        .client_threads = ncpu > 0 ? ncpu : 1,
+        .duration_s = config->scaling_duration
+    };
+    for (int w = 1; w <= config->scaling_max; w++) {
+        scaling_point_t *p = &report->scaling[report->scaling_count++];
+        p->workers = w;
+        plan.workers = w;
+        plan.reuseport = false;
+        p->ok = engine_load(config, server_ctx, client_ctx, &plan, &p->shared);
+        plan.reuseport = true;
+        p->ok = engine_load(config, server_ctx, client_ctx, &plan, &p->reuseport) && p->ok;
+    }
+}
+
+// 핸드셰이크 CPU만으로 낼 수 있는 처리율 (워커 수와 코어 수 중 작은 값 × 1 / 핸드셰이크당 서버 CPU)
+static double crypto_ceiling(int workers, double server_cpu_ms) {
+    int ncpu = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int cores = ncpu > 0 && ncpu < workers ? ncpu : workers;
+    return server_cpu_ms > 0 ? cores * 1000.0 / server_cpu_ms : 0.0;
+}
+
+// 조합별 곡선 출력, 공유 리스너가 SO_REUSEPORT보다 10% 이상 느려지는 첫 워커 수를 수락 큐 경합 시작으로 판정
+static void print_scaling(const combo_report_t *report) {
+    int contention = 0;
+    printf("        scaling: %7s %12s %12s %10s %12s %9s %9s\n", "workers", "shared/s", "reuseport/s",
+           "srv CPU ms", "crypto max/s", "overflows", "imbalance");
+    for (int i = 0; i < report->scaling_count; i++) {
+        const scaling_point_t *p = &report->scaling[i];
+        if (!p->ok) {
+            printf("        scaling: %7d (failed)\n", p->workers);
+            continue;
+        }
+        printf("        scaling: %7d %12.1f %12.1f %10.3f %12.1f %9lu %9.2f\n", p->workers,
+               p->shared.handshakes_per_sec, p->reuseport.handshakes_per_sec, p->reuseport.server_cpu_ms,
+               crypto_ceiling(p->workers, p->reuseport.server_cpu_ms),
+               (unsigned long)(p->shared.listen_overflows + p->reuseport.listen_overflows),
+               p->reuseport.imbalance);
+        if (contention == 0 && p->shared.handshakes_per_sec < 0.9 * p->reuseport.handshakes_per_sec) {
+            contention = p->workers;
+        }
+    }
+    if (contention > 0) {
+        printf("        scaling: shared accept queue caps throughput from %d worker(s)\n", contention);
+    } else if (report->scaling_count > 0) {
+        printf("        scaling: no accept-queue cap up to %d worker(s) (handshake CPU bound)\n",
+               report->scaling[report->scaling_count - 1].workers);
+    }
+}
+
+static void write_scaling_csv(FILE *fp, const algo_combo_t *combo, const combo_report_t *report) {
+    for (int i = 0; i < report->scaling_count; i++) {
+        const scaling_point_t *p = &report->scaling[i];
+        const load_run_t *runs[2] = { &p->shared, &p->reuseport };
+        for (int l = 0; p->ok && l < 2; l++) {
+            fprintf(fp, "%s,%s,%d,%s,%.1f,%.3f,%.3f,%.1f,%lu,%.2f\n", combo->group, combo->sigalg, p->workers,
+                    l == 0 ? "shared" : "reuseport", runs[l]->handshakes_per_sec, runs[l]->p99_ms,
+                    runs[l]->server_cpu_ms, crypto_ceiling(p->workers, runs[l]->server_cpu_ms),
+                    (unsigned long)runs[l]->listen_overflows, runs[l]->imbalance);
+        }
+    }
+}
+
+// 핸드셰이크 후 대량 전송: 레코드 크기 × 쓰기 크기 × 경로 (연결마다 새 핸드셰이크)
+static void bulk_sweep(const driver_config_t *config, SSL_CTX *server_ctx, SSL_CTX *client_ctx,
+                       combo_report_t *report) {
+    int modes = config->ktls ? BULK_MODES : 1;
+    for (int f = 0; f < config->bulk_fragment_count; f++) {
+        for (int w = 0; w < config->bulk_write_count; w++) {
+            for (int m = 0; m < modes; m++) {
+                if (m != BULK_SSL_WRITE && report->ktls_unavailable) {
+                    continue;
+                }
+                // sendfile은 커널이 레코드를 나누므로 max_send_fragment 무관: 쓰기 크기마다 1회 (fragment 0 = 해당 없음)
+                if (m == BULK_KTLS_SENDFILE && f > 0) {
+                    continue;
+                }
+                bulk_point_t *p = &report->bulk[report->bulk_count++];
+                p->mode = m;
+                p->write_size = config->bulk_writes[w];
+                p->fragment = m == BULK_KTLS_SENDFILE ? 0 : config->bulk_fragments[f];
+                bulk_config_t bulk = {
+                    .server_ctx = server_ctx,
+                    .client_ctx = client_ctx,
+                    .total_bytes = (size_t)(config->bulk_mib * (1 << 20)),
+                    .write_size = p->write_size,
+                    .max_fragment = config->bulk_fragments[f],
+                    .ktls = m != BULK_SSL_WRITE,
+                    .sendfile = m == BULK_KTLS_SENDFILE
+                };
+                p->ok = run_bulk_transfer(&bulk, &p->result) == 0;
+                // kTLS가 켜지지 않으면 사용자 공간 행과 같으므로 버림
+                if (p->ok && m != BULK_SSL_WRITE && !p->result.ktls_send) {
+                    report->ktls_unavailable = true;
+                    report->bulk_count--;
+                }
+            }
+        }
+    }
+}
+
+static void print_bulk(const driver_config_t *config, const combo_report_t *report) {
+    printf("        bulk: %-13s %7s %8s %7s %11s %11s %14s %14s\n", "mode", "write", "fragment", "GiB/s",
+           "send ms/GiB", "recv ms/GiB", "send calls/MiB", "recv calls/MiB");
+    for (int i = 0; i < report->bulk_count; i++) {
+        const bulk_point_t *p = &report->bulk[i];
+        char fragment[16] = "-";
+        if (p->fragment > 0) {
+            snprintf(fragment, sizeof(fragment), "%d", p->fragment);
+        }
+        if (!p->ok) {
+            printf("        bulk: %-13s %7d %8s (failed)\n", bulk_mode_names[p->mode], p->write_size, fragment);
+            continue;
+        }
+        const bulk_result_t *r = &p->result;
+        printf("        bulk: %-13s %7d %8s %7.3f %11.1f %11.1f %14.1f %14.1f%s\n", bulk_mode_names[p->mode],
+               p->write_size, fragment, r->gib_per_sec, r->sender_cpu_ms_per_gib, r->receiver_cpu_ms_per_gib,
+               r->sender_syscalls_per_mib, r->receiver_syscalls_per_mib,
+               r->ktls_recv ? " (kTLS rx)" : "");
+    }
+    if (config->ktls && report->ktls_unavailable) {
+        printf("        bulk: kTLS not enabled by the kernel (tls ULP not loaded?), kTLS rows skipped\n");
+    }
+}
+
+static void write_bulk_csv(FILE *fp, const algo_combo_t *combo, const combo_report_t *report) {
+    for (int i = 0; i < report->bulk_count; i++) {
+        const bulk_point_t *p = &report->bulk[i];
+        const bulk_result_t *r = &p->result;
+        if (!p->ok) {
+            continue;
+        }
+        fprintf(fp, "%s,%s,%s,%d,%d,%.4f,%.1f,%.1f,%.2f,%.2f,%d,%d\n", combo->group, combo->sigalg,
+                bulk_mode_names[p->mode], p->write_size, p->fragment, r->gib_per_sec, r->sender_cpu_ms_per_gib,
+                r->receiver_cpu_ms_per_gib, r->sender_syscalls_per_mib, r->receiver_syscalls_per_mib,
+                r->ktls_send, r->ktls_recv);
+    }
+}
+
+// 사용자 공간 경로의 최고 처리율 (조합 간 비교용, 0: 없음)
+static double bulk_best(const combo_report_t *report) {
+    double best = 0;
+    for (int i = 0; i < report->bulk_count; i++) {
+        const bulk_point_t *p = &report->bulk[i];
+        if (p->ok && p->mode == BULK_SSL_WRITE && p->result.gib_per_sec > best) {
+            best = p->result.gib_per_sec;
+        }
+    }
+    return best;
+}
+
+// 조합 1개: 서버 1회 기동 → 워밍업 → N회 측정 → 집계 (실패 시 reason에 원인)
+// cache: 서버 컨텍스트에 붙일 체인 검증 캐시 (NULL: 매번 전체 검증), report: 출력 전용 항목
+static bool run_combo(const driver_config_t *config, const algo_combo_t *combo, verify_cache_t *cache,
+                      combo_report_t *report, benchmark_result_t *result, const char **reason) {
+    const char *group = combo->ossl_group;
+    const char *sigalg = combo->ossl_sigalg;
+    combo_files_t files;
+    bool ok = false;
+
+    init_benchmark_result(result);
+    memset(report, 0, sizeof(combo_report_t));
+    snprintf(result->group, sizeof(result->group), "%s", combo->group);
+    snprintf(result->sigalg, sizeof(result->sigalg), "%s", combo->sigalg);
+
+    if (!algo_combo_probe(combo, reason)) {
+        return false;
+    }
+    *reason = "certificate or context setup failed";
+
+    // 조합 그룹은 인증서 선택에만 쓰고, 쪽별 목록이 있으면 키 교환은 그 목록으로 (HRR/key_share 예측)
+    combo_paths(config->certs_dir, group, sigalg, &files);
+    tls_ctx_config_t server_config = {
+        .cert_file = files.server_cert, .key_file = files.server_key, .ca_file = files.ca_cert,
+        .groups = config->server_groups ? config->server_groups : group, .sigalgs = sigalg,
+        .early_data = config->early_data,
+        .psk_ke = config->resumptions > 0,
+        .cert_comp = config->cert_comp,
+        .cert_precompress = config->precompress
+    };
+    tls_ctx_config_t client_config = {
+        .cert_file = files.client_cert, .key_file = files.client_key, .ca_file = files.ca_cert,
+        .groups = config->client_groups ? config->client_groups : group, .sigalgs = sigalg,
+        .cert_comp = config->cert_comp
+    };
+
+    SSL_CTX *server_ctx = create_server_context(&server_config);
+    SSL_CTX *client_ctx = server_ctx ? create_client_context(&client_config) : NULL;
+    handshake_metrics_t *metrics = calloc(config->runs, sizeof(handshake_metrics_t));
+    struct sockaddr_in addr, proxy_addr;
+    int listen_fds[MAX_SERVER_WORKERS];
+    int listen_count = 0, proxy_fd = -1;
+    server_engine_t *engine = NULL;
+    net_emu_t *emu = NULL;
+    pcap_file_t *pcap = NULL;
+
+    if (!server_ctx || !client_ctx || !metrics) {
+        goto done;
+    }
+
+    if (cache) {
+        verify_cache_attach(server_ctx, cache, &report->verify, "verify:");
+    }
+
+    listen_count = open_listeners(config, config->server_threads, config->reuseport, &addr, listen_fds);
+    if (listen_count == 0) {
+        goto done;
+    }
+
+    engine_config_t engine_config = {
+        .ctx = server_ctx,
+        .listen_fd = listen_fds[0],
+        .worker_listen_fds = config->reuseport ? listen_fds : NULL,
+        .pin_cpus = config->pin_cpus,
+        .num_workers = config->server_threads,
+        .verbose = false,
+        .nodelay = config->nodelay,
+        .ssl_pool = config->ssl_pool,
+        .release_buffers = config->release_buffers,
+        .io_uring = config->io_uring
+    };
+    engine = engine_start(&engine_config);
+    if (!engine) {
+        goto done;
+    }
+
+    // 링크 에뮬레이션: 클라이언트 → 중계기 → 서버 엔진
+    const struct sockaddr_in *target = &addr;
+    if (net_emu_enabled(&config->netem)) {
+        proxy_fd = create_loopback_listener(&proxy_addr);
+        emu = proxy_fd >= 0 ? net_emu_start(&config->netem, proxy_fd, &addr) : NULL;
+        if (!emu) {
+            goto done;
+        }
+        target = &proxy_addr;
+    }
+
+    handshake_metrics_t warm;
+    for (int i = 0; i < config->warmup; i++) {
+        client_handshake(client_ctx, target, config->nodelay, NULL, &warm);
+    }
+
+    if (config->pcap_dir) {
+        char path[512];
+        pcap_combo_path(path, sizeof(path), config->pcap_dir, combo->group, combo->sigalg, "client");
+        pcap = pcap_open(path, false);
+    }
+
+    for (int i = 0; i < config->runs; i++) {
+        client_handshake(client_ctx, target, config->nodelay, pcap, &metrics[i]);
+        // 중계기 경유 시 루프백 소켓의 cwnd/MSS 대신 에뮬레이션한 링크 기준으로 왕복 수 추정
+        //  (클라이언트 소켓 cwnd는 서버 비행과 무관하므로 --initcwnd가 없으면 기본 초기 윈도)
+        if (emu) {
+            traffic_metrics_t *t = &metrics[i].traffic;
+            uint32_t cwnd = config->netem.initcwnd > 0 ? (uint32_t)config->netem.initcwnd : TCP_INIT_CWND;
+            t->server_flight_rounds =
+                tcp_flight_rounds(t->server_flight_bytes, net_emu_segment_size(&config->netem), cwnd);
+        }
+    }
+
+    aggregate_metrics(metrics, config->runs, result);
+    ok = result->successful_runs > 0;
+    *reason = ok ? NULL : "no successful handshake";
+
+    // 핸드셰이크와 분리한 KEM/서명 단일 연산 시간 (집계된 crypto_avg는 그대로 둠)
+    if (ok && config->prim_iterations > 0) {
+        prim_measure(combo->group, combo->sigalg, config->prim_iterations, &result->prim_ms);
+    }
+
+    // 서버 체인 압축/해제 CPU (협상된 알고리즘, 없으면 목록의 첫 번째)
+    if (ok && config->cert_comp) {
+        int algs[CERT_COMP_MAX_ALGS];
+        int alg = (int)result->crypto_avg.cert_comp_alg;
+        if (alg == CERT_COMP_NONE && cert_comp_parse(config->cert_comp, algs, CERT_COMP_MAX_ALGS) > 0) {
+            alg = algs[0];
+        }
+        cert_comp_result_t comp;
+        if (cert_comp_bench(server_ctx, alg, CERT_COMP_ITERATIONS, &comp)) {
+            result->crypto_avg.cert_compress_ms = comp.compress_ms;
+            result->crypto_avg.cert_decompress_ms = comp.decompress_ms;
+        }
+    }
+
+    // 같은 서버로 세션 재개 측정 (psk_dhe_ke, psk_ke, 선택적으로 0-RTT)
+    if (ok && config->resumptions > 0) {
+        resume_config_t resume = {
+            .ctx = client_ctx,
+            .host = "127.0.0.1",
+            .port = ntohs(target->sin_port),
+            .resumptions = config->resumptions,
+            .psk_mode = PSK_MODE_BOTH,
+            .early_data = config->early_data
+        };
+        resume_result_t resumed;
+        run_resumption(&resume, &resumed);
+        resume_fill_reliability(&resume, &resumed, &result->reliability_avg);
+    }
+
+done:
+    pcap_close(pcap);
+    net_emu_stop(emu, NULL);
+    if (proxy_fd >= 0) {
+        close(proxy_fd);
+    }
+    if (engine) {
+        // 서버 워커 스레드 카운터: 재개를 제외한 전체 핸드셰이크 평균 (워밍업 포함)
+        engine_stats_t stats;
+        engine_stop(engine, &stats);
+        uint64_t full = stats.handshakes_ok - stats.resumed;
+        if (ok && full > 0) {
+            result->resources_avg.server_cpu_cycles = stats.cpu_cycles_sum / full;
+            result->resources_avg.server_cpu_time_ns = stats.cpu_ns_sum / full;
+            result->resources_avg.server_peak_heap_bytes = stats.heap_peak_sum / full;
+            result->resources_avg.server_heap_retained_bytes = stats.heap_retained_sum / full;
+            // 중계기가 없으면 서버 소켓 TCP_INFO 기준 왕복 수 (클라이언트 실행에는 없는 값)
+            if (!net_emu_enabled(&config->netem)) {
+                result->traffic_avg.server_flight_rounds = stats.flight_rounds_sum / full;
+            }
+            report->server_allocs = (double)stats.heap_allocs_sum / full;
+        }
+        report->ssl_new = stats.ssl_new;
+        report->ssl_reused = stats.ssl_reused;
+        report->server_syscalls = stats.accepted ? (double)stats.syscalls / stats.accepted : 0;
+        report->server_io_ops = stats.accepted ? (double)stats.io_ops / stats.accepted : 0;
+    }
+    // 측정 엔진을 멈춘 뒤 처리율 비교 (현재 경로 → 재사용 경로)
+    if (ok && config->pool_compare > 0) {
+        load_plan_t plan = {
+            .workers = config->server_threads,
+            .ssl_pool = 0,
+            .reuseport = config->reuseport,
+            .io_uring = config->io_uring,
+            .connections = POOL_COMPARE_CONNECTIONS,
+            .client_threads = 1,
+            .duration_s = config->pool_compare
+        };
+        report->pool_compared = engine_load(config, server_ctx, client_ctx, &plan, &report->pool_runs[0]);
+        plan.ssl_pool = config->ssl_pool > 0 ? config->ssl_pool : POOL_COMPARE_CONNECTIONS;
+        report->pool_compared = engine_load(config, server_ctx, client_ctx, &plan, &report->pool_runs[1]) &&
+                                report->pool_compared;
+    }
+    if (ok && config->io_compare > 0) {
+        load_plan_t plan = {
+            .workers = config->server_threads,
+            .ssl_pool = config->ssl_pool,
+            .reuseport = config->reuseport,
+            .io_uring = false,
+            .connections = IO_COMPARE_CONNECTIONS,
+            .client_threads = 1,
+            .duration_s = config->io_compare
+        };
+        report->io_compared = engine_load(config, server_ctx, client_ctx, &plan, &report->io_runs[0]);
+        plan.io_uring = true;
+        report->io_compared = engine_load(config, server_ctx, client_ctx, &plan, &report->io_runs[1]) &&
+                              report->io_compared;
+    }
+    if (ok && config->scaling_max > 0) {
+        scaling_curve(config, server_ctx, client_ctx, report);
+    }
+    if (ok && config->bulk_mib > 0) {
+        bulk_sweep(config, server_ctx, client_ctx, report);
+    }
+    close_listeners(listen_fds, listen_count);
+    free(metrics);
+    SSL_CTX_free(client_ctx);
+    SSL_CTX_free(server_ctx);
+    ERR_clear_error();
+    return ok;
+}
+
+// 루프백 MTU 조회 (실패 시 이더넷 기본값)
+static int loopback_mtu(void) {
+    int mtu = 1500;
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock >= 0) {
+        struct ifreq ifr;
+        memset(&ifr, 0, sizeof(ifr));
+        snprintf(ifr.ifr_name, sizeof(ifr.ifr_name), "lo");
+        if (ioctl(sock, SIOCGIFMTU, &ifr) == 0) {
+            mtu = ifr.ifr_mtu;
+        }
+        close(sock);
+    }
+    return mtu;
+}
+
+static void fill_metadata(metadata_t *metadata, const driver_config_t *config) {
+    struct utsname uts;
+    time_t now = time(NULL);
+
+    memset(metadata, 0, sizeof(metadata_t));
+    snprintf(metadata->library, sizeof(metadata->library), "OpenSSL");
+    snprintf(metadata->version_or_commit, sizeof(metadata->version_or_commit), "%s",
+             OpenSSL_version(OPENSSL_VERSION));
+    if (uname(&uts) == 0) {
+        snprintf(metadata->platform, sizeof(metadata->platform), "%.60s %.60s", uts.sysname, uts.machine);
+    }
+    metadata->netem = net_emu_enabled(&config->netem);
+    metadata->rtt_ms = metadata->netem ? config->netem.delay_ms * 2 : 0.0;
+    metadata->mtu = metadata->netem ? config->netem.mtu : loopback_mtu();
+    metadata->bandwidth_mbps = metadata->netem ? config->netem.bandwidth_mbps : 0.0;
+    metadata->loss_pct = metadata->netem ? config->netem.loss_pct : 0.0;
+    metadata->segment_bytes = metadata->netem ? (int)net_emu_segment_size(&config->netem) : 0;
+    metadata->initcwnd = metadata->netem ? config->netem.initcwnd : 0;
+    metadata->nodelay = config->nodelay;
+    snprintf(metadata->client_groups, sizeof(metadata->client_groups), "%s",
+             config->client_groups ? config->client_groups : "");
+    snprintf(metadata->server_groups, sizeof(metadata->server_groups), "%s",
+             config->server_groups ? config->server_groups : "");
+    snprintf(metadata->cipher, sizeof(metadata->cipher), "TLS_AES_128_GCM_SHA256");
+    snprintf(metadata->tls_version, sizeof(metadata->tls_version), "1.3");
+    metadata->mtls = true;
+    snprintf(metadata->cert_compression, sizeof(metadata->cert_compression), "%s",
+             config->cert_comp ? config->cert_comp : "none");
+    metadata->cert_precompress = config->cert_comp && config->precompress;
+    metadata->runs_per_combo = config->runs;
+    strftime(metadata->date, sizeof(metadata->date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+}
+
+// 쉼표로 구분한 양의 정수 목록 (실패 시 -1)
+static int parse_size_list(const char *list, int *out, int max) {
+    int count = 0;
+    const char *p = list;
+    while (*p) {
+        char *end;
+        long v = strtol(p, &end, 10);
+        if (end == p || v <= 0 || v > INT_MAX || count == max || (*end != ',' && *end != '\0')) {
+            return -1;
+        }
+        out[count++] = (int)v;
+        p = *end == ',' ? end + 1 : end;
+    }
+    return count > 0 ? count : -1;
+}
+
+static void print_usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [options] [certs_dir]\n", prog);
+    fprintf(stderr, "조합별로 서버를 한 번만 띄우고 프로세스 안에서 워밍업 + N회 핸드셰이크 측정\n");
+    fprintf(stderr, "\nOptions:\n");
+    fprintf(stderr, "  -n, --runs N            조합당 측정 횟수 (기본 %d)\n", DEFAULT_RUNS);
+    fprintf(stderr, "  -w, --warmup N          조합당 워밍업 횟수 (기본 %d)\n", DEFAULT_WARMUP);
+    fprintf(stderr, "  -t, --server-threads N  서버 엔진 워커 수 (기본 1)\n");
+    fprintf(stderr, "  -o, --output DIR        결과 디렉토리 (기본 %s)\n", DEFAULT_RESULTS_DIR);
+    fprintf(stderr, "  -c, --combo G:S         지정한 조합만 측정 (algorithms.conf의 이름)\n");
+    fprintf(stderr, "  -p, --prim-iterations N 조합별 EVP 단일 연산 측정 횟수 (기본 %d, 0: 생략)\n",
+            DEFAULT_PRIM_ITERATIONS);
+    fprintf(stderr, "  -R, --resume M          조합별 세션 재개 측정 (psk_dhe_ke/psk_ke 각 M회)\n");
+    fprintf(stderr, "  -e, --early-data        재개 시 0-RTT early data 요청 포함\n");
+    fprintf(stderr, "      --alloc-pool        OpenSSL 할당을 스레드별 크기 클래스 풀로 처리\n");
+    fprintf(stderr, "      --cert-comp LIST    인증서 압축 zlib,brotli,zstd 선호 순서 (RFC 8879, OpenSSL 3.2+)\n");
+    fprintf(stderr, "      --precompress       서버 인증서 체인을 컨텍스트 생성 시 미리 압축\n");
+    fprintf(stderr, "      --verify-cache N    서버에서 검증한 클라이언트 체인 N개 캐시 (워밍업이 채움)\n");
+    fprintf(stderr, "      --ssl-pool N        서버 워커마다 SSL 객체 + 연결 슬롯 N개를 SSL_clear로 재사용\n");
+    fprintf(stderr, "      --release-buffers   서버 SSL_MODE_RELEASE_BUFFERS\n");
+    fprintf(stderr, "      --pool-compare S    조합별 closed-loop 처리율을 SSL_new 경로와 --ssl-pool 경로로 S초씩 비교\n");
+    fprintf(stderr, "      --reuseport         서버 워커마다 SO_REUSEPORT 리스너\n");
+    fprintf(stderr, "      --cbpf              SO_REUSEPORT 그룹에 SYN 수신 CPU로 리스너를 고르는 CBPF 연결\n");
+    fprintf(stderr, "      --pin-cpus          서버 워커 i를 허용 CPU 중 i번째에 고정\n");
+    fprintf(stderr, "      --io-uring          서버 워커 I/O를 io_uring으로 (멀티샷 accept/recv, 버퍼 링, 등록 송신 버퍼), 처리율 부하 생성기도 io_uring\n");
+    fprintf(stderr, "      --io-compare S      조합별 closed-loop 처리율과 연결당 시스템 콜/소켓 요청을 epoll/io_uring 경로(서버+클라이언트)로 S초씩 비교\n");
+    fprintf(stderr, "      --bulk MiB          조합별 핸드셰이크 후 서버 → 클라이언트 대량 전송 (전송 1회 MiB, 레코드/쓰기 크기 스윕)\n");
+    fprintf(stderr, "      --bulk-writes LIST  SSL_write 1회 크기 목록 (바이트, 기본 4096,16384,65536)\n");
+    fprintf(stderr, "      --bulk-fragments LIST  max_send_fragment 목록 (%d..%d, 기본 4096,16384)\n",
+            BULK_MIN_FRAGMENT, BULK_MAX_FRAGMENT);
+    fprintf(stderr, "      --ktls              대량 전송에 SSL_OP_ENABLE_KTLS SSL_write / SSL_sendfile 행 추가\n");
+    fprintf(stderr, "      --scaling N         조합별 워커 1..N 처리율 곡선 (공유 리스너 vs SO_REUSEPORT, 최대 %d)\n",
+            MAX_SERVER_WORKERS);
+    fprintf(stderr, "      --scaling-duration S  곡선 단계별 closed-loop 시간 (기본 %.0f초)\n", DEFAULT_SCALING_DURATION);
+    fprintf(stderr, "\nLink emulation (클라이언트와 서버 사이에 사용자 공간 중계기 삽입):\n");
+    fprintf(stderr, "      --delay MS          방향별 단방향 지연 (RTT = 2 × MS)\n");
+    fprintf(stderr, "      --bandwidth MBIT    방향별 링크 속도 Mbit/s\n");
+    fprintf(stderr, "      --mtu BYTES         MTU, 세그먼트 = MTU - 40 (기본 %d)\n", NET_EMU_DEFAULT_MTU);
+    fprintf(stderr, "      --loss PCT          세그먼트 손실 확률(%%), 손실은 RTO만큼 지연\n");
+    fprintf(stderr, "      --initcwnd SEG      송신 측 초기 혼잡 윈도 모델 (세그먼트, 왕복마다 2배)\n");
+    fprintf(stderr, "      --nodelay           클라이언트/서버 소켓에 TCP_NODELAY (Nagle 끔)\n");
+    fprintf(stderr, "      --pcap-dir DIR      측정 핸드셰이크를 DIR/<group>_<sigalg>_client.pcap에 기록\n");
+    fprintf(stderr, "      --client-groups L   클라이언트 제시 그룹 목록 (기본: 조합 그룹, '*g': key_share 전송 3.5+)\n");
+    fprintf(stderr, "      --server-groups L   서버 선호 그룹 목록 (기본: 조합 그룹, 다르면 HRR 발생 가능)\n");
+}
+
+int main(int argc, char **argv) {
+    driver_config_t config = {
+        .certs_dir = DEFAULT_CERTS_DIR,
+        .results_dir = DEFAULT_RESULTS_DIR,
+        .only = NULL,
+        .runs = DEFAULT_RUNS,
+        .warmup = DEFAULT_WARMUP,
+        .server_threads = 1,
+        .resumptions = 0,
+        .early_data = false,
+        .prim_iterations = DEFAULT_PRIM_ITERATIONS,
+        .alloc_pool = false,
+        .cert_comp = NULL,
+        .precompress = false,
+        .netem = { .mtu = NET_EMU_DEFAULT_MTU, .seed = 1 },
+        .nodelay = false,
+        .pcap_dir = NULL,
+        .client_groups = NULL,
+        .server_groups = NULL,
+        .verify_cache = 0,
+        .ssl_pool = 0,
+        .release_buffers = false,
+        .pool_compare = 0,
+        .reuseport = false,
+        .cbpf = false,
+        .pin_cpus = false,
+        .scaling_max = 0,
+        .scaling_duration = DEFAULT_SCALING_DURATION,
+        .io_uring = false,
+        .io_compare = 0,
+        .bulk_mib = 0,
+        .bulk_writes = { 4096, 16384, 65536 },
+        .bulk_write_count = 3,
+        .bulk_fragments = { 4096, BULK_MAX_FRAGMENT },
+        .bulk_fragment_count = 2,
+        .ktls = false
+    };
+
+    static const struct option long_options[] = {
+        {"runs", required_argument, NULL, 'n'},
+        {"warmup", required_argument, NULL, 'w'},
+        {"server-threads", required_argument, NULL, 't'},
+        {"output", required_argument, NULL, 'o'},
+        {"combo", required_argument, NULL, 'c'},
+        {"prim-iterations", required_argument, NULL, 'p'},
+        {"resume", required_argument, NULL, 'R'},
+        {"early-data", no_argument, NULL, 'e'},
+        {"alloc-pool", no_argument, NULL, 'H'},
+        {"cert-comp", required_argument, NULL, 'Z'},
+        {"precompress", no_argument, NULL, 'X'},
+        {"delay", required_argument, NULL, 'D'},
+        {"bandwidth", required_argument, NULL, 'B'},
+        {"mtu", required_argument, NULL, 'U'},
+        {"loss", required_argument, NULL, 'L'},
+        {"initcwnd", required_argument, NULL, 'W'},
+        {"nodelay", no_argument, NULL, 'N'},
+        {"pcap-dir", required_argument, NULL, 'C'},
+        {"client-groups", required_argument, NULL, 'G'},
+        {"server-groups", required_argument, NULL, 'S'},
+        {"verify-cache", required_argument, NULL, 'V'},
+        {"ssl-pool", required_argument, NULL, 'O'},
+        {"release-buffers", no_argument, NULL, 'F'},
+        {"pool-compare", required_argument, NULL, 'Q'},
+        {"reuseport", no_argument, NULL, 'K'},
+        {"cbpf", no_argument, NULL, 'E'},
+        {"pin-cpus", no_argument, NULL, 'P'},
+        {"scaling", required_argument, NULL, 'M'},
+        {"scaling-duration", required_argument, NULL, 'T'},
+        {"io-uring", no_argument, NULL, 'I'},
+        {"io-compare", required_argument, NULL, 'J'},
+        {"bulk", required_argument, NULL, 'Y'},
+        {"bulk-writes", required_argument, NULL, 'A'},
+        {"bulk-fragments", required_argument, NULL, 'a'},
+        {"ktls", no_argument, NULL, 'k'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0}
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "n:w:t:o:c:p:R:eh", long_options, NULL)) != -1) {
+        switch (opt) {
+        case 'n':
+            config.runs = atoi(optarg);
+            break;
+        case 'w':
+            config.warmup = atoi(optarg);
+            break;
+        case 't':
+            config.server_threads = atoi(optarg);
+            break;
+        case 'o':
+            config.results_dir = optarg;
+            break;
+        case 'c':
+            config.only = optarg;
+            break;
+        case 'p':
+            config.prim_iterations = atoi(optarg);
+            break;
+        case 'R':
+            config.resumptions = atoi(optarg);
+            break;
+        case 'e':
+            config.early_data = true;
+            break;
+        case 'H':
+            config.alloc_pool = true;
+            break;
+        case 'Z':
+            config.cert_comp = optarg;
+            break;
+        case 'X':
+            config.precompress = true;
+            break;
+        case 'D':
+            config.netem.delay_ms = atof(optarg);
+            break;
+        case 'B':
+            config.netem.bandwidth_mbps = atof(optarg);
+            break;
+        case 'U':
+            config.netem.mtu = atoi(optarg);
+            break;
+        case 'L':
+            config.netem.loss_pct = atof(optarg);
+            break;
+        case 'W':
+            config.netem.initcwnd = atoi(optarg);
+            break;
+        case 'N':
+            config.nodelay = true;
+            break;
+        case 'C':
+            config.pcap_dir = optarg;
+            break;
+        case 'G':
+            config.client_groups = optarg;
+            break;
+        case 'S':
+            config.server_groups = optarg;
+            break;
+        case 'V':
+            config.verify_cache = atoi(optarg);
+            break;
+        case 'O':
+            config.ssl_pool = atoi(optarg);
+            break;
+        case 'F':
+            config.release_buffers = true;
+            break;
+        case 'Q':
+            config.pool_compare = atof(optarg);
+            break;
+        case 'K':
+            config.reuseport = true;
+            break;
+        case 'E':
+            config.cbpf = true;
+            break;
+        case 'P':
+            config.pin_cpus = true;
+            break;
+        case 'M':
+            config.scaling_max = atoi(optarg);
+            break;
+        case 'T':
+            config.scaling_duration = atof(optarg);
+            break;
+        case 'I':
+            config.io_uring = true;
+            break;
+        case 'J':
+            config.io_compare = atof(optarg);
+            break;
+        case 'Y':
+            config.bulk_mib = atof(optarg);
+            break;
+        case 'A':
+            config.bulk_write_count = parse_size_list(optarg, config.bulk_writes, BULK_MAX_SIZES);
+            break;
+        case 'a':
+            config.bulk_fragment_count = parse_size_list(optarg, config.bulk_fragments, BULK_MAX_SIZES);
+            break;
+        case 'k':
+            config.ktls = true;
+            break;
+        default:
+            print_usage(argv[0]);
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (config.runs <= 0 || config.warmup < 0 || config.server_threads <= 0 ||
+        config.netem.delay_ms < 0 || config.netem.bandwidth_mbps < 0 ||
+        config.netem.loss_pct < 0 || config.netem.loss_pct > 100 || config.netem.initcwnd < 0 ||
+        config.ssl_pool < 0 || config.pool_compare < 0 || config.io_compare < 0 || config.bulk_mib < 0 ||
+        config.bulk_write_count < 0 || config.bulk_fragment_count < 0 ||
+        config.server_threads > MAX_SERVER_WORKERS ||
+        config.scaling_max < 0 || config.scaling_max > MAX_SERVER_WORKERS || config.scaling_duration <= 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    for (int f = 0; f < config.bulk_fragment_count; f++) {
+        if (config.bulk_fragments[f] < BULK_MIN_FRAGMENT || config.bulk_fragments[f] > BULK_MAX_FRAGMENT) {
+            fprintf(stderr, "Invalid max_send_fragment %d (%d..%d)\n", config.bulk_fragments[f],
+                    BULK_MIN_FRAGMENT, BULK_MAX_FRAGMENT);
+            return 1;
+        }
+    }
+    if (optind < argc) {
+        config.certs_dir = argv[optind];
+    }
+
+    algo_matrix_t *matrix = malloc(sizeof(algo_matrix_t));
+    if (!matrix || algo_matrix_load(NULL, matrix) != 0) {
+        free(matrix);
+        return 1;
+    }
+    if (config.only && !algo_find_combo(matrix, config.only)) {
+        fprintf(stderr, "Unknown combo %s (group:sigalg from the algorithm matrix)\n", config.only);
+        free(matrix);
+        return 1;
+    }
+
+    // OpenSSL이 처음 할당하기 전에 메모리 훅 설치
+    mem_track_install(config.alloc_pool);
+    signal(SIGPIPE, SIG_IGN);
+    mkdir(config.results_dir, 0755);
+
+    printf("========================================\n");
+    printf("PQC Hybrid TLS 벤치마크 (in-process driver)\n");
+    printf("========================================\n");
+    printf("실행 횟수: %d per combo (warmup %d)\n", config.runs, config.warmup);
+    printf("서버 워커: %d%s%s%s%s\n", config.server_threads, config.io_uring ? " (io_uring)" : "",
+           config.reuseport ? " (SO_REUSEPORT listener per worker)" : "",
+           config.cbpf ? " + CPU steering CBPF" : "", config.pin_cpus ? ", pinned" : "");
+    if (config.ssl_pool > 0 || config.release_buffers) {
+        printf("서버 SSL 객체: %s%s\n", config.ssl_pool > 0 ? "SSL_clear 재사용" : "연결마다 SSL_new",
+               config.release_buffers ? " + SSL_MODE_RELEASE_BUFFERS" : "");
+    }
+    if (net_emu_enabled(&config.netem)) {
+        char desc[160];
+        net_emu_describe(&config.netem, desc, sizeof(desc));
+        printf("링크 에뮬레이션: %s\n", desc);
+    }
+    if (config.client_groups || config.server_groups) {
+        printf("그룹: client %s / server %s\n", config.client_groups ? config.client_groups : "(combo)",
+               config.server_groups ? config.server_groups : "(combo)");
+    }
+    if (config.cert_comp) {
+        int algs[CERT_COMP_MAX_ALGS];
+        int n = cert_comp_parse(config.cert_comp, algs, CERT_COMP_MAX_ALGS);
+        if (n <= 0) {
+            fprintf(stderr, "Invalid certificate compression list: %s (zlib,brotli,zstd)\n", config.cert_comp);
+            free(matrix);
+            return 1;
+        }
+        printf("인증서 압축: %s%s%s\n", config.cert_comp, config.precompress ? " (precompressed)" : "",
+               cert_comp_available(algs[0]) ? "" : " - 현재 OpenSSL 빌드에서 사용 불가, 비압축으로 측정");
+    }
+    // 모든 조합이 같은 CA라 캐시 하나를 공유 (조합마다 클라이언트 체인이 달라 적중은 조합 안에서만)
+    verify_cache_t *cache = NULL;
+    if (config.verify_cache > 0) {
+        cache = verify_cache_new(config.verify_cache, VERIFY_CACHE_DEFAULT_TTL);
+        if (!cache) {
+            free(matrix);
+            return 1;
+        }
+        printf("체인 검증 캐시: %d chains, TTL %d s\n", config.verify_cache, VERIFY_CACHE_DEFAULT_TTL);
+    }
+    // 조합/워커 수/리스너별 처리율 곡선
+    FILE *scaling_csv = NULL;
+    if (config.scaling_max > 0) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/scaling.csv", config.results_dir);
+        scaling_csv = fopen(path, "w");
+        if (!scaling_csv) {
+            perror(path);
+            verify_cache_free(cache);
+            free(matrix);
+            return 1;
+        }
+        fprintf(scaling_csv, "group,sigalg,workers,listener,handshakes_per_sec,p99_ms,server_cpu_ms,"
+                "crypto_ceiling_per_sec,listen_overflows,imbalance\n");
+        printf("처리율 곡선: 워커 1..%d, 단계당 %.1f s x 2 (shared / SO_REUSEPORT), 동시 연결 %d\n",
+               config.scaling_max, config.scaling_duration, SCALING_CONNECTIONS_PER_WORKER * config.scaling_max);
+    }
+    // 조합/경로/레코드 크기별 대량 전송
+    FILE *bulk_csv = NULL;
+    if (config.bulk_mib > 0) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/bulk.csv", config.results_dir);
+        bulk_csv = fopen(path, "w");
+        if (!bulk_csv) {
+            perror(path);
+            if (scaling_csv) {
+                fclose(scaling_csv);
+            }
+            verify_cache_free(cache);
+            free(matrix);
+            return 1;
+        }
+        fprintf(bulk_csv, "group,sigalg,mode,write_bytes,max_fragment,gib_per_sec,sender_cpu_ms_per_gib,"
+                "receiver_cpu_ms_per_gib,sender_syscalls_per_mib,receiver_syscalls_per_mib,ktls_send,ktls_recv\n");
+        printf("대량 전송: %.1f MiB per point, write %d개 x fragment %d개%s (TLS_AES_128_GCM_SHA256)\n",
+               config.bulk_mib, config.bulk_write_count, config.bulk_fragment_count,
+               config.ktls ? " x {SSL_write, kTLS SSL_write, kTLS SSL_sendfile}" : "");
+    }
+    double bulk_min = 0, bulk_max = 0;
+    char bulk_min_name[160] = "", bulk_max_name[160] = "";
+    printf("\n");
+
+    int combo_count = matrix->combo_count;
+    benchmark_result_t *results = calloc(combo_count, sizeof(benchmark_result_t));
+    const char **unavailable = calloc(combo_count, sizeof(char*));
+    char (*unavailable_names)[160] = calloc(combo_count, sizeof(*unavailable_names));
+    int result_count = 0, unavailable_count = 0;
+    if (!results || !unavailable || !unavailable_names) {
+        fprintf(stderr, "Out of memory\n");
+        free(results);
+        free(unavailable);
+        free(unavailable_names);
+        if (scaling_csv) {
+            fclose(scaling_csv);
+        }
+        if (bulk_csv) {
+            fclose(bulk_csv);
+        }
+        verify_cache_free(cache);
+        free(matrix);
+        return 1;
+    }
+
+    for (int i = 0; i < combo_count; i++) {
+        const algo_combo_t *combo = &matrix->combos[i];
+        char name[160];
+        snprintf(name, sizeof(name), "%s:%s", combo->group, combo->sigalg);
+        if (config.only && strcmp(config.only, name) != 0) {
+            continue;
+        }
+
+        printf("[%2d/%d] %-34s ", i + 1, combo_count, name);
+        fflush(stdout);
+
+        benchmark_result_t *r = &results[result_count];
+        const char *reason = NULL;
+        combo_report_t report;
+        if (!run_combo(&config, combo, cache, &report, r, &reason)) {
+            free_benchmark_result(r);
+            printf("❌ unavailable (%s)\n", reason);
+            snprintf(unavailable_names[unavailable_count], sizeof(unavailable_names[0]),
+                     "%s+%s: %s", combo->group, combo->sigalg, reason);
+            unavailable[unavailable_count] = unavailable_names[unavailable_count];
+            unavailable_count++;
+            continue;
+        }
+        result_count++;
+
+        printf("✅ %d/%d, mean %.3f ms, p50 %.3f ms, p90 %.3f ms, p99 %.3f ms\n",
+               r->successful_runs, r->total_runs,
+               r->t_handshake_total_ms.mean, r->t_handshake_total_ms.p50,
+               r->t_handshake_total_ms.p90, r->t_handshake_total_ms.p99);
+        printf("        cpu: client %.3f ms / %lu cycles, server %.3f ms / %lu cycles\n",
+               r->resources_avg.cpu_time_ns / 1e6, r->resources_avg.cpu_cycles,
+               r->resources_avg.server_cpu_time_ns / 1e6, r->resources_avg.server_cpu_cycles);
+        printf("        heap: client peak %lu B / retained %lu B (%lu allocs), server peak %lu B / retained %lu B (%.0f allocs)\n",
+               r->resources_avg.peak_heap_bytes, r->resources_avg.heap_retained_bytes,
+               r->resources_avg.heap_allocs, r->resources_avg.server_peak_heap_bytes,
+               r->resources_avg.server_heap_retained_bytes, report.server_allocs);
+        if (config.ssl_pool > 0) {
+            printf("        ssl: new %lu, reused %lu (SSL_clear)\n", report.ssl_new, report.ssl_reused);
+        }
+        if (report.pool_compared) {
+            const load_run_t *base = &report.pool_runs[0], *pooled = &report.pool_runs[1];
+            printf("        pool: %.1f → %.1f handshakes/s (%+.1f%%), server allocs %.0f → %.0f, server CPU %.3f → %.3f ms\n",
+                   base->handshakes_per_sec, pooled->handshakes_per_sec,
+                   base->handshakes_per_sec > 0 ?
+                       100.0 * (pooled->handshakes_per_sec / base->handshakes_per_sec - 1.0) : 0.0,
+                   base->server_allocs, pooled->server_allocs, base->server_cpu_ms, pooled->server_cpu_ms);
+        }
+        if (report.io_compared) {
+            const load_run_t *epoll_run = &report.io_runs[0], *uring_run = &report.io_runs[1];
+            printf("        io: epoll %.1f → io_uring %.1f handshakes/s (%+.1f%%)\n",
+                   epoll_run->handshakes_per_sec, uring_run->handshakes_per_sec,
+                   epoll_run->handshakes_per_sec > 0 ?
+                       100.0 * (uring_run->handshakes_per_sec / epoll_run->handshakes_per_sec - 1.0) : 0.0);
+            printf("            per connection: server syscalls %.1f → %.1f, socket ops %.1f → %.1f; "
+                   "client%s syscalls %.1f → %.1f, socket ops %.1f → %.1f\n",
+                   epoll_run->syscalls_per_conn, uring_run->syscalls_per_conn,
+                   epoll_run->io_ops_per_conn, uring_run->io_ops_per_conn,
+                   uring_run->client_io_uring ? "" : " (io_uring unavailable, epoll)",
+                   epoll_run->client_syscalls_per_conn, uring_run->client_syscalls_per_conn,
+                   epoll_run->client_io_ops_per_conn, uring_run->client_io_ops_per_conn);
+        } else if (config.io_uring) {
+            printf("        io: io_uring, server syscalls per connection %.1f, socket ops %.1f\n",
+                   report.server_syscalls, report.server_io_ops);
+        }
+        printf("        tcp: segments out %u / in %u, retransmits %u, server flight %u B in %u round(s)\n",
+               r->traffic_avg.segs_out, r->traffic_avg.segs_in, r->traffic_avg.retransmits,
+               r->traffic_avg.server_flight_bytes, r->traffic_avg.server_flight_rounds);
+        if (cache) {
+            printf("      ");
+            verify_stats_print(&report.verify);
+        }
+        if (report.scaling_count > 0) {
+            print_scaling(&report);
+            write_scaling_csv(scaling_csv, combo, &report);
+        }
+        if (report.bulk_count > 0) {
+            print_bulk(&config, &report);
+            write_bulk_csv(bulk_csv, combo, &report);
+            double best = bulk_best(&report);
+            if (best > 0 && (bulk_min == 0 || best < bulk_min)) {
+                bulk_min = best;
+                snprintf(bulk_min_name, sizeof(bulk_min_name), "%s", name);
+            }
+            if (best > bulk_max) {
+                bulk_max = best;
+                snprintf(bulk_max_name, sizeof(bulk_max_name), "%s", name);
+            }
+        }
+        if (config.client_groups || config.server_groups) {
+            const message_bytes_t *mb = &r->traffic_avg.msg_bytes;
+            printf("        key_share: %u offered, ClientHello %u B", r->crypto_avg.key_shares_offered,
+                   mb->client_hello_initial ? mb->client_hello_initial : mb->client_hello);
+            if (r->hello_retry_runs > 0) {
+                printf(", hrr %d/%d (HRR %u B, retry ClientHello %u B, +%.3f ms)", r->hello_retry_runs,
+                       r->successful_runs, mb->hello_retry_request, mb->client_hello,
+                       r->t_hello_retry_ms.mean);
+            }
+            printf("\n");
+        }
+        if (config.cert_comp) {
+            const message_bytes_t *mb = &r->traffic_avg.msg_bytes;
+            printf("        cert: %s, Certificate %u -> %u B, compress %.4f ms, decompress %.4f ms\n",
+                   cert_comp_name((int)r->crypto_avg.cert_comp_alg), mb->server_certificate_uncompressed,
+                   mb->server_certificate, r->crypto_avg.cert_compress_ms, r->crypto_avg.cert_decompress_ms);
+        }
+        if (config.prim_iterations > 0) {
+            const prim_timings_t *p = &r->prim_ms;
+            printf("        primitives: keygen %.3f, encap %.3f, decap %.3f, sign %.3f, verify %.3f ms\n",
+                   p->kem_keygen_ms, p->kem_encap_ms, p->kem_decap_ms, p->sign_ms, p->verify_ms);
+        }
+        if (config.resumptions > 0) {
+            const reliability_metrics_t *rel = &r->reliability_avg;
+            printf("        resumption: psk_dhe_ke %.3f ms%s, psk_ke %.3f ms%s",
+                   rel->t_resumption_ms, rel->session_resumption_ok ? "" : " (not resumed)",
+                   rel->t_resumption_psk_ke_ms, rel->psk_ke_ok ? "" : " (server chose psk_dhe_ke)");
+            if (config.early_data) {
+                printf(", 0-RTT response %.3f ms%s", rel->t_0rtt_ms, rel->zero_rtt_ok ? "" : " (rejected)");
+            }
+            printf("\n");
+        }
+    }
+
+    metadata_t metadata;
+    fill_metadata(&metadata, &config);
+
+    char json_file[512], csv_file[512];
+    snprintf(json_file, sizeof(json_file), "%s/tls13_pqc_benchmark.json", config.results_dir);
+    snprintf(csv_file, sizeof(csv_file), "%s/tls13_pqc_benchmark.csv", config.results_dir);
+
+    printf("\n");
+    write_json_results(json_file, &metadata, results, result_count, unavailable, unavailable_count);
+    write_csv_results(csv_file, results, result_count);
+
+    for (int i = 0; i < result_count; i++) {
+        free_benchmark_result(&results[i]);
+    }
+    free(results);
+    free(unavailable);
+    free(unavailable_names);
+    if (scaling_csv) {
+        fclose(scaling_csv);
+        printf("Scaling curve written to %s/scaling.csv\n", config.results_dir);
+    }
+    if (bulk_csv) {
+        fclose(bulk_csv);
+        printf("Bulk transfer results written to %s/bulk.csv\n", config.results_dir);
+        // 핸드셰이크 이후 레코드 계층은 조합과 무관: 조합 간 차이는 측정 편차
+        if (bulk_max > 0) {
+            printf("Bulk ssl_write best GiB/s across combos: min %.3f (%s), max %.3f (%s), spread %.1f%%\n",
+                   bulk_min, bulk_min_name, bulk_max, bulk_max_name, 100.0 * (bulk_max / bulk_min - 1.0));
+        }
+    }
+    if (cache) {
+        printf("Verify cache:\n");
+        verify_cache_print(cache);
+        verify_cache_free(cache);
+    }
+    free(matrix);
+    return result_count > 0 ? 0 : 1;
+}
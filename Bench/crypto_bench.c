@@ -0,0 +1,148 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <unistd.h>
+#include "../Common/prim_bench.h"
+#include "../Common/algo_config.h"
+
+#define DEFAULT_ITERATIONS 1000
+#define DEFAULT_WARMUP 100
+#define MAX_THREAD_STEPS 16
+
+static void print_usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [options]\n", prog);
+    fprintf(stderr, "알고리즘 매트릭스(algorithms.conf)의 그룹/서명 알고리즘별 EVP 단일 연산(keygen/encap/decap/sign/verify) 측정\n");
+    fprintf(stderr, "\nOptions:\n");
+    fprintf(stderr, "  -n, --iterations N   스레드당 측정 횟수 (기본 %d)\n", DEFAULT_ITERATIONS);
+    fprintf(stderr, "  -w, --warmup N       스레드당 워밍업 횟수 (기본 %d)\n", DEFAULT_WARMUP);
+    fprintf(stderr, "  -t, --threads LIST   스레드 수 목록 (예: 1,2,4,8, 기본 1)\n");
+    fprintf(stderr, "  -a, --algo NAME      지정한 알고리즘만 측정 (예: mlkem768)\n");
+}
+
+// "1,2,4" → 배열
+static int parse_threads(const char *list, int *out, int max) {
+    int n = 0;
+    char *copy = strdup(list);
+    for (char *tok = strtok(copy, ","); tok && n < max; tok = strtok(NULL, ",")) {
+        int v = atoi(tok);
+        if (v <= 0) {
+            n = 0;
+            break;
+        }
+        out[n++] = v;
+    }
+    free(copy);
+    return n;
+}
+
+// 매트릭스에 선언된 그룹, 서명 알고리즘 순으로 이름 수집
+static int collect_algorithms(const algo_matrix_t *matrix, const char **names) {
+    int n = 0;
+    for (int i = 0; i < matrix->group_count; i++) {
+        names[n++] = matrix->groups[i].name;
+    }
+    for (int i = 0; i < matrix->sigalg_count; i++) {
+        names[n++] = matrix->sigalgs[i].name;
+    }
+    return n;
+}
+
+int main(int argc, char **argv) {
+    int iterations = DEFAULT_ITERATIONS;
+    int warmup = DEFAULT_WARMUP;
+    int thread_steps[MAX_THREAD_STEPS] = { 1 };
+    int step_count = 1;
+    const char *only = NULL;
+
+    static const struct option long_options[] = {
+        {"iterations", required_argument, NULL, 'n'},
+        {"warmup", required_argument, NULL, 'w'},
+        {"threads", required_argument, NULL, 't'},
+        {"algo", required_argument, NULL, 'a'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0}
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "n:w:t:a:h", long_options, NULL)) != -1) {
+        switch (opt) {
+        case 'n':
+            iterations = atoi(optarg);
+            break;
+        case 'w':
+            warmup = atoi(optarg);
+            break;
+        case 't':
+            step_count = parse_threads(optarg, thread_steps, MAX_THREAD_STEPS);
+            break;
+        case 'a':
+            only = optarg;
+            break;
+        default:
+            print_usage(argv[0]);
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (iterations <= 0 || warmup < 0 || step_count == 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    algo_matrix_t *matrix = malloc(sizeof(algo_matrix_t));
+    if (!matrix || algo_matrix_load(NULL, matrix) != 0) {
+        free(matrix);
+        return 1;
+    }
+    const char *names[ALGO_MAX_GROUPS + ALGO_MAX_SIGALGS];
+    int name_count = collect_algorithms(matrix, names);
+
+    printf("EVP primitive benchmark (online CPUs: %ld)\n", sysconf(_SC_NPROCESSORS_ONLN));
+    printf("Iterations: %d per thread, warmup: %d\n\n", iterations, warmup);
+    printf("%-24s %-14s %-7s %8s %12s %14s %14s %9s\n",
+           "algorithm", "evp", "op", "threads", "ns/op", "cycles/op", "ops/s", "scaling");
+
+    int measured = 0;
+    for (int i = 0; i < name_count; i++) {
+        if (only && strcmp(only, names[i]) != 0) {
+            continue;
+        }
+
+        prim_alg_t alg;
+        if (!prim_resolve(names[i], &alg)) {
+            printf("%-24s %-14s %s\n", names[i], "-", "unavailable");
+            continue;
+        }
+        measured++;
+
+        for (int op = 0; op < PRIM_OP_COUNT; op++) {
+            if (!prim_op_applies(&alg, op)) {
+                continue;
+            }
+            double single_ops = 0.0;
+
+            for (int s = 0; s < step_count; s++) {
+                prim_result_t r;
+                if (prim_bench_run(&alg, op, iterations, warmup, thread_steps[s], &r) != 0) {
+                    printf("%-24s %-14s %-7s %8d %12s\n", alg.name, alg.evp_name,
+                           prim_op_name(op), thread_steps[s], "failed");
+                    continue;
+                }
+                // 첫 단계 대비 스레드당 처리량 비율 (1.0 = 선형 확장)
+                if (s == 0) {
+                    single_ops = r.ops_per_sec / r.threads;
+                }
+                double scaling = single_ops > 0 ? r.ops_per_sec / (single_ops * r.threads) : 0.0;
+
+                printf("%-24s %-14s %-7s %8d %12.0f %14.0f %14.1f %9.2f\n",
+                       alg.name, alg.evp_name, prim_op_name(op), r.threads,
+                       r.ns_per_op, r.cycles_per_op, r.ops_per_sec, scaling);
+                fflush(stdout);
+            }
+        }
+    }
+
+    printf("\n%d algorithm(s) measured\n", measured);
+    free(matrix);
+    return measured > 0 ? 0 : 1;
+}
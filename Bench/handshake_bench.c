@@ -0,0 +1,318 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <time.h>
+#include <openssl/ssl.h>
+#include <openssl/err.h>
+#include <openssl/bio.h>
+#include "../Common/metrics.h"
+#include "../Common/tls_context.h"
+#include "../Common/algo_config.h"
+#include "../Common/perf_counters.h"
+#include "../Common/mem_track.h"
+
+#define DEFAULT_CERTS_DIR "certs"
+#define DEFAULT_ITERATIONS 1000
+#define DEFAULT_WARMUP 50
+#define BIO_PAIR_BUF (64 * 1024)   // ML-DSA-87 인증서 플라이트가 한 번에 들어가는 크기
+#define MAX_ROUNDS 64
+
+// 핸드셰이크 1회 측정값
+typedef struct {
+    uint64_t wall_ns;
+    perf_values_t client;   // 클라이언트 쪽 SSL_do_handshake 구간 (CPU 시간 + 카운터)
+    perf_values_t server;
+    mem_account_t client_heap;  // 쪽별 OpenSSL 할당 (SSL_new부터 핸드셰이크 완료까지)
+    mem_account_t server_heap;
+} hs_sample_t;
+
+// 조합별 결과
+typedef struct {
+    const char *group;
+    const char *sigalg;
+    bool available;
+    int handshakes;
+    stats_t wall_ns;
+    double client_cpu_ns;
+    double server_cpu_ns;
+    double client_cycles;
+    double server_cycles;
+    double client_heap_peak;
+    double server_heap_peak;
+} combo_result_t;
+
+static uint64_t clock_ns(clockid_t clock) {
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// 한쪽 핸드셰이크 진행, 스레드 CPU 시간/카운터 누적 (1: 완료, 0: 진행 중, -1: 실패)
+static int step(SSL *ssl, perf_values_t *acc, mem_account_t *heap) {
+    perf_values_t start;
+    mem_track_switch(heap);
+    perf_begin(&start);
+    int ret = SSL_do_handshake(ssl);
+    perf_end(&start, acc);
+    mem_track_switch(NULL);
+
+    if (ret == 1) {
+        return 1;
+    }
+    int err = SSL_get_error(ssl, ret);
+    return (err == SSL_ERROR_WANT_READ || err == SSL_ERROR_WANT_WRITE) ? 0 : -1;
+}
+
+// BIO pair로 연결된 클라이언트/서버를 한 스레드에서 번갈아 구동
+static bool run_handshake(SSL_CTX *client_ctx, SSL_CTX *server_ctx, hs_sample_t *sample) {
+    BIO *client_bio = NULL, *server_bio = NULL;
+    bool ok = false;
+
+    memset(sample, 0, sizeof(hs_sample_t));
+    mem_track_switch(&sample->client_heap);
+    SSL *client = SSL_new(client_ctx);
+    mem_track_switch(&sample->server_heap);
+    SSL *server = SSL_new(server_ctx);
+    mem_track_switch(NULL);
+
+    if (!client || !server || !BIO_new_bio_pair(&client_bio, BIO_PAIR_BUF, &server_bio, BIO_PAIR_BUF)) {
+        goto done;
+    }
+    SSL_set_bio(client, client_bio, client_bio);
+    SSL_set_bio(server, server_bio, server_bio);
+    SSL_set_connect_state(client);
+    SSL_set_accept_state(server);
+
+    int client_state = 0, server_state = 0;
+    uint64_t start = clock_ns(CLOCK_MONOTONIC);
+
+    for (int round = 0; round < MAX_ROUNDS && (client_state == 0 || server_state == 0); round++) {
+        if (client_state == 0) {
+            client_state = step(client, &sample->client, &sample->client_heap);
+        }
+        if (server_state == 0) {
+            server_state = step(server, &sample->server, &sample->server_heap);
+        }
+        if (client_state < 0 || server_state < 0) {
+            break;
+        }
+    }
+
+    sample->wall_ns = clock_ns(CLOCK_MONOTONIC) - start;
+    ok = client_state == 1 && server_state == 1;
+
+done:
+    SSL_free(client);
+    SSL_free(server);
+    ERR_clear_error();
+    return ok;
+}
+
+// cert_comp/precompress: 인증서 압축 비용이 서버/클라이언트 CPU에 포함됨 (OpenSSL 3.2+)
+static bool bench_combo(const char *certs_dir, const algo_combo_t *combo, const char *cert_comp,
+                        bool precompress, int warmup, int iterations, combo_result_t *result,
+                        const char **reason) {
+    const char *group = combo->ossl_group;
+    const char *sigalg = combo->ossl_sigalg;
+    char prefix[512], server_cert[600], server_key[600], client_cert[600], client_key[600], ca_cert[600];
+
+    memset(result, 0, sizeof(combo_result_t));
+    result->group = combo->group;
+    result->sigalg = combo->sigalg;
+
+    if (!algo_combo_probe(combo, reason)) {
+        return false;
+    }
+    *reason = "certificate or context setup failed";
+
+    snprintf(prefix, sizeof(prefix), "%s/%s_%s", certs_dir, group, sigalg);
+    snprintf(server_cert, sizeof(server_cert), "%s_server.crt", prefix);
+    snprintf(server_key, sizeof(server_key), "%s_server.key", prefix);
+    snprintf(client_cert, sizeof(client_cert), "%s_client.crt", prefix);
+    snprintf(client_key, sizeof(client_key), "%s_client.key", prefix);
+    snprintf(ca_cert, sizeof(ca_cert), "%s/ca.crt", certs_dir);
+
+    tls_ctx_config_t server_config = {
+        .cert_file = server_cert, .key_file = server_key, .ca_file = ca_cert,
+        .groups = group, .sigalgs = sigalg,
+        .cert_comp = cert_comp, .cert_precompress = precompress
+    };
+    tls_ctx_config_t client_config = {
+        .cert_file = client_cert, .key_file = client_key, .ca_file = ca_cert,
+        .groups = group, .sigalgs = sigalg,
+        .cert_comp = cert_comp
+    };
+
+    SSL_CTX *server_ctx = create_server_context(&server_config);
+    SSL_CTX *client_ctx = server_ctx ? create_client_context(&client_config) : NULL;
+    if (!server_ctx || !client_ctx) {
+        SSL_CTX_free(server_ctx);
+        ERR_clear_error();
+        return false;
+    }
+
+    hs_sample_t sample;
+    *reason = "handshake failed";
+    for (int i = 0; i < warmup; i++) {
+        if (!run_handshake(client_ctx, server_ctx, &sample)) {
+            SSL_CTX_free(client_ctx);
+            SSL_CTX_free(server_ctx);
+            return false;
+        }
+    }
+
+    double *wall_ns = malloc(iterations * sizeof(double));
+    double client_sum = 0.0, server_sum = 0.0;
+    double client_cycles = 0.0, server_cycles = 0.0;
+    double client_heap = 0.0, server_heap = 0.0;
+    int n = 0;
+
+    for (int i = 0; wall_ns && i < iterations; i++) {
+        if (!run_handshake(client_ctx, server_ctx, &sample)) {
+            continue;
+        }
+        wall_ns[n++] = (double)sample.wall_ns;
+        client_sum += sample.client.cpu_ns;
+        server_sum += sample.server.cpu_ns;
+        client_cycles += sample.client.counters[PERF_CYCLES];
+        server_cycles += sample.server.counters[PERF_CYCLES];
+        client_heap += sample.client_heap.peak;
+        server_heap += sample.server_heap.peak;
+    }
+
+    result->available = n > 0;
+    result->handshakes = n;
+    calculate_stats(wall_ns, n, &result->wall_ns);
+    if (n > 0) {
+        result->client_cpu_ns = client_sum / n;
+        result->server_cpu_ns = server_sum / n;
+        result->client_cycles = client_cycles / n;
+        result->server_cycles = server_cycles / n;
+        result->client_heap_peak = client_heap / n;
+        result->server_heap_peak = server_heap / n;
+    }
+
+    free(wall_ns);
+    SSL_CTX_free(client_ctx);
+    SSL_CTX_free(server_ctx);
+    return result->available;
+}
+
+static void print_usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [options] [certs_dir]\n", prog);
+    fprintf(stderr, "소켓 없이 BIO pair로 전체 mTLS 핸드셰이크의 암호/상태 머신 비용만 측정\n");
+    fprintf(stderr, "\nOptions:\n");
+    fprintf(stderr, "  -n, --iterations N   조합당 측정 횟수 (기본 %d)\n", DEFAULT_ITERATIONS);
+    fprintf(stderr, "  -w, --warmup N       조합당 워밍업 횟수 (기본 %d)\n", DEFAULT_WARMUP);
+    fprintf(stderr, "  -c, --combo G:S      지정한 조합만 측정 (algorithms.conf의 이름, 예: mlkem768:mldsa65)\n");
+    fprintf(stderr, "      --alloc-pool     OpenSSL 할당을 스레드별 크기 클래스 풀로 처리 (할당기 churn 비교)\n");
+    fprintf(stderr, "      --cert-comp LIST 인증서 압축 zlib,brotli,zstd 선호 순서 (RFC 8879, OpenSSL 3.2+)\n");
+    fprintf(stderr, "      --precompress    서버 인증서 체인을 컨텍스트 생성 시 미리 압축\n");
+}
+
+int main(int argc, char **argv) {
+    int iterations = DEFAULT_ITERATIONS;
+    int warmup = DEFAULT_WARMUP;
+    const char *only = NULL;
+    bool alloc_pool = false;
+    const char *cert_comp = NULL;
+    bool precompress = false;
+
+    static const struct option long_options[] = {
+        {"iterations", required_argument, NULL, 'n'},
+        {"warmup", required_argument, NULL, 'w'},
+        {"combo", required_argument, NULL, 'c'},
+        {"alloc-pool", no_argument, NULL, 'H'},
+        {"cert-comp", required_argument, NULL, 'Z'},
+        {"precompress", no_argument, NULL, 'X'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0}
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "n:w:c:h", long_options, NULL)) != -1) {
+        switch (opt) {
+        case 'n':
+            iterations = atoi(optarg);
+            break;
+        case 'w':
+            warmup = atoi(optarg);
+            break;
+        case 'c':
+            only = optarg;
+            break;
+        case 'H':
+            alloc_pool = true;
+            break;
+        case 'Z':
+            cert_comp = optarg;
+            break;
+        case 'X':
+            precompress = true;
+            break;
+        default:
+            print_usage(argv[0]);
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (iterations <= 0 || warmup < 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    const char *certs_dir = optind < argc ? argv[optind] : DEFAULT_CERTS_DIR;
+
+    algo_matrix_t *matrix = malloc(sizeof(algo_matrix_t));
+    if (!matrix || algo_matrix_load(NULL, matrix) != 0) {
+        free(matrix);
+        return 1;
+    }
+    if (only && !algo_find_combo(matrix, only)) {
+        fprintf(stderr, "Unknown combo %s (group:sigalg from the algorithm matrix)\n", only);
+        free(matrix);
+        return 1;
+    }
+
+    // OpenSSL이 처음 할당하기 전에 메모리 훅 설치
+    mem_track_install(alloc_pool);
+
+    printf("In-memory mTLS handshake benchmark (BIO pair, single thread)\n");
+    printf("Certs: %s, iterations: %d, warmup: %d, allocator: %s, cert compression: %s%s\n\n",
+           certs_dir, iterations, warmup, alloc_pool ? "pool" : "malloc",
+           cert_comp ? cert_comp : "none", cert_comp && precompress ? " (precompressed)" : "");
+    printf("%-34s %12s %12s %12s %14s %14s %14s %14s %12s %12s %10s\n",
+           "combo", "ns/hs", "p50_ns", "p99_ns", "client_cpu_ns", "server_cpu_ns",
+           "client_cycles", "server_cycles", "client_heap", "server_heap", "hs/s");
+
+    int measured = 0;
+
+    for (int i = 0; i < matrix->combo_count; i++) {
+        const algo_combo_t *combo = &matrix->combos[i];
+        char name[160];
+        snprintf(name, sizeof(name), "%s:%s", combo->group, combo->sigalg);
+        if (only && strcmp(only, name) != 0) {
+            continue;
+        }
+
+        combo_result_t result;
+        combo_result_t *r = &result;
+        const char *reason = NULL;
+        if (!bench_combo(certs_dir, combo, cert_comp, precompress, warmup, iterations, r, &reason)) {
+            printf("%-34s %10s (%s)\n", name, "unavailable", reason);
+            continue;
+        }
+        measured++;
+
+        // CPU 시간/사이클/힙 최대값(바이트)은 핸드셰이크당 평균 (클라이언트/서버 분리, 카운터가 없으면 사이클 0)
+        printf("%-34s %12.0f %12.0f %12.0f %14.0f %14.0f %14.0f %14.0f %12.0f %12.0f %10.1f\n",
+               name, r->wall_ns.mean, r->wall_ns.p50, r->wall_ns.p99,
+               r->client_cpu_ns, r->server_cpu_ns, r->client_cycles, r->server_cycles,
+               r->client_heap_peak, r->server_heap_peak,
+               r->wall_ns.mean > 0 ? 1e9 / r->wall_ns.mean : 0.0);
+        fflush(stdout);
+    }
+
+    printf("\n%d combo(s) measured\n", measured);
+    free(matrix);
+    return measured > 0 ? 0 : 1;
+}
@@ -0,0 +1,140 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <signal.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include "../Common/net_emu.h"
+
+static volatile sig_atomic_t stop_requested = 0;
+
+static void handle_signal(int sig) {
+    (void)sig;
+    stop_requested = 1;
+}
+
+static void print_usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [options] <listen_port> <upstream_host> <upstream_port>\n", prog);
+    fprintf(stderr, "Example: %s -d 25 -b 10 -l 1 4434 127.0.0.1 4433  (tls_client는 4434로 연결)\n", prog);
+    fprintf(stderr, "tls_client와 tls_server 사이에서 지연/대역폭/세그먼트/손실을 흉내 내는 TCP 중계기\n");
+    fprintf(stderr, "\nOptions:\n");
+    fprintf(stderr, "  -d, --delay MS       방향별 단방향 지연 (RTT = 2 × MS)\n");
+    fprintf(stderr, "  -b, --bandwidth MBIT 방향별 링크 속도 Mbit/s (기본 무제한)\n");
+    fprintf(stderr, "  -m, --mtu BYTES      MTU, 세그먼트 = MTU - 40 (기본 %d)\n", NET_EMU_DEFAULT_MTU);
+    fprintf(stderr, "  -l, --loss PCT       세그먼트 손실 확률(%%), 손실은 RTO만큼 지연\n");
+    fprintf(stderr, "      --rto MS         손실 시 지연 (기본 max(200, 2 × RTT))\n");
+    fprintf(stderr, "      --seed N         손실 난수 시드 (기본 1)\n");
+    fprintf(stderr, "      --initcwnd SEG   초기 혼잡 윈도 모델 (세그먼트, 왕복마다 2배)\n");
+}
+
+int main(int argc, char **argv) {
+    net_emu_config_t config = {
+        .delay_ms = 0.0,
+        .bandwidth_mbps = 0.0,
+        .mtu = NET_EMU_DEFAULT_MTU,
+        .loss_pct = 0.0,
+        .rto_ms = 0.0,
+        .initcwnd = 0,
+        .seed = 1
+    };
+
+    static const struct option long_options[] = {
+        {"delay", required_argument, NULL, 'd'},
+        {"bandwidth", required_argument, NULL, 'b'},
+        {"mtu", required_argument, NULL, 'm'},
+        {"loss", required_argument, NULL, 'l'},
+        {"rto", required_argument, NULL, 'T'},
+        {"seed", required_argument, NULL, 'S'},
+        {"initcwnd", required_argument, NULL, 'W'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0}
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "d:b:m:l:h", long_options, NULL)) != -1) {
+        switch (opt) {
+        case 'd':
+            config.delay_ms = atof(optarg);
+            break;
+        case 'b':
+            config.bandwidth_mbps = atof(optarg);
+            break;
+        case 'm':
+            config.mtu = atoi(optarg);
+            break;
+        case 'l':
+            config.loss_pct = atof(optarg);
+            break;
+        case 'T':
+            config.rto_ms = atof(optarg);
+            break;
+        case 'S':
+            config.seed = (unsigned int)strtoul(optarg, NULL, 10);
+            break;
+        case 'W':
+            config.initcwnd = atoi(optarg);
+            break;
+        default:
+            print_usage(argv[0]);
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (argc - optind < 3 || config.delay_ms < 0 || config.bandwidth_mbps < 0 ||
+        config.loss_pct < 0 || config.loss_pct > 100 || config.initcwnd < 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    int listen_port = atoi(argv[optind]);
+    struct sockaddr_in upstream;
+    memset(&upstream, 0, sizeof(upstream));
+    upstream.sin_family = AF_INET;
+    upstream.sin_port = htons(atoi(argv[optind + 2]));
+    if (inet_pton(AF_INET, argv[optind + 1], &upstream.sin_addr) <= 0) {
+        fprintf(stderr, "Invalid upstream address: %s\n", argv[optind + 1]);
+        return 1;
+    }
+
+    int sock = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(listen_port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    int opt_val = 1;
+    if (sock < 0 ||
+        setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &opt_val, sizeof(opt_val)) < 0 ||
+        bind(sock, (struct sockaddr*)&addr, sizeof(addr)) < 0 ||
+        listen(sock, SOMAXCONN) < 0) {
+        perror("Unable to listen");
+        return 1;
+    }
+
+    net_emu_t *emu = net_emu_start(&config, sock, &upstream);
+    if (!emu) {
+        close(sock);
+        return 1;
+    }
+
+    char desc[160];
+    net_emu_describe(&config, desc, sizeof(desc));
+    printf("netem proxy 127.0.0.1:%d -> %s:%s\n", listen_port, argv[optind + 1], argv[optind + 2]);
+    printf("Link: %s\n", desc);
+    fflush(stdout);
+
+    signal(SIGINT, handle_signal);
+    signal(SIGTERM, handle_signal);
+    while (!stop_requested) {
+        pause();
+    }
+
+    net_emu_stats_t stats;
+    net_emu_stop(emu, &stats);
+    close(sock);
+
+    printf("\nConnections: %lu, segments: %lu, bytes: %lu, lost (delayed by RTO): %lu\n",
+           stats.connections, stats.segments, stats.bytes, stats.lost);
+    return 0;
+}
@@ -0,0 +1,222 @@
+#define _GNU_SOURCE
+#include "bulk_client.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <openssl/err.h>
+#include "../Common/metrics.h"
+#include "../Common/count_bio.h"
+
+#define BULK_READ_BUFFER 16384      // SSL_read 1회는 레코드 1개까지
+
+// 송신 스레드 상태
+typedef struct {
+    const bulk_config_t *config;
+    int listen_fd;
+    int rc;
+    double cpu_ms;
+    uint64_t syscalls;
+    bool ktls_send;
+    bool used_sendfile;
+} sender_t;
+
+static double thread_cpu_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+// 핸드셰이크 전 SSL 설정: 레코드 크기, kTLS
+static SSL* bulk_ssl(SSL_CTX *ctx, const bulk_config_t *config, int fd, wire_count_t *wire) {
+    SSL *ssl = SSL_new(ctx);
+    if (!ssl || !count_bio_attach(ssl, fd, wire) ||
+        SSL_set_max_send_fragment(ssl, config->max_fragment) != 1) {
+        SSL_free(ssl);
+        return NULL;
+    }
+    if (config->ktls) {
+        SSL_set_options(ssl, SSL_OP_ENABLE_KTLS);
+    }
+    return ssl;
+}
+
+// 전송할 평문 write_size 바이트: SSL_write 버퍼, sendfile이면 같은 내용의 memfd
+static bool sender_send(SSL *ssl, const bulk_config_t *config, wire_count_t *wire, sender_t *s) {
+    char *payload = malloc(config->write_size);
+    int memfd = -1;
+    bool ok = payload != NULL;
+    if (ok) {
+        memset(payload, 'B', config->write_size);
+    }
+    if (ok && config->sendfile && s->ktls_send) {
+        memfd = memfd_create("bulk", MFD_CLOEXEC);
+        ok = memfd >= 0 && write(memfd, payload, config->write_size) == (ssize_t)config->write_size;
+        s->used_sendfile = ok;
+    }
+
+    uint32_t writes_start = wire->write_calls;
+    uint64_t sendfile_calls = 0;
+    double cpu_start = thread_cpu_ms();
+    size_t sent = 0;
+    while (ok && sent < config->total_bytes) {
+        size_t chunk = config->total_bytes - sent;
+        if (chunk > config->write_size) {
+            chunk = config->write_size;
+        }
+        if (s->used_sendfile) {
+            // 같은 memfd 구간을 반복 전송, 커널이 페이지를 바로 암호화해 소켓으로
+            ossl_ssize_t n = SSL_sendfile(ssl, memfd, 0, chunk, 0);
+            sendfile_calls++;
+            ok = n > 0;
+            sent += ok ? (size_t)n : 0;
+        } else {
+            int n = SSL_write(ssl, payload, (int)chunk);
+            ok = n > 0;
+            sent += ok ? (size_t)n : 0;
+        }
+    }
+    s->cpu_ms = thread_cpu_ms() - cpu_start;
+    s->syscalls = sendfile_calls + (wire->write_calls - writes_start);
+
+    if (memfd >= 0) {
+        close(memfd);
+    }
+    free(payload);
+    return ok;
+}
+
+static void* sender_main(void *arg) {
+    sender_t *s = arg;
+    const bulk_config_t *config = s->config;
+    wire_count_t wire;
+    memset(&wire, 0, sizeof(wire));
+
+    int fd = accept(s->listen_fd, NULL, NULL);
+    if (fd < 0) {
+        return NULL;
+    }
+    SSL *ssl = bulk_ssl(config->server_ctx, config, fd, &wire);
+    if (ssl && SSL_accept(ssl) == 1) {
+        s->ktls_send = BIO_get_ktls_send(SSL_get_wbio(ssl));
+        if (sender_send(ssl, config, &wire, s)) {
+            s->rc = 0;
+        }
+        SSL_shutdown(ssl);
+        // 수신 측이 다 읽고 닫을 때까지 대기 (먼저 닫으면 남은 데이터가 RST로 버려질 수 있음)
+        char c;
+        while (read(fd, &c, 1) > 0) {
+        }
+    } else {
+        fprintf(stderr, "Bulk sender handshake failed\n");
+    }
+    ERR_clear_error();
+    SSL_free(ssl);
+    close(fd);
+    return NULL;
+}
+
+static int connect_loopback(const struct sockaddr_in *addr) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    if (connect(fd, (const struct sockaddr*)addr, sizeof(*addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int run_bulk_transfer(const bulk_config_t *config, bulk_result_t *result) {
+    memset(result, 0, sizeof(bulk_result_t));
+    if (config->total_bytes == 0 || config->write_size == 0 || config->write_size > INT_MAX ||
+        config->max_fragment < BULK_MIN_FRAGMENT || config->max_fragment > BULK_MAX_FRAGMENT) {
+        fprintf(stderr, "Invalid bulk transfer: %zu bytes, write %zu, fragment %zu\n",
+                config->total_bytes, config->write_size, config->max_fragment);
+        return -1;
+    }
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t len = sizeof(addr);
+    int listen_fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listen_fd < 0 ||
+        bind(listen_fd, (struct sockaddr*)&addr, sizeof(addr)) < 0 ||
+        listen(listen_fd, 1) < 0 ||
+        getsockname(listen_fd, (struct sockaddr*)&addr, &len) < 0) {
+        perror("Bulk listener");
+        if (listen_fd >= 0) {
+            close(listen_fd);
+        }
+        return -1;
+    }
+
+    sender_t sender = { .config = config, .listen_fd = listen_fd, .rc = -1 };
+    pthread_t thread;
+    if (pthread_create(&thread, NULL, sender_main, &sender) != 0) {
+        perror("pthread_create");
+        close(listen_fd);
+        return -1;
+    }
+
+    wire_count_t wire;
+    memset(&wire, 0, sizeof(wire));
+    size_t received = 0;
+    double receiver_cpu_ms = 0;
+    int fd = connect_loopback(&addr);
+    SSL *ssl = fd >= 0 ? bulk_ssl(config->client_ctx, config, fd, &wire) : NULL;
+    if (ssl && SSL_connect(ssl) == 1) {
+        result->ktls_recv = BIO_get_ktls_recv(SSL_get_rbio(ssl));
+        char buf[BULK_READ_BUFFER];
+        uint32_t reads_start = wire.read_calls;
+        bench_timer_t timer;
+        start_timer(&timer);
+        double cpu_start = thread_cpu_ms();
+        while (received < config->total_bytes) {
+            int n = SSL_read(ssl, buf, sizeof(buf));
+            if (n <= 0) {
+                break;
+            }
+            received += n;
+        }
+        result->seconds = end_timer(&timer) / 1000.0;
+        receiver_cpu_ms = thread_cpu_ms() - cpu_start;
+        result->receiver_syscalls_per_mib = (double)(wire.read_calls - reads_start) * (1 << 20) /
+                                           config->total_bytes;
+        SSL_shutdown(ssl);
+    } else {
+        fprintf(stderr, "Bulk receiver handshake failed\n");
+        // 송신 스레드가 accept에서 기다리고 있으면 깨움
+        shutdown(listen_fd, SHUT_RDWR);
+    }
+    ERR_clear_error();
+    SSL_free(ssl);
+    if (fd >= 0) {
+        close(fd);
+    }
+    pthread_join(thread, NULL);
+    close(listen_fd);
+
+    if (sender.rc != 0 || received < config->total_bytes || result->seconds <= 0) {
+        return -1;
+    }
+    // 단위는 모두 2진 (GiB = 2^30, MiB = 2^20 바이트)
+    double gib = config->total_bytes / (double)(1 << 30);
+    result->gib_per_sec = gib / result->seconds;
+    result->sender_cpu_ms_per_gib = sender.cpu_ms / gib;
+    result->receiver_cpu_ms_per_gib = receiver_cpu_ms / gib;
+    result->sender_syscalls_per_mib = (double)sender.syscalls * (1 << 20) / config->total_bytes;
+    result->ktls_send = sender.ktls_send;
+    result->used_sendfile = sender.used_sendfile;
+    return 0;
+}
@@ -0,0 +1,38 @@
+#ifndef BULK_CLIENT_H
+#define BULK_CLIENT_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <openssl/ssl.h>
+
+#define BULK_MIN_FRAGMENT 512
+#define BULK_MAX_FRAGMENT 16384
+
+// 핸드셰이크 후 대량 전송 1회 설정 (서버 → 클라이언트, 같은 프로세스의 루프백 연결)
+typedef struct {
+    SSL_CTX *server_ctx;      // 송신 측 (전송마다 띄우는 서버 스레드)
+    SSL_CTX *client_ctx;      // 수신 측 (호출 스레드, mTLS)
+    size_t total_bytes;       // 보낼 평문 바이트
+    size_t write_size;        // SSL_write/SSL_sendfile 1회 크기
+    size_t max_fragment;      // SSL_set_max_send_fragment (레코드 평문 최대 크기)
+    bool ktls;                // SSL_OP_ENABLE_KTLS (양쪽, 커널이 지원하면 레코드 암복호를 커널에서)
+    bool sendfile;            // kTLS 송신이 켜졌으면 SSL_sendfile (memfd → 소켓, 사용자 공간 복사 없음)
+} bulk_config_t;
+
+// 전송 1회 결과
+typedef struct {
+    double seconds;           // 수신 측 핸드셰이크 완료 → 마지막 바이트
+    double gib_per_sec;       // 2진 단위 (GiB = 2^30, MiB = 2^20 바이트)
+    double sender_cpu_ms_per_gib;     // 스레드 CPU (사용자 + 커널, kTLS 암호화는 커널 쪽)
+    double receiver_cpu_ms_per_gib;
+    double sender_syscalls_per_mib;   // 송신 write/sendfile 호출
+    double receiver_syscalls_per_mib; // 수신 read 호출
+    bool ktls_send;           // 실제로 커널 송신 오프로드가 켜짐
+    bool ktls_recv;
+    bool used_sendfile;
+} bulk_result_t;
+
+// 핸드셰이크 1회 후 total_bytes 전송 (0: 성공)
+int run_bulk_transfer(const bulk_config_t *config, bulk_result_t *result);
+
+#endif // BULK_CLIENT_H
@@ -0,0 +1,979 @@
+#include "load_client.h"
+#include "../Common/histogram.h"
+#include "../Common/count_bio.h"
+#include "../Common/io_ring.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <openssl/err.h>
+
+#define MAX_EVENTS 256
+#define EPOLL_TIMEOUT_MS 10
+#define DRAIN_MAX_MS 5000.0
+#define SWEEP_PAUSE_US 500000
+
+// io_uring 경로 (서버 엔진과 같은 구성: 멀티샷 recv + 버퍼 링, SSL은 BIO pair)
+#define URING_MIN_ENTRIES 64
+#define URING_MAX_ENTRIES 4096
+#define URING_RECV_BUFS 256             // 워커별 수신 버퍼 링 (2의 거듭제곱)
+#define URING_RECV_BUF_SIZE 16384
+#define URING_BIO_BUF (17 * 1024)       // BIO pair 방향별 버퍼
+
+// io_uring user_data: 슬롯 포인터(8바이트 정렬) | 요청 종류
+#define URING_OP_MASK 7u
+enum { URING_CONNECT, URING_RECV, URING_SEND, URING_CANCEL, URING_CLOSE };
+
+// 연결 슬롯 상태
+typedef enum {
+    SLOT_IDLE,
+    SLOT_CONNECTING,
+    SLOT_HANDSHAKE
+} slot_state_t;
+
+typedef struct slot {
+    int fd;
+    SSL *ssl;
+    slot_state_t state;
+    uint32_t events;
+    bench_timer_t timer;
+    double intended_ms;     // open-loop: 예약된 시작 시각
+    wire_count_t wire;      // 소켓 BIO의 read/write 시도 수 (epoll 경로 시스템 콜)
+    // io_uring 경로: SSL은 BIO pair에 쓰고, 워커가 네트워크 쪽(net)과 소켓 사이를 링으로 옮김
+    BIO *net;
+    uint32_t send_len;      // 진행 중인 송신 (0: 없음)
+    int inflight;           // 완료를 기다리는 요청 수 (0이 되어야 슬롯 반환)
+    bool recv_armed;        // 멀티샷 recv 진행 중
+    bool eof;               // 피어 송신 종료 또는 수신 오류
+    bool send_failed;
+    bool canceled;          // recv 취소 제출함
+    bool closing;           // 핸드셰이크 종료, 송신이 끝나면 닫음
+    bool need_connect;      // connect 제출이 제출 엔트리를 기다림
+    bool need_recv;         // 멀티샷 recv 제출이 제출 엔트리를 기다림
+    bool stalled;           // 워커의 재시도 목록에 있음
+    struct slot *stall_next;
+} slot_t;
+
+typedef struct {
+    const load_config_t *config;
+    const struct sockaddr_in *addr;
+    double deadline_ms;
+    pthread_t thread;
+    int epfd;
+    io_ring_t *uring;       // io_uring 경로 (NULL: epoll)
+    bool io_uring;          // 링을 만들어 io_uring으로 동작함
+    slot_t *stalled;        // 제출 엔트리를 못 받은 슬롯 (다음 io_uring_enter 후 재시도)
+    int nslots;
+    slot_t *slots;
+    int *free_idx;          // 유휴 슬롯 스택
+    int nfree;
+
+    // open-loop 스케줄러
+    bool open_loop;
+    double mean_gap_ms;
+    double next_arrival_ms;
+    unsigned short xsubi[3];
+    double *pending;        // 슬롯 부족으로 대기 중인 예약 시각 (FIFO 링)
+    size_t pending_head;
+    size_t pending_count;
+    size_t pending_cap;
+
+    uint64_t ok;
+    uint64_t ok_in_window;  // open-loop: 측정 구간(deadline) 안에 끝난 완료 (drain 제외)
+    uint64_t failed;
+    uint64_t timeouts;
+    uint64_t arrivals;
+    uint64_t connects;
+    uint64_t syscalls;
+    uint64_t io_ops;
+    perf_values_t perf;     // 이 워커 스레드의 SSL_connect 구간 누적
+    histogram_t latency;    // 레이턴시 (ms), 워커 전용이라 잠금 없이 기록 후 종료 시 병합
+} load_worker_t;
+
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static bool pending_push(load_worker_t *w, double intended_ms) {
+    if (w->pending_count == w->pending_cap) {
+        size_t cap = w->pending_cap ? w->pending_cap * 2 : 1024;
+        double *p = malloc(cap * sizeof(double));
+        if (!p) {
+            return false;
+        }
+        for (size_t i = 0; i < w->pending_count; i++) {
+            p[i] = w->pending[(w->pending_head + i) % w->pending_cap];
+        }
+        free(w->pending);
+        w->pending = p;
+        w->pending_head = 0;
+        w->pending_cap = cap;
+    }
+    w->pending[(w->pending_head + w->pending_count) % w->pending_cap] = intended_ms;
+    w->pending_count++;
+    return true;
+}
+
+static double pending_pop(load_worker_t *w) {
+    double v = w->pending[w->pending_head];
+    w->pending_head = (w->pending_head + 1) % w->pending_cap;
+    w->pending_count--;
+    return v;
+}
+
+// 다음 도착 간격 (constant: 고정, poisson: 지수분포)
+static double next_gap_ms(load_worker_t *w) {
+    if (w->config->arrival == ARRIVAL_POISSON) {
+        return -log(1.0 - erand48(w->xsubi)) * w->mean_gap_ms;
+    }
+    return w->mean_gap_ms;
+}
+
+static void slot_set_events(load_worker_t *w, slot_t *s, uint32_t events) {
+    if (s->events == events) {
+        return;
+    }
+    struct epoll_event ev = { .events = events, .data.ptr = s };
+    epoll_ctl(w->epfd, EPOLL_CTL_MOD, s->fd, &ev);
+    w->syscalls++;
+    s->events = events;
+}
+
+// 유휴 스택으로 반환
+static void slot_release(load_worker_t *w, slot_t *s) {
+    s->state = SLOT_IDLE;
+    w->free_idx[w->nfree++] = (int)(s - w->slots);
+    ERR_clear_error();
+}
+
+// 슬롯 정리 후 유휴 스택으로 반환 (close_notify 전송은 best-effort)
+static void slot_finish(load_worker_t *w, slot_t *s) {
+    if (s->state == SLOT_IDLE) {
+        return;
+    }
+    if (s->ssl) {
+        SSL_shutdown(s->ssl);
+        SSL_free(s->ssl);
+        s->ssl = NULL;
+    }
+    if (s->fd >= 0) {
+        epoll_ctl(w->epfd, EPOLL_CTL_DEL, s->fd, NULL);
+        close(s->fd);
+        s->fd = -1;
+        // epoll_ctl DEL, close, 소켓 BIO의 read/write (close_notify 포함)
+        w->syscalls += 2 + s->wire.read_calls + s->wire.write_calls;
+        w->io_ops += 1 + s->wire.read_calls + s->wire.write_calls;
+    }
+    slot_release(w, s);
+}
+
+// 핸드셰이크 성공 기록 (측정 구간이 끝난 뒤 drain에서 끝난 건은 처리율에서 제외)
+static void slot_done(load_worker_t *w, slot_t *s) {
+    double now = now_ms();
+    hist_record(&w->latency, w->open_loop ? now - s->intended_ms : end_timer(&s->timer));
+    w->ok++;
+    if (now <= w->deadline_ms) {
+        w->ok_in_window++;
+    }
+}
+
+// SSL 객체 생성 (SNI 포함, 실패 시 NULL)
+static SSL* slot_ssl_new(load_worker_t *w) {
+    SSL *ssl = SSL_new(w->config->ctx);
+    if (ssl && w->config->server_name && !SSL_set_tlsext_host_name(ssl, w->config->server_name)) {
+        SSL_free(ssl);
+        return NULL;
+    }
+    return ssl;
+}
+
+static void slot_handshake(load_worker_t *w, slot_t *s) {
+    perf_values_t perf_start;
+    perf_begin(&perf_start);
+    int ret = SSL_connect(s->ssl);
+    perf_end(&perf_start, &w->perf);
+    if (ret == 1) {
+        slot_done(w, s);
+        slot_finish(w, s);
+        return;
+    }
+
+    switch (SSL_get_error(s->ssl, ret)) {
+    case SSL_ERROR_WANT_READ:
+        slot_set_events(w, s, EPOLLIN);
+        break;
+    case SSL_ERROR_WANT_WRITE:
+        slot_set_events(w, s, EPOLLOUT);
+        break;
+    default:
+        w->failed++;
+        slot_finish(w, s);
+        break;
+    }
+}
+
+// TCP 연결 완료 → SSL 객체 생성 후 핸드셰이크 시작
+static void slot_connected(load_worker_t *w, slot_t *s) {
+    s->ssl = slot_ssl_new(w);
+    if (!s->ssl || !count_bio_attach(s->ssl, s->fd, &s->wire)) {
+        w->failed++;
+        slot_finish(w, s);
+        return;
+    }
+    s->state = SLOT_HANDSHAKE;
+    start_timer(&s->timer);
+    slot_handshake(w, s);
+}
+
+// 논블로킹 connect 시작
+static void slot_start(load_worker_t *w, slot_t *s, double intended_ms) {
+    s->state = SLOT_CONNECTING;
+    s->intended_ms = intended_ms;
+    memset(&s->wire, 0, sizeof(s->wire));
+    s->fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    w->connects++;
+    w->syscalls++;
+    if (s->fd < 0) {
+        w->failed++;
+        slot_finish(w, s);
+        return;
+    }
+
+    // RST 종료로 TIME_WAIT 누적(에페메럴 포트 고갈) 방지
+    struct linger lg = { .l_onoff = 1, .l_linger = 0 };
+    setsockopt(s->fd, SOL_SOCKET, SO_LINGER, &lg, sizeof(lg));
+
+    s->events = EPOLLOUT;
+    struct epoll_event ev = { .events = EPOLLOUT, .data.ptr = s };
+    w->syscalls += 2;
+    if (epoll_ctl(w->epfd, EPOLL_CTL_ADD, s->fd, &ev) < 0) {
+        close(s->fd);
+        s->fd = -1;
+        w->syscalls++;
+        w->io_ops++;
+        w->failed++;
+        slot_finish(w, s);
+        return;
+    }
+
+    w->syscalls++;
+    w->io_ops++;
+    if (connect(s->fd, (const struct sockaddr*)w->addr, sizeof(*w->addr)) == 0) {
+        slot_connected(w, s);
+    } else if (errno != EINPROGRESS) {
+        w->failed++;
+        slot_finish(w, s);
+    }
+}
+
+static void slot_event(load_worker_t *w, slot_t *s) {
+    if (s->state == SLOT_CONNECTING) {
+        int err = 0;
+        socklen_t len = sizeof(err);
+        getsockopt(s->fd, SOL_SOCKET, SO_ERROR, &err, &len);
+        w->syscalls++;
+        if (err != 0) {
+            w->failed++;
+            slot_finish(w, s);
+            return;
+        }
+        slot_connected(w, s);
+    } else if (s->state == SLOT_HANDSHAKE) {
+        slot_handshake(w, s);
+    }
+}
+
+static int poll_slots(load_worker_t *w, int timeout_ms) {
+    struct epoll_event events[MAX_EVENTS];
+
+    int n = epoll_wait(w->epfd, events, MAX_EVENTS, timeout_ms);
+    w->syscalls++;
+    if (n < 0) {
+        if (errno == EINTR) return 0;
+        perror("epoll_wait");
+        return -1;
+    }
+    for (int i = 0; i < n; i++) {
+        slot_event(w, events[i].data.ptr);
+    }
+    return 0;
+}
+
+// ---- io_uring 경로 ----
+
+// 제출 큐가 가득 차 요청을 넣지 못한 슬롯: 버리지 않고 다음 enter 후 재시도
+static void uring_stall(load_worker_t *w, slot_t *s) {
+    if (s->stalled) {
+        return;
+    }
+    s->stalled = true;
+    s->stall_next = w->stalled;
+    w->stalled = s;
+}
+
+static void uring_arm_connect(load_worker_t *w, slot_t *s) {
+    struct io_uring_sqe *sqe = io_ring_sqe(w->uring);
+    if (!sqe) {
+        s->need_connect = true;
+        uring_stall(w, s);
+        return;
+    }
+    s->need_connect = false;
+    sqe->opcode = IORING_OP_CONNECT;
+    sqe->fd = s->fd;
+    sqe->addr = (uint64_t)(uintptr_t)w->addr;
+    sqe->off = sizeof(*w->addr);
+    sqe->user_data = (uint64_t)(uintptr_t)s | URING_CONNECT;
+    s->inflight++;
+}
+
+// 멀티샷 recv: 커널이 버퍼 링(그룹 0)에서 버퍼를 골라 채움
+static void uring_arm_recv(load_worker_t *w, slot_t *s) {
+    struct io_uring_sqe *sqe = io_ring_sqe(w->uring);
+    if (!sqe) {
+        s->need_recv = true;
+        uring_stall(w, s);
+        return;
+    }
+    s->need_recv = false;
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = s->fd;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = 0;
+    sqe->user_data = (uint64_t)(uintptr_t)s | URING_RECV;
+    s->recv_armed = true;
+    s->inflight++;
+}
+
+// BIO pair에 쌓인 송신 데이터를 소켓으로 (슬롯당 송신 1개씩, 완료된 만큼만 소비)
+static void uring_flush(load_worker_t *w, slot_t *s) {
+    if (!s->net || s->send_failed || s->send_len > 0) {
+        return;
+    }
+    char *data;
+    int n = BIO_nread0(s->net, &data);
+    if (n <= 0) {
+        return;
+    }
+    struct io_uring_sqe *sqe = io_ring_sqe(w->uring);
+    if (!sqe) {
+        uring_stall(w, s);
+        return;
+    }
+    sqe->opcode = IORING_OP_SEND;
+    sqe->fd = s->fd;
+    sqe->addr = (uint64_t)(uintptr_t)data;
+    sqe->len = n;
+    sqe->msg_flags = MSG_NOSIGNAL;
+    sqe->user_data = (uint64_t)(uintptr_t)s | URING_SEND;
+    s->send_len = n;
+    s->inflight++;
+}
+
+// 핸드셰이크 종료(성공/실패): close_notify를 BIO pair에 남기고 닫기로 전환
+static void uring_close(slot_t *s) {
+    if (s->closing) {
+        return;
+    }
+    if (s->ssl && !s->send_failed) {
+        SSL_shutdown(s->ssl);
+    }
+    s->closing = true;
+}
+
+// 소켓 쪽이 먼저 실패: 핸드셰이크 중이었으면 실패로 집계하고 닫기로 전환
+static void uring_abort(load_worker_t *w, slot_t *s) {
+    if (s->closing) {
+        return;
+    }
+    w->failed++;
+    uring_close(s);
+}
+
+// SSL_connect 구동 후 만들어진 레코드 송신 (읽기는 다음 recv 완료, 쓰기는 송신 완료가 다시 구동)
+static void uring_run(load_worker_t *w, slot_t *s) {
+    if (s->state == SLOT_HANDSHAKE && !s->closing) {
+        perf_values_t perf_start;
+        perf_begin(&perf_start);
+        int ret = SSL_connect(s->ssl);
+        perf_end(&perf_start, &w->perf);
+        if (ret == 1) {
+            slot_done(w, s);
+            uring_close(s);
+        } else {
+            int err = SSL_get_error(s->ssl, ret);
+            if (err != SSL_ERROR_WANT_READ && err != SSL_ERROR_WANT_WRITE) {
+                uring_abort(w, s);
+            }
+        }
+    }
+    uring_flush(w, s);
+}
+
+// 닫는 중인 슬롯: 송신이 끝나면 recv를 취소하고, 진행 중인 요청이 없으면 닫고 반환
+// (SO_LINGER 0이라 마지막 참조가 사라질 때 RST)
+static void uring_finish(load_worker_t *w, slot_t *s) {
+    if (!s->closing || s->send_len > 0 || s->stalled) {
+        return;
+    }
+    if (s->recv_armed && !s->canceled) {
+        struct io_uring_sqe *sqe = io_ring_sqe(w->uring);
+        if (!sqe) {
+            uring_stall(w, s);
+            return;
+        }
+        sqe->opcode = IORING_OP_ASYNC_CANCEL;
+        sqe->addr = (uint64_t)(uintptr_t)s | URING_RECV;
+        sqe->user_data = URING_CANCEL;
+        s->canceled = true;
+    }
+    if (s->inflight > 0) {
+        return;
+    }
+
+    struct io_uring_sqe *sqe = io_ring_sqe(w->uring);
+    if (sqe) {
+        sqe->opcode = IORING_OP_CLOSE;
+        sqe->fd = s->fd;
+        sqe->user_data = URING_CLOSE;
+    } else {
+        close(s->fd);
+        w->syscalls++;
+        w->io_ops++;
+    }
+    s->fd = -1;
+    SSL_free(s->ssl);
+    s->ssl = NULL;
+    BIO_free(s->net);
+    s->net = NULL;
+    slot_release(w, s);
+}
+
+// 완료 처리 끝에 한 번: 구동, 송신, 정리 (이후 s 접근 금지)
+static void uring_step(load_worker_t *w, slot_t *s) {
+    uring_run(w, s);
+    uring_finish(w, s);
+}
+
+// io_uring_enter로 제출 큐가 비워진 뒤: 멈춘 슬롯의 connect/recv/송신/정리 재시도
+static void uring_retry(load_worker_t *w) {
+    slot_t *s = w->stalled;
+    w->stalled = NULL;
+    while (s) {
+        slot_t *next = s->stall_next;
+        s->stalled = false;
+        if (s->need_connect) {
+            uring_arm_connect(w, s);
+        } else {
+            if (s->need_recv && !s->eof && !s->closing) {
+                uring_arm_recv(w, s);
+            }
+            uring_step(w, s);
+        }
+        s = next;
+    }
+}
+
+// 소켓 생성 후 IORING_OP_CONNECT (논블로킹 소켓이면 커널이 연결 완료를 기다려 완료 엔트리로 알림)
+static void uring_slot_start(load_worker_t *w, slot_t *s, double intended_ms) {
+    s->state = SLOT_CONNECTING;
+    s->intended_ms = intended_ms;
+    memset(&s->wire, 0, sizeof(s->wire));
+    s->send_len = 0;
+    s->recv_armed = s->eof = s->send_failed = s->canceled = s->closing = false;
+    s->need_connect = s->need_recv = false;
+    s->fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    w->connects++;
+    w->syscalls++;
+    if (s->fd < 0) {
+        w->failed++;
+        slot_release(w, s);
+        return;
+    }
+
+    // RST 종료로 TIME_WAIT 누적(에페메럴 포트 고갈) 방지
+    struct linger lg = { .l_onoff = 1, .l_linger = 0 };
+    setsockopt(s->fd, SOL_SOCKET, SO_LINGER, &lg, sizeof(lg));
+    w->syscalls++;
+    uring_arm_connect(w, s);
+}
+
+// TCP 연결 완료 → BIO pair에 연결한 SSL 객체 생성, recv 등록 후 ClientHello 송신
+static void uring_connected(load_worker_t *w, slot_t *s) {
+    s->ssl = slot_ssl_new(w);
+    if (!s->ssl || !count_bio_attach_pair(s->ssl, URING_BIO_BUF, &s->wire, &s->net)) {
+        uring_abort(w, s);
+        return;
+    }
+    s->state = SLOT_HANDSHAKE;
+    start_timer(&s->timer);
+    uring_arm_recv(w, s);
+}
+
+// 받은 바이트를 BIO pair에 넣음 (SSL 쪽이 가득 차면 구동해 소비시킨 뒤 계속)
+static void uring_feed(load_worker_t *w, slot_t *s, const char *data, int len) {
+    while (len > 0 && !s->closing) {
+        int n = BIO_write(s->net, data, len);
+        if (n > 0) {
+            data += n;
+            len -= n;
+            continue;
+        }
+        uring_run(w, s);
+        if (!s->closing && BIO_ctrl_get_write_guarantee(s->net) == 0) {
+            uring_abort(w, s);
+            return;
+        }
+    }
+}
+
+static void uring_complete(load_worker_t *w, uint64_t data, int res, uint32_t flags) {
+    unsigned op = data & URING_OP_MASK;
+    slot_t *s = (slot_t*)(uintptr_t)(data & ~(uint64_t)URING_OP_MASK);
+
+    switch (op) {
+    case URING_CONNECT:
+        s->inflight--;
+        if (res < 0) {
+            uring_abort(w, s);
+        } else {
+            uring_connected(w, s);
+        }
+        uring_step(w, s);
+        return;
+
+    case URING_RECV:
+        if (!(flags & IORING_CQE_F_MORE)) {
+            s->recv_armed = false;
+            s->inflight--;
+        }
+        if (res > 0) {
+            unsigned bid = flags >> IORING_CQE_BUFFER_SHIFT;
+            uring_feed(w, s, io_ring_buf(w->uring, bid), res);
+            io_ring_buf_recycle(w->uring, bid);
+        } else if (res != -ENOBUFS && res != -ECANCELED) {
+            // 피어 종료(0) 또는 오류: SSL 쪽에 EOF 전달
+            s->eof = true;
+            BIO_shutdown_wr(s->net);
+        }
+        // 버퍼 링이 비었거나(-ENOBUFS) 커널이 멀티샷을 끝낸 경우 다시 제출
+        if (!s->recv_armed && !s->eof && !s->closing) {
+            uring_arm_recv(w, s);
+        }
+        uring_step(w, s);
+        return;
+
+    case URING_SEND:
+        s->inflight--;
+        if (res <= 0) {
+            s->send_failed = true;
+            s->send_len = 0;
+            uring_abort(w, s);
+        } else {
+            char *sent;
+            BIO_nread(s->net, &sent, res);
+            s->send_len = 0;
+        }
+        uring_step(w, s);
+        return;
+
+    default:
+        // 취소/close 완료는 기다리지 않음
+        return;
+    }
+}
+
+static int uring_poll(load_worker_t *w, int timeout_ms) {
+    // 대기 시간이 0이면 제출만 하고 이미 도착한 완료를 처리
+    int ret = io_ring_enter(w->uring, timeout_ms > 0 ? 1 : 0, timeout_ms);
+    if (ret < 0) {
+        fprintf(stderr, "io_uring_enter: %s\n", strerror(-ret));
+        return -1;
+    }
+    struct io_uring_cqe *cqe;
+    while ((cqe = io_ring_cqe(w->uring)) != NULL) {
+        uint64_t data = cqe->user_data;
+        int res = cqe->res;
+        uint32_t flags = cqe->flags;
+        io_ring_cqe_seen(w->uring);
+        w->io_ops++;
+        uring_complete(w, data, res, flags);
+    }
+    uring_retry(w);
+    return 0;
+}
+
+// 워커 스레드에서 링 생성 (SINGLE_ISSUER: 만든 스레드만 제출), 실패하면 epoll 경로
+static void uring_init(load_worker_t *w) {
+    if (!w->config->io_uring) {
+        return;
+    }
+    unsigned entries = (unsigned)w->nslots * 4;
+    if (entries < URING_MIN_ENTRIES) entries = URING_MIN_ENTRIES;
+    if (entries > URING_MAX_ENTRIES) entries = URING_MAX_ENTRIES;
+    w->uring = io_ring_new(entries);
+    if (!w->uring || !io_ring_setup_bufs(w->uring, URING_RECV_BUFS, URING_RECV_BUF_SIZE)) {
+        io_ring_free(w->uring);
+        w->uring = NULL;
+        fprintf(stderr, "io_uring unavailable, using epoll\n");
+        return;
+    }
+    w->io_uring = true;
+}
+
+// ---- 워커 공통 ----
+
+static void worker_start(load_worker_t *w, slot_t *s, double intended_ms) {
+    if (w->uring) {
+        uring_slot_start(w, s, intended_ms);
+    } else {
+        slot_start(w, s, intended_ms);
+    }
+}
+
+static int worker_poll(load_worker_t *w, int timeout_ms) {
+    return w->uring ? uring_poll(w, timeout_ms) : poll_slots(w, timeout_ms);
+}
+
+// 진행 중인 핸드셰이크 수 (닫기만 남은 슬롯 제외)
+static int worker_in_flight(const load_worker_t *w) {
+    int n = 0;
+    for (int i = 0; i < w->nslots; i++) {
+        n += w->slots[i].state != SLOT_IDLE && !w->slots[i].closing;
+    }
+    return n;
+}
+
+// 남은 슬롯 정리 (io_uring: 링을 먼저 닫아 남은 요청을 취소한 뒤 동기 close)
+static void worker_close_all(load_worker_t *w) {
+    if (!w->uring) {
+        for (int i = 0; i < w->nslots; i++) {
+            slot_finish(w, &w->slots[i]);
+        }
+        return;
+    }
+    w->syscalls += io_ring_enters(w->uring);
+    io_ring_free(w->uring);
+    for (int i = 0; i < w->nslots; i++) {
+        slot_t *s = &w->slots[i];
+        if (s->state == SLOT_IDLE) {
+            continue;
+        }
+        if (s->fd >= 0) {
+            close(s->fd);
+            s->fd = -1;
+            w->syscalls++;
+            w->io_ops++;
+        }
+        SSL_free(s->ssl);
+        s->ssl = NULL;
+        BIO_free(s->net);
+        s->net = NULL;
+        slot_release(w, s);
+    }
+}
+
+static void* closed_worker_main(void *arg) {
+    load_worker_t *w = arg;
+
+    uring_init(w);
+
+    while (now_ms() < w->deadline_ms) {
+        // 완료/실패한 슬롯은 즉시 새 연결로 채움
+        int idle = w->nfree;
+        for (int i = 0; i < idle; i++) {
+            worker_start(w, &w->slots[w->free_idx[--w->nfree]], 0.0);
+        }
+
+        if (worker_poll(w, EPOLL_TIMEOUT_MS) < 0) {
+            break;
+        }
+    }
+
+    // 측정 시간 종료 시점에 진행 중인 핸드셰이크는 집계하지 않음
+    worker_close_all(w);
+    return NULL;
+}
+
+// 대기 중인 예약을 유휴 슬롯에 배정
+static void dispatch_pending(load_worker_t *w) {
+    while (w->pending_count > 0 && w->nfree > 0) {
+        worker_start(w, &w->slots[w->free_idx[--w->nfree]], pending_pop(w));
+    }
+}
+
+static void* open_worker_main(void *arg) {
+    load_worker_t *w = arg;
+
+    uring_init(w);
+
+    for (;;) {
+        double now = now_ms();
+        if (now >= w->deadline_ms) {
+            break;
+        }
+
+        // 예약 시각이 지난 도착은 서버 상태와 무관하게 발생한 것으로 간주
+        while (w->next_arrival_ms <= now && w->next_arrival_ms < w->deadline_ms) {
+            w->arrivals++;
+            if (!pending_push(w, w->next_arrival_ms)) {
+                w->failed++;
+            }
+            w->next_arrival_ms += next_gap_ms(w);
+        }
+        dispatch_pending(w);
+
+        double wait = w->next_arrival_ms - now_ms();
+        int timeout = wait <= 0 ? 0 : (int)ceil(wait);
+        if (timeout > EPOLL_TIMEOUT_MS) {
+            timeout = EPOLL_TIMEOUT_MS;
+        }
+        if (worker_poll(w, timeout) < 0) {
+            break;
+        }
+    }
+
+    // drain: 측정 구간에 예약된 요청은 끝까지 기다려 꼬리 레이턴시에 포함
+    double drain_deadline = w->deadline_ms + DRAIN_MAX_MS;
+    while (now_ms() < drain_deadline && (w->pending_count > 0 || w->nfree < w->nslots)) {
+        dispatch_pending(w);
+        if (worker_poll(w, EPOLL_TIMEOUT_MS) < 0) {
+            break;
+        }
+    }
+
+    w->timeouts += w->pending_count + worker_in_flight(w);
+    worker_close_all(w);
+    return NULL;
+}
+
+static int run_load(const load_config_t *config, bool open_loop, load_result_t *result) {
+    memset(result, 0, sizeof(load_result_t));
+
+    if (config->connections <= 0 || config->threads <= 0 || config->duration_s <= 0 ||
+        (open_loop && config->rate <= 0)) {
+        fprintf(stderr, "Invalid load configuration\n");
+        return -1;
+    }
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(config->port);
+    if (inet_pton(AF_INET, config->host, &addr.sin_addr) <= 0) {
+        fprintf(stderr, "Invalid address: %s\n", config->host);
+        return -1;
+    }
+
+    int nthreads = config->threads < config->connections ? config->threads : config->connections;
+    load_worker_t *workers = calloc(nthreads, sizeof(load_worker_t));
+    slot_t *slots = calloc(config->connections, sizeof(slot_t));
+    int *free_idx = calloc(config->connections, sizeof(int));
+    if (!workers || !slots || !free_idx) {
+        free(workers);
+        free(slots);
+        free(free_idx);
+        return -1;
+    }
+
+    bench_timer_t run_timer;
+    start_timer(&run_timer);
+    double start = now_ms();
+    double deadline = start + config->duration_s * 1000.0;
+
+    int next_slot = 0;
+    int started = 0;
+    for (int i = 0; i < nthreads; i++) {
+        load_worker_t *w = &workers[i];
+        w->config = config;
+        w->addr = &addr;
+        w->deadline_ms = deadline;
+        w->nslots = config->connections / nthreads + (i < config->connections % nthreads ? 1 : 0);
+        w->slots = &slots[next_slot];
+        w->free_idx = &free_idx[next_slot];
+        next_slot += w->nslots;
+        for (int j = 0; j < w->nslots; j++) {
+            w->slots[j].fd = -1;
+            w->slots[j].state = SLOT_IDLE;
+            w->free_idx[j] = w->nslots - 1 - j;
+        }
+        w->nfree = w->nslots;
+
+        w->open_loop = open_loop;
+        if (open_loop) {
+            // 워커별 도착률 = 전체 도착률 / 스레드 수
+            w->mean_gap_ms = 1000.0 * nthreads / config->rate;
+            w->xsubi[0] = (unsigned short)(0x330E + i);
+            w->xsubi[1] = (unsigned short)(start);
+            w->xsubi[2] = (unsigned short)(i * 7919);
+            w->next_arrival_ms = start + (config->arrival == ARRIVAL_POISSON ?
+                                          next_gap_ms(w) : w->mean_gap_ms * i / nthreads);
+        }
+
+        w->epfd = epoll_create1(EPOLL_CLOEXEC);
+        if (w->epfd < 0) {
+            perror("epoll_create1");
+            break;
+        }
+        if (pthread_create(&w->thread, NULL, open_loop ? open_worker_main : closed_worker_main, w) != 0) {
+            perror("pthread_create");
+            close(w->epfd);
+            break;
+        }
+        started++;
+    }
+
+    result->io_uring = started > 0;
+    for (int i = 0; i < started; i++) {
+        pthread_join(workers[i].thread, NULL);
+        result->io_uring = result->io_uring && workers[i].io_uring;
+        close(workers[i].epfd);
+        result->handshakes_ok += workers[i].ok;
+        result->handshakes_in_window += workers[i].ok_in_window;
+        result->handshakes_failed += workers[i].failed;
+        result->timeouts += workers[i].timeouts;
+        result->arrivals += workers[i].arrivals;
+        result->connects += workers[i].connects;
+        result->syscalls += workers[i].syscalls;
+        result->io_ops += workers[i].io_ops;
+        result->perf.cpu_ns += workers[i].perf.cpu_ns;
+        for (int c = 0; c < PERF_COUNTER_COUNT; c++) {
+            result->perf.counters[c] += workers[i].perf.counters[c];
+        }
+    }
+    // open-loop 처리율은 측정 구간 안 완료만 구간 길이로 (drain에서 끝난 건은 레이턴시/성공 수에만 포함)
+    result->elapsed_s = open_loop ? config->duration_s : end_timer(&run_timer) / 1000.0;
+    if (result->elapsed_s > 0) {
+        result->handshakes_per_sec = (open_loop ? result->handshakes_in_window : result->handshakes_ok) /
+                                     result->elapsed_s;
+    }
+    result->target_rate = open_loop ? config->rate : 0.0;
+
+    // 워커별 히스토그램 병합 후 통계 (샘플 수와 무관한 고정 메모리)
+    histogram_t *merged = malloc(sizeof(histogram_t));
+    if (merged) {
+        hist_reset(merged);
+    }
+    for (int i = 0; i < nthreads; i++) {
+        if (merged) {
+            hist_merge(merged, &workers[i].latency);
+        }
+        free(workers[i].pending);
+    }
+    if (merged) {
+        hist_stats(merged, &result->latency_ms);
+    }
+
+    free(merged);
+    free(free_idx);
+    free(slots);
+    free(workers);
+    return started == nthreads ? 0 : -1;
+}
+
+int run_closed_loop(const load_config_t *config, load_result_t *result) {
+    return run_load(config, false, result);
+}
+
+int run_open_loop(const load_config_t *config, load_result_t *result) {
+    return run_load(config, true, result);
+}
+
+// knee 판정: p99 SLO 충족 + 예약된 도착의 실패/미완료 1% 이하
+// (Poisson 도착 수의 표본 변동 때문에 목표 도착률 대비 처리율은 기준으로 쓰지 않음)
+static bool meets_slo(const load_result_t *r, double slo_p99_ms) {
+    uint64_t bad = r->handshakes_failed + r->timeouts;
+    return r->handshakes_ok > 0 &&
+           r->latency_ms.p99 <= slo_p99_ms &&
+           bad * 100 <= r->arrivals;
+}
+
+double run_rate_sweep(const load_config_t *config, const sweep_config_t *sweep) {
+    load_config_t step_config = *config;
+    double knee = 0.0;
+
+    printf("\n%10s %10s %10s %10s %10s %8s %s\n",
+           "target/s", "achieved/s", "p50_ms", "p90_ms", "p99_ms", "errors", "SLO");
+
+    for (double rate = sweep->start; rate <= sweep->stop + 1e-9; rate += sweep->step) {
+        step_config.rate = rate;
+
+        load_result_t result;
+        if (run_open_loop(&step_config, &result) < 0) {
+            break;
+        }
+
+        bool ok = meets_slo(&result, sweep->slo_p99_ms);
+        printf("%10.1f %10.1f %10.3f %10.3f %10.3f %8lu %s\n",
+               rate, result.handshakes_per_sec,
+               result.latency_ms.p50, result.latency_ms.p90, result.latency_ms.p99,
+               result.handshakes_failed + result.timeouts, ok ? "ok" : "VIOLATED");
+        fflush(stdout);
+
+        if (!ok) {
+            // knee 이후 구간은 서버를 과부하로 몰아넣을 뿐이므로 중단
+            break;
+        }
+        knee = rate;
+
+        // 이전 단계의 잔여 연결이 다음 측정에 섞이지 않도록 대기
+        usleep(SWEEP_PAUSE_US);
+    }
+
+    printf("\nKnee: %.1f handshakes/s (p99 <= %.1f ms)\n", knee, sweep->slo_p99_ms);
+    return knee;
+}
+
+void print_load_result(const load_config_t *config, const load_result_t *result) {
+    bool open_loop = result->target_rate > 0;
+
+    printf("\n========================================\n");
+    printf("%s load result\n", open_loop ? "Open-loop" : "Closed-loop");
+    printf("========================================\n");
+    if (open_loop) {
+        printf("  Target rate:     %.1f handshakes/s (%s, max in-flight %d)\n",
+               result->target_rate,
+               config->arrival == ARRIVAL_POISSON ? "poisson" : "constant",
+               config->connections);
+    } else {
+        printf("  Connections:     %d (threads: %d)\n", config->connections, config->threads);
+    }
+    printf("  Duration:        %.2f s\n", result->elapsed_s);
+    printf("  Handshakes OK:   %lu\n", result->handshakes_ok);
+    printf("  Handshakes fail: %lu\n", result->handshakes_failed);
+    if (open_loop) {
+        printf("  Arrivals:        %lu\n", result->arrivals);
+        printf("  Completed in window: %lu (drain %lu)\n", result->handshakes_in_window,
+               result->handshakes_ok - result->handshakes_in_window);
+        printf("  Timeouts:        %lu\n", result->timeouts);
+    }
+    printf("  Throughput:      %.1f handshakes/s\n", result->handshakes_per_sec);
+    printf("  %s latency (ms):\n", open_loop ? "Intended-start" : "SSL_connect");
+    printf("    mean %.3f, p50 %.3f, p90 %.3f, p99 %.3f, stddev %.3f\n",
+           result->latency_ms.mean, result->latency_ms.p50, result->latency_ms.p90,
+           result->latency_ms.p99, result->latency_ms.stddev);
+    printf("    p99.9 %.3f, p99.99 %.3f, min %.3f, max %.3f\n",
+           result->latency_ms.p999, result->latency_ms.p9999,
+           result->latency_ms.min, result->latency_ms.max);
+    if (result->handshakes_ok > 0) {
+        printf("  Client CPU per handshake: %.3f ms, cycles %lu, instructions %lu\n",
+               result->perf.cpu_ns / 1e6 / result->handshakes_ok,
+               result->perf.counters[PERF_CYCLES] / result->handshakes_ok,
+               result->perf.counters[PERF_INSTRUCTIONS] / result->handshakes_ok);
+    }
+    if (result->connects > 0) {
+        printf("  Client syscalls (%s): %lu (%.1f per connection), socket ops %lu (%.1f per connection)\n",
+               result->io_uring ? "io_uring" : "epoll", result->syscalls,
+               (double)result->syscalls / result->connects, result->io_ops,
+               (double)result->io_ops / result->connects);
+    }
+}
@@ -0,0 +1,73 @@
+#ifndef LOAD_CLIENT_H
+#define LOAD_CLIENT_H
+
+#include <stdint.h>
+#include <openssl/ssl.h>
+#include "../Common/metrics.h"
+#include "../Common/perf_counters.h"
+
+// open-loop 도착 분포
+typedef enum {
+    ARRIVAL_CONSTANT,
+    ARRIVAL_POISSON
+} arrival_t;
+
+// 부하 생성기 설정
+typedef struct {
+    SSL_CTX *ctx;          // 모든 연결이 공유하는 SSL 컨텍스트
+    const char *host;
+    int port;
+    const char *server_name;  // SNI (NULL: 보내지 않음)
+    int connections;       // closed-loop: 동시 핸드셰이크 수, open-loop: 최대 in-flight 수
+    int threads;           // 워커 스레드 수 (연결을 균등 분배)
+    double duration_s;     // 측정 시간
+    double rate;           // open-loop 목표 도착률 (handshakes/s)
+    arrival_t arrival;     // open-loop 도착 간격 분포
+    bool io_uring;         // 워커 소켓 I/O를 epoll 대신 io_uring으로 (링을 만들 수 없으면 epoll)
+} load_config_t;
+
+// 부하 생성 결과
+typedef struct {
+    uint64_t handshakes_ok;
+    uint64_t handshakes_failed;
+    uint64_t handshakes_in_window; // 측정 구간 안에 끝난 성공 (open-loop 처리율 기준)
+    double elapsed_s;
+    double handshakes_per_sec;
+    double target_rate;    // open-loop 목표 도착률 (closed-loop는 0)
+    uint64_t arrivals;     // open-loop 측정 구간에 예약된 도착 수
+    uint64_t timeouts;     // open-loop 종료 후 drain 시간 내 미완료 건수
+    uint64_t connects;     // 시작한 연결 수 (소켓 생성 기준)
+    // 워커 스레드가 커널에 들어간 횟수와 커널이 처리한 소켓 요청 (서버 엔진과 같은 기준)
+    //  epoll: socket/setsockopt/getsockopt, epoll_wait/ctl, connect/read/write/close
+    //  io_uring: socket/setsockopt, io_uring_enter, 동기 close (요청은 완료 엔트리 수)
+    uint64_t syscalls;
+    uint64_t io_ops;
+    bool io_uring;         // 모든 워커가 io_uring으로 동작
+    // closed-loop: SSL_connect 구간만의 레이턴시
+    // open-loop: 의도된 시작 시각 기준 레이턴시 (coordinated omission 보정)
+    stats_t latency_ms;
+    perf_values_t perf;    // 모든 워커의 SSL_connect 구간 카운터 합 (완료 여부 무관)
+} load_result_t;
+
+// rate sweep 설정 (knee 탐색)
+typedef struct {
+    double start;
+    double stop;
+    double step;
+    double slo_p99_ms;     // p99 SLO
+} sweep_config_t;
+
+// closed-loop 부하 실행: 핸드셰이크 완료 즉시 같은 슬롯에서 새 연결 시작
+int run_closed_loop(const load_config_t *config, load_result_t *result);
+
+// open-loop 부하 실행: 목표 도착률로 핸드셰이크 시작을 예약 (서버 포화와 무관)
+int run_open_loop(const load_config_t *config, load_result_t *result);
+
+// 도착률을 단계적으로 올리며 p99 SLO를 만족하는 최대 처리율(knee) 탐색
+// 반환값: knee 도착률 (만족하는 구간이 없으면 0)
+double run_rate_sweep(const load_config_t *config, const sweep_config_t *sweep);
+
+// 결과 출력
+void print_load_result(const load_config_t *config, const load_result_t *result);
+
+#endif // LOAD_CLIENT_H
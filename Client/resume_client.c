@@ -0,0 +1,257 @@
+#include "resume_client.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <openssl/err.h>
+#include "../Common/handshake_trace.h"
+
+#define RESUME_BUFFER_SIZE 4096
+#define REQUEST_MSG "Hello from client"
+
+// 연결 1회 측정값
+typedef struct {
+    bool ok;
+    bool resumed;
+    bool key_exchanged;
+    bool early_accepted;
+    double handshake_ms;
+    double response_ms;
+} conn_sample_t;
+
+static int connect_blocking(const char *host, int port) {
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, host, &addr.sin_addr) <= 0) {
+        fprintf(stderr, "Invalid address: %s\n", host);
+        return -1;
+    }
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// 연결 1회: (세션이 있으면 재개) 핸드셰이크 → 요청 → 응답, 다음 재개용 세션 반환
+static void one_connection(const resume_config_t *config, SSL_SESSION *session, bool psk_ke,
+                           conn_sample_t *sample, SSL_SESSION **next) {
+    bench_timer_t timer;
+    hs_trace_t trace;
+    char buf[RESUME_BUFFER_SIZE];
+
+    memset(sample, 0, sizeof(conn_sample_t));
+    *next = NULL;
+
+    int fd = connect_blocking(config->host, config->port);
+    if (fd < 0) {
+        return;
+    }
+    SSL *ssl = SSL_new(config->ctx);
+    if (!ssl || (config->server_name && !SSL_set_tlsext_host_name(ssl, config->server_name))) {
+        SSL_free(ssl);
+        close(fd);
+        return;
+    }
+    SSL_set_fd(ssl, fd);
+    if (psk_ke) {
+        SSL_set_options(ssl, SSL_OP_ALLOW_NO_DHE_KEX);
+    } else {
+        SSL_clear_options(ssl, SSL_OP_ALLOW_NO_DHE_KEX);
+    }
+    if (session) {
+        SSL_set_session(ssl, session);
+    }
+    hs_trace_attach(ssl, &trace);
+
+    // 0-RTT는 티켓이 early data를 허용할 때만 시도
+    bool early = config->early_data && session && SSL_SESSION_get_max_early_data(session) > 0;
+    int ret = 1;
+
+    start_timer(&timer);
+    if (early) {
+        size_t written = 0;
+        ret = SSL_write_early_data(ssl, REQUEST_MSG, strlen(REQUEST_MSG), &written);
+    }
+    if (ret == 1) {
+        ret = SSL_connect(ssl);
+    }
+    sample->handshake_ms = end_timer(&timer);
+    hs_trace_detach(ssl);
+
+    if (ret == 1) {
+        sample->early_accepted = early && SSL_get_early_data_status(ssl) == SSL_EARLY_DATA_ACCEPTED;
+
+        // early data가 거부되면 1-RTT로 다시 전송
+        if (sample->early_accepted || SSL_write(ssl, REQUEST_MSG, strlen(REQUEST_MSG)) > 0) {
+            // 응답 읽는 동안 NewSessionTicket도 처리됨
+            if (SSL_read(ssl, buf, sizeof(buf)) > 0) {
+                sample->response_ms = end_timer(&timer);
+                sample->ok = true;
+            }
+        }
+        sample->resumed = SSL_session_reused(ssl);
+        sample->key_exchanged = trace.server_share_len > 0;
+        *next = SSL_get1_session(ssl);
+        SSL_shutdown(ssl);
+    }
+
+    SSL_free(ssl);
+    close(fd);
+    ERR_clear_error();
+}
+
+// 같은 모드로 M회 재개, 매번 새로 받은 티켓으로 교체
+static int resume_pass(const resume_config_t *config, SSL_SESSION **session, bool psk_ke,
+                       resume_pass_t *pass) {
+    int n = config->resumptions;
+    double *hs_ms = malloc(n * sizeof(double));
+    double *resp_ms = malloc(n * sizeof(double));
+    int valid = 0;
+
+    memset(pass, 0, sizeof(resume_pass_t));
+    if (!hs_ms || !resp_ms) {
+        free(hs_ms);
+        free(resp_ms);
+        return -1;
+    }
+
+    for (int i = 0; i < n; i++) {
+        conn_sample_t sample;
+        SSL_SESSION *next;
+
+        one_connection(config, *session, psk_ke, &sample, &next);
+        pass->attempts++;
+        if (next) {
+            SSL_SESSION_free(*session);
+            *session = next;
+        }
+        if (!sample.ok) {
+            continue;
+        }
+        pass->resumed += sample.resumed;
+        pass->key_exchanged += sample.key_exchanged;
+        pass->early_accepted += sample.early_accepted;
+        hs_ms[valid] = sample.handshake_ms;
+        resp_ms[valid] = sample.response_ms;
+        valid++;
+    }
+
+    calculate_stats(hs_ms, valid, &pass->handshake_ms);
+    calculate_stats(resp_ms, valid, &pass->response_ms);
+    free(hs_ms);
+    free(resp_ms);
+    return valid > 0 ? 0 : -1;
+}
+
+int run_resumption(const resume_config_t *config, resume_result_t *result) {
+    int n = config->resumptions;
+    double *hs_ms = malloc(n * sizeof(double));
+    double *resp_ms = malloc(n * sizeof(double));
+    SSL_SESSION *session = NULL;
+    int rc = 0;
+
+    memset(result, 0, sizeof(resume_result_t));
+    if (!hs_ms || !resp_ms) {
+        free(hs_ms);
+        free(resp_ms);
+        return -1;
+    }
+
+    // 기준선: 전체 mTLS 핸드셰이크 M회 (마지막 세션을 재개에 사용)
+    for (int i = 0; i < n; i++) {
+        conn_sample_t sample;
+        SSL_SESSION *next;
+
+        one_connection(config, NULL, false, &sample, &next);
+        if (next) {
+            SSL_SESSION_free(session);
+            session = next;
+        }
+        if (sample.ok) {
+            hs_ms[result->full_runs] = sample.handshake_ms;
+            resp_ms[result->full_runs] = sample.response_ms;
+            result->full_runs++;
+        }
+    }
+    calculate_stats(hs_ms, result->full_runs, &result->full_handshake_ms);
+    calculate_stats(resp_ms, result->full_runs, &result->full_response_ms);
+    free(hs_ms);
+    free(resp_ms);
+
+    if (!session || result->full_runs == 0) {
+        fprintf(stderr, "Full handshake failed, no session to resume\n");
+        SSL_SESSION_free(session);
+        return -1;
+    }
+
+    if (config->psk_mode != PSK_MODE_KE && resume_pass(config, &session, false, &result->dhe) < 0) {
+        rc = -1;
+    }
+    if (config->psk_mode != PSK_MODE_DHE && resume_pass(config, &session, true, &result->ke) < 0) {
+        rc = -1;
+    }
+
+    SSL_SESSION_free(session);
+    return rc;
+}
+
+void resume_fill_reliability(const resume_config_t *config, const resume_result_t *result,
+                             reliability_metrics_t *reliability) {
+    const resume_pass_t *dhe = &result->dhe;
+    const resume_pass_t *ke = &result->ke;
+
+    if (dhe->attempts > 0) {
+        reliability->session_resumption_ok = dhe->resumed == dhe->attempts;
+        reliability->t_resumption_ms = dhe->handshake_ms.mean;
+    }
+    if (ke->attempts > 0) {
+        // 서버가 key_share 없이 응답한 경우만 psk_ke 성공
+        reliability->psk_ke_ok = ke->resumed == ke->attempts && ke->key_exchanged == 0;
+        reliability->t_resumption_psk_ke_ms = ke->handshake_ms.mean;
+    }
+    if (config->early_data) {
+        const resume_pass_t *pass = dhe->attempts > 0 ? dhe : ke;
+        reliability->zero_rtt_ok = pass->attempts > 0 && pass->early_accepted == pass->attempts;
+        reliability->t_0rtt_ms = pass->response_ms.mean;
+    }
+}
+
+static void print_pass(const char *name, const resume_pass_t *pass, const resume_result_t *result) {
+    if (pass->attempts == 0) {
+        return;
+    }
+    printf("  %s: resumed %d/%d, key_share %d, 0-RTT accepted %d\n",
+           name, pass->resumed, pass->attempts, pass->key_exchanged, pass->early_accepted);
+    printf("    handshake mean %.3f ms, p50 %.3f, p99 %.3f (speedup x%.2f)\n",
+           pass->handshake_ms.mean, pass->handshake_ms.p50, pass->handshake_ms.p99,
+           pass->handshake_ms.mean > 0 ? result->full_handshake_ms.mean / pass->handshake_ms.mean : 0.0);
+    printf("    response  mean %.3f ms, p50 %.3f, p99 %.3f (speedup x%.2f)\n",
+           pass->response_ms.mean, pass->response_ms.p50, pass->response_ms.p99,
+           pass->response_ms.mean > 0 ? result->full_response_ms.mean / pass->response_ms.mean : 0.0);
+}
+
+void print_resume_result(const resume_config_t *config, const resume_result_t *result) {
+    printf("\n========================================\n");
+    printf("Session resumption result%s\n", config->early_data ? " (0-RTT)" : "");
+    printf("========================================\n");
+    printf("  full mTLS: %d run(s)\n", result->full_runs);
+    printf("    handshake mean %.3f ms, p50 %.3f, p99 %.3f\n",
+           result->full_handshake_ms.mean, result->full_handshake_ms.p50, result->full_handshake_ms.p99);
+    printf("    response  mean %.3f ms, p50 %.3f, p99 %.3f\n",
+           result->full_response_ms.mean, result->full_response_ms.p50, result->full_response_ms.p99);
+    print_pass("psk_dhe_ke", &result->dhe, result);
+    print_pass("psk_ke", &result->ke, result);
+    if (result->ke.attempts > 0 && result->ke.key_exchanged > 0) {
+        printf("  note: server chose psk_dhe_ke for psk_ke offers (server needs --psk-ke, OpenSSL 3.3+)\n");
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef RESUME_CLIENT_H
+#define RESUME_CLIENT_H
+
+#include <stdbool.h>
+#include <openssl/ssl.h>
+#include "../Common/metrics.h"
+
+// 재개 시 제시하는 PSK 키 교환 모드
+typedef enum {
+    PSK_MODE_DHE,          // psk_dhe_ke: 재개에도 새 key_share (ML-KEM 포함)
+    PSK_MODE_KE,           // psk_ke 우선 제시: 서버가 선택하면 키 교환 없음
+    PSK_MODE_BOTH          // DHE, KE 순서로 각각 측정
+} psk_mode_t;
+
+// 세션 재개 벤치마크 설정
+typedef struct {
+    SSL_CTX *ctx;
+    const char *host;
+    int port;
+    const char *server_name;  // SNI (NULL: 보내지 않음)
+    int resumptions;       // 모드당 재개 횟수 M
+    psk_mode_t psk_mode;
+    bool early_data;       // 요청을 0-RTT early data로 전송
+} resume_config_t;
+
+// 모드 1개의 재개 결과
+typedef struct {
+    int attempts;
+    int resumed;           // SSL_session_reused
+    int key_exchanged;     // ServerHello에 key_share가 있었음 (psk_dhe_ke)
+    int early_accepted;    // early data 수락
+    stats_t handshake_ms;  // SSL_connect (early data 전송 포함)
+    stats_t response_ms;   // 연결 시작 → 응답 수신
+} resume_pass_t;
+
+// 전체 결과: 최초 전체 핸드셰이크 + 모드별 재개
+typedef struct {
+    int full_runs;
+    stats_t full_handshake_ms;
+    stats_t full_response_ms;
+    resume_pass_t dhe;
+    resume_pass_t ke;
+} resume_result_t;
+
+// 전체 핸드셰이크 1회로 세션을 얻은 뒤 모드별로 M회 재개 (0: 성공)
+int run_resumption(const resume_config_t *config, resume_result_t *result);
+
+// 결과를 reliability 메트릭으로 변환 (psk_dhe_ke 기준, 0-RTT는 응답 시간)
+void resume_fill_reliability(const resume_config_t *config, const resume_result_t *result,
+                             reliability_metrics_t *reliability);
+
+void print_resume_result(const resume_config_t *config, const resume_result_t *result);
+
+#endif // RESUME_CLIENT_H
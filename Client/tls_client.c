@@ -2,16 +2,30 @@
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <getopt.h>
+#include <signal.h>
 #include <arpa/inet.h>
 #include <sys/socket.h>
 #include <openssl/ssl.h>
 #include <openssl/err.h>
 #include <openssl/x509.h>
 #include "../Common/metrics.h"
+#include "../Common/tls_context.h"
+#include "../Common/handshake_trace.h"
+#include "../Common/count_bio.h"
+#include "../Common/perf_counters.h"
+#include "../Common/mem_track.h"
+#include "../Common/cert_comp.h"
+#include "../Common/tcp_stats.h"
+#include "../Common/pcap_writer.h"
+#include "load_client.h"
+#include "resume_client.h"
 
 #define DEFAULT_PORT 4433
 #define DEFAULT_HOST "127.0.0.1"
 #define BUFFER_SIZE 4096
+#define DEFAULT_MAX_INFLIGHT 1024
+#define DEFAULT_SLO_P99_MS 100.0
 
 typedef struct {
     const char *host;
@@ -21,72 +35,35 @@ typedef struct {
     const char *ca_file;
     const char *groups;
     const char *sigalgs;
+    int connections;       // 0: 단일 핸드셰이크, C: closed-loop 부하 모드
+    int threads;
+    bool io_uring;         // 부하 워커 소켓 I/O를 io_uring으로
+    double duration_s;
+    double rate;           // >0: open-loop 부하 모드
+    arrival_t arrival;
+    const char *sweep;     // open-loop rate sweep "start:stop:step"
+    double slo_p99_ms;
+    int resumptions;       // >0: 세션 재개 벤치마크 (모드당 M회)
+    psk_mode_t psk_mode;
+    bool early_data;
+    bool alloc_pool;       // OpenSSL 할당을 크기 클래스 풀로 처리
+    const char *cert_comp; // 인증서 압축 선호 목록 (RFC 8879)
+    bool nodelay;          // 단일 핸드셰이크 소켓에 TCP_NODELAY
+    const char *pcap_dir;  // 단일 핸드셰이크의 TLS 레코드를 pcap으로 기록
+    const char *server_name;  // SNI (다중 조합 서버에서 조합 선택)
 } client_config_t;
 
-// OpenSSL 오류 출력
-static void print_ssl_error(const char *msg) {
-    fprintf(stderr, "%s\n", msg);
-    ERR_print_errors_fp(stderr);
-}
-
-// SSL 컨텍스트 생성
+// SSL 컨텍스트 생성 (설정은 Common/tls_context.c에서 공유)
 static SSL_CTX* create_context(client_config_t *config) {
-    const SSL_METHOD *method;
-    SSL_CTX *ctx;
-
-    method = TLS_client_method();
-    ctx = SSL_CTX_new(method);
-    if (!ctx) {
-        print_ssl_error("Unable to create SSL context");
-        return NULL;
-    }
-
-    // TLS 1.3만 사용
-    SSL_CTX_set_min_proto_version(ctx, TLS1_3_VERSION);
-    SSL_CTX_set_max_proto_version(ctx, TLS1_3_VERSION);
-
-    // Cipher suite 고정: TLS_AES_128_GCM_SHA256
-    if (SSL_CTX_set_ciphersuites(ctx, "TLS_AES_128_GCM_SHA256") != 1) {
-        print_ssl_error("Failed to set cipher suite");
-        SSL_CTX_free(ctx);
-        return NULL;
-    }
-
-    // 그룹 설정 (KEM)
-    if (config->groups && SSL_CTX_set1_groups_list(ctx, config->groups) != 1) {
-        fprintf(stderr, "Warning: Failed to set groups: %s\n", config->groups);
-    }
-
-    // 서명 알고리즘 설정
-    if (config->sigalgs && SSL_CTX_set1_sigalgs_list(ctx, config->sigalgs) != 1) {
-        fprintf(stderr, "Warning: Failed to set sigalgs: %s\n", config->sigalgs);
-    }
-
-    // 클라이언트 인증서 로드 (mTLS)
-    if (SSL_CTX_use_certificate_file(ctx, config->cert_file, SSL_FILETYPE_PEM) <= 0) {
-        print_ssl_error("Failed to load client certificate");
-        SSL_CTX_free(ctx);
-        return NULL;
-    }
-
-    // 클라이언트 개인키 로드
-    if (SSL_CTX_use_PrivateKey_file(ctx, config->key_file, SSL_FILETYPE_PEM) <= 0) {
-        print_ssl_error("Failed to load client private key");
-        SSL_CTX_free(ctx);
-        return NULL;
-    }
-
-    // CA 인증서 로드 (서버 검증용)
-    if (SSL_CTX_load_verify_locations(ctx, config->ca_file, NULL) != 1) {
-        print_ssl_error("Failed to load CA certificate");
-        SSL_CTX_free(ctx);
-        return NULL;
-    }
-
-    // 서버 인증서 검증 활성화
-    SSL_CTX_set_verify(ctx, SSL_VERIFY_PEER, NULL);
-
-    return ctx;
+    tls_ctx_config_t ctx_config = {
+        .cert_file = config->cert_file,
+        .key_file = config->key_file,
+        .ca_file = config->ca_file,
+        .groups = config->groups,
+        .sigalgs = config->sigalgs,
+        .cert_comp = config->cert_comp
+    };
+    return create_client_context(&ctx_config);
 }
 
 // 서버에 연결
@@ -119,20 +96,62 @@ static int connect_to_server(const char *host, int port) {
     return sock;
 }
 
+// 핸드셰이크 바이트/메시지 크기 출력
+static void print_wire_sizes(const handshake_metrics_t *metrics) {
+    const message_bytes_t *mb = &metrics->traffic.msg_bytes;
+
+    printf("  Wire bytes: tx %lu, rx %lu (%u records)\n",
+           metrics->traffic.bytes_tx_handshake, metrics->traffic.bytes_rx_handshake,
+           metrics->traffic.records_count);
+    printf("    ClientHello %u (key_share %u), ServerHello %u (key_share %u)\n",
+           mb->client_hello, metrics->crypto.kem_keyshare_len,
+           mb->server_hello, metrics->crypto.kem_ciphertext_len);
+    if (metrics->crypto.hello_retry) {
+        printf("    HelloRetryRequest %u after first ClientHello %u (%u key_share(s)), extra round trip %.2f ms\n",
+               mb->hello_retry_request, mb->client_hello_initial, metrics->crypto.key_shares_offered,
+               metrics->t_hello_retry_ms);
+    }
+    printf("    Server Certificate %u (chain %u), CertificateVerify %u (sig %u), Finished %u\n",
+           mb->server_certificate, metrics->crypto.cert_chain_size_excluding_root,
+           mb->server_certificate_verify, metrics->crypto.sig_len, mb->server_finished);
+    if (metrics->crypto.cert_comp_alg != CERT_COMP_NONE) {
+        printf("    Server Certificate compressed with %s: %u -> %u bytes\n",
+               cert_comp_name((int)metrics->crypto.cert_comp_alg),
+               mb->server_certificate_uncompressed, mb->server_certificate);
+    }
+    printf("    Client Certificate %u, CertificateVerify %u, Finished %u\n",
+           mb->client_certificate, mb->client_certificate_verify, mb->client_finished);
+    printf("  TCP: segments out %u / in %u, retransmits %u, cwnd %u x %u B, rtt %u us\n",
+           metrics->traffic.segs_out, metrics->traffic.segs_in, metrics->traffic.retransmits,
+           metrics->traffic.snd_cwnd, metrics->traffic.snd_mss, metrics->traffic.tcp_rtt_us);
+    printf("    Server first flight ~%u B (round count depends on the server socket's cwnd, see server)\n",
+           metrics->traffic.server_flight_bytes);
+}
+
 // TLS 핸드셰이크 수행 및 메트릭 수집
-static bool perform_handshake(SSL *ssl, handshake_metrics_t *metrics) {
-    timer_t total_timer, ch_to_sh_timer;
+static bool perform_handshake(SSL *ssl, const wire_count_t *wire, handshake_metrics_t *metrics) {
+    bench_timer_t total_timer;
+    hs_trace_t trace;
+    perf_values_t perf_start, perf = {0};
+    tcp_sample_t tcp_start, tcp_end;
     
     init_handshake_metrics(metrics);
+    tcp_sample(SSL_get_fd(ssl), &tcp_start);
+    
+    // 메시지 콜백으로 단계별 시각 기록
+    hs_trace_attach(ssl, &trace);
     
     // 전체 핸드셰이크 타이머 시작
     start_timer(&total_timer);
-    start_timer(&ch_to_sh_timer);
+    perf_begin(&perf_start);
     
     // SSL 핸드셰이크
     int ret = SSL_connect(ssl);
+    perf_end(&perf_start, &perf);
+    tcp_sample(SSL_get_fd(ssl), &tcp_end);
     
-    metrics->t_clienthello_to_serverhello_ms = end_timer(&ch_to_sh_timer);
+    // trace는 스택 변수이므로 반환 전에 분리
+    hs_trace_detach(ssl);
     
     if (ret <= 0) {
         int err = SSL_get_error(ssl, ret);
@@ -145,6 +164,10 @@ static bool perform_handshake(SSL *ssl, handshake_metrics_t *metrics) {
     
     metrics->t_handshake_total_ms = end_timer(&total_timer);
     metrics->success = true;
+    hs_trace_fill_metrics(&trace, false, metrics);
+    count_bio_fill_traffic(wire, &metrics->traffic);
+    tcp_fill_traffic(&tcp_start, &tcp_end, false, &metrics->traffic);
+    perf_fill_resources(&perf, &metrics->resources);
     
     // 협상된 프로토콜 정보 출력
     const char *version = SSL_get_version(ssl);
@@ -165,27 +188,252 @@ static bool perform_handshake(SSL *ssl, handshake_metrics_t *metrics) {
     return true;
 }
 
-int main(int argc, char **argv) {
-    if (argc < 5) {
-        fprintf(stderr, "Usage: %s <cert> <key> <ca> <groups> [sigalgs] [host] [port]\n", argv[0]);
-        fprintf(stderr, "Example: %s client.crt client.key ca.crt x25519 ecdsa_secp256r1_sha256 127.0.0.1 4433\n", argv[0]);
-        return 1;
+static void print_usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [options] <cert> <key> <ca> <groups> [sigalgs] [host] [port]\n", prog);
+    fprintf(stderr, "Example: %s client.crt client.key ca.crt x25519 ecdsa_secp256r1_sha256 127.0.0.1 4433\n", prog);
+    fprintf(stderr, "\nLoad options (closed-loop):\n");
+    fprintf(stderr, "  -c, --connections C  동시 진행 핸드셰이크 수\n");
+    fprintf(stderr, "  -d, --duration S     측정 시간(초, 기본 10)\n");
+    fprintf(stderr, "  -t, --threads N      부하 워커 스레드 수(기본 1)\n");
+    fprintf(stderr, "      --io-uring       부하 워커 소켓 I/O를 epoll 대신 io_uring으로 (connect/멀티샷 recv/send/close)\n");
+    fprintf(stderr, "\nLoad options (open-loop):\n");
+    fprintf(stderr, "  -r, --rate R         목표 도착률(handshakes/s), -c는 최대 in-flight 수(기본 %d)\n",
+            DEFAULT_MAX_INFLIGHT);
+    fprintf(stderr, "      --arrival MODE   constant | poisson (기본 poisson)\n");
+    fprintf(stderr, "      --sweep A:B:S    도착률 A부터 B까지 S씩 증가시키며 knee 탐색\n");
+    fprintf(stderr, "      --slo-p99 MS     sweep의 p99 SLO(기본 %.0f ms)\n", DEFAULT_SLO_P99_MS);
+    fprintf(stderr, "\nResumption options:\n");
+    fprintf(stderr, "  -R, --resume M       전체 핸드셰이크로 세션을 얻은 뒤 모드당 M회 PSK 재개\n");
+    fprintf(stderr, "      --psk-mode MODE  dhe | ke | both (기본 both, ke는 서버 --psk-ke 필요)\n");
+    fprintf(stderr, "  -e, --early-data     재개 시 요청을 0-RTT early data로 전송 (서버 -e 필요)\n");
+    fprintf(stderr, "\nMemory options:\n");
+    fprintf(stderr, "      --alloc-pool     OpenSSL 할당을 스레드별 크기 클래스 풀로 처리 (할당기 churn 비교)\n");
+    fprintf(stderr, "\nCertificate compression (RFC 8879, OpenSSL 3.2+):\n");
+    fprintf(stderr, "      --cert-comp LIST 선호 순서 목록 zlib,brotli,zstd (기본: 비활성)\n");
+    fprintf(stderr, "\nTransport options:\n");
+    fprintf(stderr, "      --nodelay        단일 핸드셰이크 소켓에 TCP_NODELAY (Nagle 끔)\n");
+    fprintf(stderr, "      --pcap-dir DIR   단일 핸드셰이크를 DIR/<groups>_<sigalgs>_client.pcap에 이어 기록\n");
+    fprintf(stderr, "      --sni NAME       server_name 전송 (다중 조합 서버는 \"<group>.<sigalg>\"로 조합 선택)\n");
+}
+
+// 세션 재개 모드: 전체 핸드셰이크 대비 psk_dhe_ke/psk_ke/0-RTT 시간 비교
+static int run_resume_mode(SSL_CTX *ctx, client_config_t *config) {
+    resume_config_t resume = {
+        .ctx = ctx,
+        .host = config->host,
+        .port = config->port,
+        .server_name = config->server_name,
+        .resumptions = config->resumptions,
+        .psk_mode = config->psk_mode,
+        .early_data = config->early_data
+    };
+
+    printf("Session resumption: %d full + %d resumption(s) per mode%s\n",
+           resume.resumptions, resume.resumptions, resume.early_data ? ", 0-RTT request" : "");
+    fflush(stdout);
+
+    resume_result_t result;
+    int rc = run_resumption(&resume, &result);
+    print_resume_result(&resume, &result);
+    return rc == 0 ? 0 : 1;
+}
+
+// 부하 모드: SSL_CTX 1개를 재사용
+//  - closed-loop: C개의 핸드셰이크를 항상 유지
+//  - open-loop: 목표 도착률로 시작을 예약, 레이턴시는 예약 시각 기준
+static int run_load_mode(SSL_CTX *ctx, client_config_t *config) {
+    bool open_loop = config->rate > 0 || config->sweep;
+    load_config_t load = {
+        .ctx = ctx,
+        .host = config->host,
+        .port = config->port,
+        .server_name = config->server_name,
+        .connections = config->connections > 0 ? config->connections : DEFAULT_MAX_INFLIGHT,
+        .threads = config->threads,
+        .duration_s = config->duration_s,
+        .rate = config->rate,
+        .arrival = config->arrival,
+        .io_uring = config->io_uring
+    };
+
+    if (config->sweep) {
+        sweep_config_t sweep = { .slo_p99_ms = config->slo_p99_ms };
+        if (sscanf(config->sweep, "%lf:%lf:%lf", &sweep.start, &sweep.stop, &sweep.step) != 3 ||
+            sweep.start <= 0 || sweep.step <= 0 || sweep.stop < sweep.start) {
+            fprintf(stderr, "Invalid sweep: %s (expected start:stop:step)\n", config->sweep);
+            return 1;
+        }
+        printf("Open-loop rate sweep: %.1f..%.1f step %.1f, %.1f s per step, p99 SLO %.1f ms\n",
+               sweep.start, sweep.stop, sweep.step, load.duration_s, sweep.slo_p99_ms);
+        fflush(stdout);
+        return run_rate_sweep(&load, &sweep) > 0 ? 0 : 1;
+    }
+
+    if (open_loop) {
+        printf("Open-loop load: %.1f handshakes/s (%s), %d thread(s), %.1f s (%s)\n",
+               load.rate, load.arrival == ARRIVAL_POISSON ? "poisson" : "constant",
+               load.threads, load.duration_s, load.io_uring ? "io_uring" : "epoll");
+    } else {
+        printf("Closed-loop load: %d connection(s), %d thread(s), %.1f s (%s)\n",
+               load.connections, load.threads, load.duration_s, load.io_uring ? "io_uring" : "epoll");
     }
+    fflush(stdout);
+
+    load_result_t result;
+    int rc = open_loop ? run_open_loop(&load, &result) : run_closed_loop(&load, &result);
+    print_load_result(&load, &result);
 
+    return (rc == 0 && result.handshakes_ok > 0) ? 0 : 1;
+}
+
+int main(int argc, char **argv) {
     client_config_t config = {
-        .cert_file = argv[1],
-        .key_file = argv[2],
-        .ca_file = argv[3],
-        .groups = argv[4],
-        .sigalgs = argc > 5 ? argv[5] : NULL,
-        .host = argc > 6 ? argv[6] : DEFAULT_HOST,
-        .port = argc > 7 ? atoi(argv[7]) : DEFAULT_PORT
+        .host = DEFAULT_HOST,
+        .port = DEFAULT_PORT,
+        .connections = 0,
+        .threads = 1,
+        .io_uring = false,
+        .duration_s = 10.0,
+        .rate = 0.0,
+        .arrival = ARRIVAL_POISSON,
+        .sweep = NULL,
+        .slo_p99_ms = DEFAULT_SLO_P99_MS,
+        .resumptions = 0,
+        .psk_mode = PSK_MODE_BOTH,
+        .early_data = false,
+        .alloc_pool = false,
+        .cert_comp = NULL,
+        .nodelay = false,
+        .pcap_dir = NULL,
+        .server_name = NULL
     };
 
+    static const struct option long_options[] = {
+        {"connections", required_argument, NULL, 'c'},
+        {"duration", required_argument, NULL, 'd'},
+        {"threads", required_argument, NULL, 't'},
+        {"io-uring", no_argument, NULL, 'U'},
+        {"rate", required_argument, NULL, 'r'},
+        {"arrival", required_argument, NULL, 'A'},
+        {"sweep", required_argument, NULL, 'S'},
+        {"slo-p99", required_argument, NULL, 'P'},
+        {"resume", required_argument, NULL, 'R'},
+        {"psk-mode", required_argument, NULL, 'M'},
+        {"early-data", no_argument, NULL, 'e'},
+        {"alloc-pool", no_argument, NULL, 'H'},
+        {"cert-comp", required_argument, NULL, 'Z'},
+        {"nodelay", no_argument, NULL, 'N'},
+        {"pcap-dir", required_argument, NULL, 'C'},
+        {"sni", required_argument, NULL, 'I'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0}
+    };
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "c:d:t:r:R:eh", long_options, NULL)) != -1) {
+        switch (opt) {
+        case 'c':
+            config.connections = atoi(optarg);
+            break;
+        case 'd':
+            config.duration_s = atof(optarg);
+            break;
+        case 't':
+            config.threads = atoi(optarg);
+            break;
+        case 'r':
+            config.rate = atof(optarg);
+            break;
+        case 'A':
+            if (strcmp(optarg, "constant") == 0) {
+                config.arrival = ARRIVAL_CONSTANT;
+            } else if (strcmp(optarg, "poisson") == 0) {
+                config.arrival = ARRIVAL_POISSON;
+            } else {
+                fprintf(stderr, "Unknown arrival mode: %s\n", optarg);
+                return 1;
+            }
+            break;
+        case 'S':
+            config.sweep = optarg;
+            break;
+        case 'P':
+            config.slo_p99_ms = atof(optarg);
+            break;
+        case 'R':
+            config.resumptions = atoi(optarg);
+            break;
+        case 'M':
+            if (strcmp(optarg, "dhe") == 0) {
+                config.psk_mode = PSK_MODE_DHE;
+            } else if (strcmp(optarg, "ke") == 0) {
+                config.psk_mode = PSK_MODE_KE;
+            } else if (strcmp(optarg, "both") == 0) {
+                config.psk_mode = PSK_MODE_BOTH;
+            } else {
+                fprintf(stderr, "Unknown PSK mode: %s\n", optarg);
+                return 1;
+            }
+            break;
+        case 'e':
+            config.early_data = true;
+            break;
+        case 'U':
+            config.io_uring = true;
+            break;
+        case 'H':
+            config.alloc_pool = true;
+            break;
+        case 'Z':
+            config.cert_comp = optarg;
+            break;
+        case 'N':
+            config.nodelay = true;
+            break;
+        case 'C':
+            config.pcap_dir = optarg;
+            break;
+        case 'I':
+            config.server_name = optarg;
+            break;
+        default:
+            print_usage(argv[0]);
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    int nargs = argc - optind;
+    char **args = argv + optind;
+    if (nargs < 4) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    config.cert_file = args[0];
+    config.key_file = args[1];
+    config.ca_file = args[2];
+    config.groups = args[3];
+    config.sigalgs = nargs > 4 ? args[4] : NULL;
+    if (nargs > 5) {
+        config.host = args[5];
+    }
+    if (nargs > 6) {
+        config.port = atoi(args[6]);
+    }
+
+    // OpenSSL이 처음 할당하기 전에 메모리 훅 설치
+    mem_track_install(config.alloc_pool);
+
     printf("TLS 1.3 Client (mTLS enabled)\n");
     printf("Connecting to %s:%d\n", config.host, config.port);
+    if (config.server_name) {
+        printf("SNI: %s\n", config.server_name);
+    }
     printf("Groups: %s\n", config.groups);
     printf("Sigalgs: %s\n", config.sigalgs ? config.sigalgs : "(default)");
+    if (config.cert_comp) {
+        printf("Certificate compression: %s\n", config.cert_comp);
+    }
     printf("Cipher: TLS_AES_128_GCM_SHA256\n\n");
 
     // OpenSSL 초기화
@@ -198,23 +446,74 @@ int main(int argc, char **argv) {
         return 1;
     }
 
+    if (config.resumptions > 0) {
+        int rc = run_resume_mode(ctx, &config);
+        SSL_CTX_free(ctx);
+        return rc;
+    }
+
+    if (config.connections > 0 || config.rate > 0 || config.sweep) {
+        // 끊긴 연결에 쓰기 시 종료 방지
+        signal(SIGPIPE, SIG_IGN);
+        int rc = run_load_mode(ctx, &config);
+        SSL_CTX_free(ctx);
+        return rc;
+    }
+
     // 서버에 연결
     int sock = connect_to_server(config.host, config.port);
     if (sock < 0) {
         SSL_CTX_free(ctx);
         return 1;
     }
+    if (config.nodelay) {
+        tcp_set_nodelay(sock, true);
+    }
 
-    // SSL 객체 생성
+    // SSL 객체 생성 (소켓 바이트 카운팅 BIO 경유), 이 연결의 할당을 heap 계정에 기록
+    wire_count_t wire;
+    mem_account_t heap = {0};
+    mem_track_switch(&heap);
     SSL *ssl = SSL_new(ctx);
-    SSL_set_fd(ssl, sock);
+    if (!ssl || !count_bio_attach(ssl, sock, &wire) ||
+        (config.server_name && !SSL_set_tlsext_host_name(ssl, config.server_name))) {
+        print_ssl_error("Failed to create SSL");
+        SSL_free(ssl);
+        close(sock);
+        SSL_CTX_free(ctx);
+        return 1;
+    }
+
+    // 실행마다 같은 조합 파일 뒤에 이어 기록 (스크립트의 N회 반복을 한 파일로)
+    pcap_file_t *pcap = NULL;
+    if (config.pcap_dir) {
+        char path[512];
+        pcap_combo_path(path, sizeof(path), config.pcap_dir, config.groups, config.sigalgs, "client");
+        pcap = pcap_open(path, true);
+        wire.capture = pcap_flow_new(pcap, sock, false);
+    }
 
     // 핸드셰이크 수행
     handshake_metrics_t metrics;
-    if (perform_handshake(ssl, &metrics)) {
+    bool ok = perform_handshake(ssl, &wire, &metrics);
+    mem_fill_resources(&heap, &metrics.resources);
+    mem_track_switch(NULL);
+    if (ok) {
         printf("\n✅ Handshake successful!\n");
         printf("  Total time: %.2f ms\n", metrics.t_handshake_total_ms);
         printf("  ClientHello->ServerHello: %.2f ms\n", metrics.t_clienthello_to_serverhello_ms);
+        printf("  Server cert verify: %.2f ms\n", metrics.t_cert_verify_ms);
+        printf("  Client finished flight: %.2f ms\n", metrics.t_finished_flight_ms);
+        print_wire_sizes(&metrics);
+        printf("  CPU: %.3f ms (task-clock %.3f ms), cycles %lu, instructions %lu%s\n",
+               metrics.resources.cpu_time_ns / 1e6, metrics.resources.task_clock_ns / 1e6,
+               metrics.resources.cpu_cycles, metrics.resources.instructions,
+               perf_hw_available() ? "" : " (no hardware counters)");
+        if (mem_track_enabled()) {
+            printf("  Heap: peak %lu B, retained %lu B, %lu allocations\n",
+                   metrics.resources.peak_heap_bytes, metrics.resources.heap_retained_bytes,
+                   metrics.resources.heap_allocs);
+        }
 
         // 메시지 전송
         const char *msg = "Hello from client";
@@ -234,6 +533,8 @@ int main(int argc, char **argv) {
     // 정리
     SSL_shutdown(ssl);
     SSL_free(ssl);
+    pcap_flow_free(wire.capture);
+    pcap_close(pcap);
     close(sock);
     SSL_CTX_free(ctx);
     EVP_cleanup();
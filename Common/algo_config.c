@@ -0,0 +1,182 @@
+#include "algo_config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <openssl/ssl.h>
+#include <openssl/err.h>
+
+#define LINE_MAX_LEN 512
+
+const algo_group_t* algo_find_group(const algo_matrix_t *matrix, const char *name) {
+    for (int i = 0; i < matrix->group_count; i++) {
+        if (strcmp(matrix->groups[i].name, name) == 0) {
+            return &matrix->groups[i];
+        }
+    }
+    return NULL;
+}
+
+const algo_sigalg_t* algo_find_sigalg(const algo_matrix_t *matrix, const char *name) {
+    for (int i = 0; i < matrix->sigalg_count; i++) {
+        if (strcmp(matrix->sigalgs[i].name, name) == 0) {
+            return &matrix->sigalgs[i];
+        }
+    }
+    return NULL;
+}
+
+const algo_combo_t* algo_find_combo(const algo_matrix_t *matrix, const char *group_sigalg) {
+    const char *sep = strchr(group_sigalg, ':');
+    if (!sep) {
+        return NULL;
+    }
+    size_t group_len = (size_t)(sep - group_sigalg);
+    for (int i = 0; i < matrix->combo_count; i++) {
+        const algo_combo_t *c = &matrix->combos[i];
+        if (strlen(c->group) == group_len && strncmp(c->group, group_sigalg, group_len) == 0 &&
+            strcmp(c->sigalg, sep + 1) == 0) {
+            return c;
+        }
+    }
+    return NULL;
+}
+
+// 한 줄을 공백 기준으로 나눔 ('#' 뒤는 주석), 열 개수 반환
+static int split_fields(char *line, char **fields, int max) {
+    char *comment = strchr(line, '#');
+    if (comment) {
+        *comment = '\0';
+    }
+    int n = 0;
+    for (char *tok = strtok(line, " \t\r\n"); tok && n < max; tok = strtok(NULL, " \t\r\n")) {
+        fields[n++] = tok;
+    }
+    return n;
+}
+
+// 열이 버퍼보다 길면 실패
+static bool copy_field(char *dst, size_t len, const char *src) {
+    return (size_t)snprintf(dst, len, "%s", src) < len;
+}
+
+static bool parse_line(algo_matrix_t *m, char **f, int n, const char **error) {
+    if (strcmp(f[0], "group") == 0) {
+        if (n != 4) {
+            *error = "expected: group <name> <openssl> <kind>";
+            return false;
+        }
+        if (m->group_count >= ALGO_MAX_GROUPS || algo_find_group(m, f[1])) {
+            *error = "too many or duplicate groups";
+            return false;
+        }
+        algo_group_t *g = &m->groups[m->group_count];
+        if (!copy_field(g->name, sizeof(g->name), f[1]) ||
+            !copy_field(g->openssl, sizeof(g->openssl), f[2]) ||
+            !copy_field(g->kind, sizeof(g->kind), f[3])) {
+            *error = "field too long";
+            return false;
+        }
+        m->group_count++;
+        return true;
+    }
+    if (strcmp(f[0], "sigalg") == 0) {
+        if (n != 4) {
+            *error = "expected: sigalg <name> <openssl> <cert_key>";
+            return false;
+        }
+        if (m->sigalg_count >= ALGO_MAX_SIGALGS || algo_find_sigalg(m, f[1])) {
+            *error = "too many or duplicate sigalgs";
+            return false;
+        }
+        algo_sigalg_t *s = &m->sigalgs[m->sigalg_count];
+        if (!copy_field(s->name, sizeof(s->name), f[1]) ||
+            !copy_field(s->openssl, sizeof(s->openssl), f[2]) ||
+            !copy_field(s->cert_key, sizeof(s->cert_key), f[3])) {
+            *error = "field too long";
+            return false;
+        }
+        m->sigalg_count++;
+        return true;
+    }
+    if (strcmp(f[0], "combo") == 0) {
+        if (n != 3) {
+            *error = "expected: combo <group> <sigalg>";
+            return false;
+        }
+        const algo_group_t *g = algo_find_group(m, f[1]);
+        const algo_sigalg_t *s = algo_find_sigalg(m, f[2]);
+        if (!g || !s) {
+            *error = "combo refers to an undeclared group or sigalg";
+            return false;
+        }
+        if (m->combo_count >= ALGO_MAX_COMBOS) {
+            *error = "too many combos";
+            return false;
+        }
+        algo_combo_t *c = &m->combos[m->combo_count++];
+        snprintf(c->group, sizeof(c->group), "%s", g->name);
+        snprintf(c->sigalg, sizeof(c->sigalg), "%s", s->name);
+        snprintf(c->ossl_group, sizeof(c->ossl_group), "%s", g->openssl);
+        snprintf(c->ossl_sigalg, sizeof(c->ossl_sigalg), "%s", s->openssl);
+        return true;
+    }
+    *error = "unknown record (group, sigalg, combo)";
+    return false;
+}
+
+int algo_matrix_load(const char *path, algo_matrix_t *matrix) {
+    if (!path) {
+        path = getenv(ALGO_MATRIX_ENV);
+    }
+    if (!path || !*path) {
+        path = ALGO_MATRIX_DEFAULT;
+    }
+    memset(matrix, 0, sizeof(algo_matrix_t));
+
+    FILE *fp = fopen(path, "r");
+    if (!fp) {
+        fprintf(stderr, "Cannot open algorithm matrix %s (set %s or run from the repository root)\n",
+                path, ALGO_MATRIX_ENV);
+        return -1;
+    }
+
+    char line[LINE_MAX_LEN];
+    int line_no = 0;
+    while (fgets(line, sizeof(line), fp)) {
+        line_no++;
+        char *fields[8];
+        int n = split_fields(line, fields, 8);
+        const char *error = NULL;
+        if (n > 0 && !parse_line(matrix, fields, n, &error)) {
+            fprintf(stderr, "%s:%d: %s\n", path, line_no, error);
+            fclose(fp);
+            return -1;
+        }
+    }
+    fclose(fp);
+
+    if (matrix->combo_count == 0) {
+        fprintf(stderr, "%s: no combos\n", path);
+        return -1;
+    }
+    return 0;
+}
+
+bool algo_combo_probe(const algo_combo_t *combo, const char **reason) {
+    SSL_CTX *probe = SSL_CTX_new(TLS_method());
+    bool ok = false;
+    *reason = "SSL_CTX_new failed";
+    if (probe) {
+        if (SSL_CTX_set1_groups_list(probe, combo->ossl_group) != 1) {
+            *reason = "group not supported";
+        } else if (SSL_CTX_set1_sigalgs_list(probe, combo->ossl_sigalg) != 1) {
+            *reason = "sigalg not supported";
+        } else {
+            *reason = NULL;
+            ok = true;
+        }
+        SSL_CTX_free(probe);
+    }
+    ERR_clear_error();
+    return ok;
+}
@@ -1,57 +1,58 @@
 #ifndef ALGO_CONFIG_H
 #define ALGO_CONFIG_H
 
-// 알고리즘 조합 정의
+#include <stdbool.h>
+
+// 알고리즘 매트릭스 파일 (algorithms.conf, 셸/파이썬 스크립트와 공유)
+#define ALGO_MATRIX_DEFAULT "algorithms.conf"
+#define ALGO_MATRIX_ENV "ALGO_MATRIX"
+#define ALGO_NAME_MAX 48
+#define ALGO_MAX_GROUPS 32
+#define ALGO_MAX_SIGALGS 32
+#define ALGO_MAX_COMBOS 128
+
+// 키 교환 그룹
+typedef struct {
+    char name[ALGO_NAME_MAX];       // 결과/옵션에 쓰는 이름 ("mlkem768", "X25519MLKEM768")
+    char openssl[ALGO_NAME_MAX];    // SSL_CTX_set1_groups_list 이름
+    char kind[16];                  // classic, pqc, hybrid
+} algo_group_t;
+
+// 서명 알고리즘
+typedef struct {
+    char name[ALGO_NAME_MAX];       // "mldsa65", "ed25519"
+    char openssl[ALGO_NAME_MAX];    // SSL_CTX_set1_sigalgs_list 이름 ("dilithium3")
+    char cert_key[ALGO_NAME_MAX];   // 인증서 키 (generate_certs.sh: genpkey 알고리즘[:파라미터])
+} algo_sigalg_t;
+
+// 알고리즘 조합 (이름과 OpenSSL 명칭을 함께 보관)
 typedef struct {
-    const char *group;
-    const char *sigalg;
-    int ossl_group_nid;  // OpenSSL NID (runtime에서 조회)
-    int ossl_sigalg_nid; // OpenSSL NID (runtime에서 조회)
+    char group[ALGO_NAME_MAX];
+    char sigalg[ALGO_NAME_MAX];
+    char ossl_group[ALGO_NAME_MAX];
+    char ossl_sigalg[ALGO_NAME_MAX];
 } algo_combo_t;
 
-// 13가지 알고리즘 조합
-static const algo_combo_t ALGO_COMBOS[] = {
-    // Baseline (1)
-    {"x25519", "ecdsa_secp256r1_sha256", 0, 0},
-    
-    // KEM + ECDSA (3)
-    {"mlkem512", "ecdsa_secp256r1_sha256", 0, 0},
-    {"mlkem768", "ecdsa_secp256r1_sha256", 0, 0},
-    {"mlkem1024", "ecdsa_secp256r1_sha256", 0, 0},
-    
-    // KEM + ML-DSA (9)
-    {"mlkem512", "mldsa44", 0, 0},
-    {"mlkem512", "mldsa65", 0, 0},
-    {"mlkem512", "mldsa87", 0, 0},
-    
-    {"mlkem768", "mldsa44", 0, 0},
-    {"mlkem768", "mldsa65", 0, 0},
-    {"mlkem768", "mldsa87", 0, 0},
-    
-    {"mlkem1024", "mldsa44", 0, 0},
-    {"mlkem1024", "mldsa65", 0, 0},
-    {"mlkem1024", "mldsa87", 0, 0},
-};
-
-#define ALGO_COMBO_COUNT (sizeof(ALGO_COMBOS) / sizeof(algo_combo_t))
-
-// OpenSSL 3.x에서 사용되는 그룹명 매핑
-static const char* get_openssl_group_name(const char *group) {
-    if (strcmp(group, "x25519") == 0) return "x25519";
-    if (strcmp(group, "mlkem512") == 0) return "mlkem512";
-    if (strcmp(group, "mlkem768") == 0) return "mlkem768";
-    if (strcmp(group, "mlkem1024") == 0) return "mlkem1024";
-    return group;
-}
-
-// OpenSSL 3.x에서 사용되는 서명 알고리즘명 매핑
-static const char* get_openssl_sigalg_name(const char *sigalg) {
-    if (strcmp(sigalg, "ecdsa_secp256r1_sha256") == 0) return "ecdsa_secp256r1_sha256";
-    if (strcmp(sigalg, "mldsa44") == 0) return "dilithium2";
-    if (strcmp(sigalg, "mldsa65") == 0) return "dilithium3";
-    if (strcmp(sigalg, "mldsa87") == 0) return "dilithium5";
-    return sigalg;
-}
+typedef struct {
+    algo_group_t groups[ALGO_MAX_GROUPS];
+    int group_count;
+    algo_sigalg_t sigalgs[ALGO_MAX_SIGALGS];
+    int sigalg_count;
+    algo_combo_t combos[ALGO_MAX_COMBOS];
+    int combo_count;
+} algo_matrix_t;
 
-#endif // ALGO_CONFIG_H
+// 매트릭스 로드 (path NULL: $ALGO_MATRIX, 없으면 algorithms.conf), 실패 시 줄 번호와 함께 출력 후 -1
+int algo_matrix_load(const char *path, algo_matrix_t *matrix);
+
+// 이름으로 조회 (없으면 NULL)
+const algo_group_t* algo_find_group(const algo_matrix_t *matrix, const char *name);
+const algo_sigalg_t* algo_find_sigalg(const algo_matrix_t *matrix, const char *name);
 
+// "group:sigalg" 이름으로 조합 조회 (없으면 NULL)
+const algo_combo_t* algo_find_combo(const algo_matrix_t *matrix, const char *group_sigalg);
+
+// 조합이 현재 OpenSSL(프로바이더 포함)에서 설정 가능한지 확인, 불가하면 reason에 원인
+bool algo_combo_probe(const algo_combo_t *combo, const char **reason);
+
+#endif // ALGO_CONFIG_H
@@ -0,0 +1,232 @@
+#include "cert_comp.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <openssl/err.h>
+#include <openssl/x509_vfy.h>
+#ifdef CERT_COMP_SUPPORTED
+#include <openssl/comp.h>
+#endif
+
+#define COMP_HEADER_LEN (4 + 2 + 3 + 3)     // 핸드셰이크 헤더, algorithm, uncompressed_length, 벡터 길이
+
+static const char *const COMP_NAMES[] = {
+    [CERT_COMP_NONE] = "none",
+    [CERT_COMP_ZLIB] = "zlib",
+    [CERT_COMP_BROTLI] = "brotli",
+    [CERT_COMP_ZSTD] = "zstd",
+};
+
+const char* cert_comp_name(int alg) {
+    return alg >= CERT_COMP_NONE && alg <= CERT_COMP_ZSTD ? COMP_NAMES[alg] : "unknown";
+}
+
+int cert_comp_parse(const char *list, int *algs, int max) {
+    char buf[64];
+    int n = 0;
+
+    snprintf(buf, sizeof(buf), "%s", list);
+    for (char *save = NULL, *tok = strtok_r(buf, ",", &save); tok; tok = strtok_r(NULL, ",", &save)) {
+        int alg = -1;
+        for (int a = CERT_COMP_ZLIB; a <= CERT_COMP_ZSTD; a++) {
+            if (strcmp(tok, COMP_NAMES[a]) == 0) {
+                alg = a;
+            }
+        }
+        if (alg < 0 || n == max) {
+            return -1;
+        }
+        algs[n++] = alg;
+    }
+    return n;
+}
+
+#ifdef CERT_COMP_SUPPORTED
+// RFC 8879 압축은 레코드 간 상태가 없는 one-shot 방식
+static COMP_METHOD* comp_method(int alg) {
+    switch (alg) {
+    case CERT_COMP_ZLIB:   return COMP_zlib_oneshot();
+    case CERT_COMP_BROTLI: return COMP_brotli_oneshot();
+    case CERT_COMP_ZSTD:   return COMP_zstd_oneshot();
+    default:               return NULL;
+    }
+}
+#endif
+
+bool cert_comp_available(int alg) {
+#ifdef CERT_COMP_SUPPORTED
+    return comp_method(alg) != NULL;
+#else
+    (void)alg;
+    return false;
+#endif
+}
+
+bool cert_comp_configure(SSL_CTX *ctx, const char *list, bool precompress) {
+#ifdef CERT_COMP_SUPPORTED
+    // 3.2+는 빌드에 코덱이 있으면 기본 활성이므로 기준선은 명시적으로 끔 (실패 시에도 기준선 유지)
+    SSL_CTX_set_options(ctx, SSL_OP_NO_TX_CERTIFICATE_COMPRESSION |
+                             SSL_OP_NO_RX_CERTIFICATE_COMPRESSION);
+    if (!list) {
+        return true;
+    }
+
+    int algs[CERT_COMP_MAX_ALGS];
+    int n = cert_comp_parse(list, algs, CERT_COMP_MAX_ALGS);
+    if (n <= 0) {
+        fprintf(stderr, "Invalid certificate compression list: %s (zlib,brotli,zstd)\n", list);
+        return false;
+    }
+    for (int i = 0; i < n; i++) {
+        if (!cert_comp_available(algs[i])) {
+            fprintf(stderr, "Warning: OpenSSL built without %s, it will not be negotiated\n",
+                    cert_comp_name(algs[i]));
+        }
+    }
+
+    SSL_CTX_clear_options(ctx, SSL_OP_NO_TX_CERTIFICATE_COMPRESSION |
+                               SSL_OP_NO_RX_CERTIFICATE_COMPRESSION);
+    // 0: 선호 목록의 모든 알고리즘으로 미리 압축 (인증서 로드 이후 호출해야 함)
+    if (SSL_CTX_set1_cert_comp_preference(ctx, algs, n) != 1 ||
+        (precompress && SSL_CTX_compress_certs(ctx, 0) != 1)) {
+        fprintf(stderr, "Failed to set certificate compression: %s\n", list);
+        ERR_print_errors_fp(stderr);
+        SSL_CTX_set_options(ctx, SSL_OP_NO_TX_CERTIFICATE_COMPRESSION |
+                                 SSL_OP_NO_RX_CERTIFICATE_COMPRESSION);
+        return false;
+    }
+    return true;
+#else
+    (void)ctx;
+    (void)precompress;
+    if (list) {
+        fprintf(stderr, "Warning: certificate compression needs OpenSSL 3.2+ with zlib/brotli/zstd, ignoring '%s'\n",
+                list);
+        return false;
+    }
+    return true;
+#endif
+}
+
+#ifdef CERT_COMP_SUPPORTED
+static double now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static void put_u24(unsigned char *p, size_t v) {
+    p[0] = (unsigned char)(v >> 16);
+    p[1] = (unsigned char)(v >> 8);
+    p[2] = (unsigned char)v;
+}
+
+// 자동 체인 구성과 같이 신뢰 저장소로 체인을 만들어 Certificate 메시지 본문 작성
+static unsigned char* build_certificate_body(SSL_CTX *ctx, size_t *len) {
+    X509 *leaf = SSL_CTX_get0_certificate(ctx);
+    X509_STORE_CTX *store_ctx = X509_STORE_CTX_new();
+    STACK_OF(X509) *chain = NULL;
+    unsigned char *body = NULL;
+
+    if (!leaf || !store_ctx ||
+        X509_STORE_CTX_init(store_ctx, SSL_CTX_get_cert_store(ctx), leaf, NULL) != 1) {
+        goto done;
+    }
+    if (X509_verify_cert(store_ctx) == 1) {
+        chain = X509_STORE_CTX_get1_chain(store_ctx);
+    }
+
+    int n = chain ? sk_X509_num(chain) : 1;
+    size_t total = 1 + 3;                       // certificate_request_context, certificate_list 길이
+    for (int i = 0; i < n; i++) {
+        total += 3 + i2d_X509(chain ? sk_X509_value(chain, i) : leaf, NULL) + 2;
+    }
+    body = malloc(total);
+    if (!body) {
+        goto done;
+    }
+
+    unsigned char *p = body;
+    *p++ = 0;
+    put_u24(p, total - 4);
+    p += 3;
+    for (int i = 0; i < n; i++) {
+        X509 *cert = chain ? sk_X509_value(chain, i) : leaf;
+        put_u24(p, i2d_X509(cert, NULL));
+        p += 3;
+        i2d_X509(cert, &p);
+        *p++ = 0;                               // CertificateEntry extensions
+        *p++ = 0;
+    }
+    *len = total;
+
+done:
+    sk_X509_pop_free(chain, X509_free);
+    X509_STORE_CTX_free(store_ctx);
+    ERR_clear_error();
+    return body;
+}
+#endif
+
+bool cert_comp_bench(SSL_CTX *server_ctx, int alg, int iterations, cert_comp_result_t *result) {
+    memset(result, 0, sizeof(cert_comp_result_t));
+    result->alg = alg;
+#ifdef CERT_COMP_SUPPORTED
+    COMP_METHOD *method = comp_method(alg);
+    size_t body_len = 0;
+    unsigned char *body = method ? build_certificate_body(server_ctx, &body_len) : NULL;
+    size_t cap = body_len + body_len / 2 + 1024;
+    unsigned char *packed = body ? malloc(cap) : NULL;
+    unsigned char *unpacked = body ? malloc(body_len) : NULL;
+    COMP_CTX *cctx = packed && unpacked ? COMP_CTX_new(method) : NULL;
+    COMP_CTX *dctx = cctx ? COMP_CTX_new(method) : NULL;
+    bool ok = false;
+    int packed_len = -1;
+
+    if (!dctx || iterations <= 0) {
+        goto done;
+    }
+
+    // 워밍업 1회 후 반복 측정 (압축 결과는 매번 같으므로 마지막 값 사용)
+    for (int i = 0; i <= iterations; i++) {
+        double t0 = now_ms();
+        packed_len = COMP_compress_block(cctx, packed, (int)cap, body, (int)body_len);
+        if (i > 0) {
+            result->compress_ms += now_ms() - t0;
+        }
+        if (packed_len <= 0) {
+            goto done;
+        }
+    }
+    for (int i = 0; i <= iterations; i++) {
+        double t0 = now_ms();
+        int n = COMP_expand_block(dctx, unpacked, (int)body_len, packed, packed_len);
+        if (i > 0) {
+            result->decompress_ms += now_ms() - t0;
+        }
+        if (n != (int)body_len) {
+            goto done;
+        }
+    }
+
+    result->compress_ms /= iterations;
+    result->decompress_ms /= iterations;
+    result->uncompressed_len = (uint32_t)body_len + 4;
+    result->compressed_len = (uint32_t)packed_len + COMP_HEADER_LEN;
+    ok = memcmp(body, unpacked, body_len) == 0;
+
+done:
+    COMP_CTX_free(cctx);
+    COMP_CTX_free(dctx);
+    free(unpacked);
+    free(packed);
+    free(body);
+    ERR_clear_error();
+    return ok;
+#else
+    (void)server_ctx;
+    (void)iterations;
+    return false;
+#endif
+}
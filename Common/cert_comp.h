@@ -0,0 +1,44 @@
+#ifndef CERT_COMP_H
+#define CERT_COMP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <openssl/ssl.h>
+
+// RFC 8879 인증서 압축은 OpenSSL 3.2+ (zlib/brotli/zstd 중 하나 이상 포함 빌드)
+#if OPENSSL_VERSION_NUMBER >= 0x30200000L && !defined(OPENSSL_NO_COMP_ALG)
+#define CERT_COMP_SUPPORTED 1
+#endif
+
+// TLSEXT_comp_cert_* 값 (RFC 8879 CertificateCompressionAlgorithm)
+#define CERT_COMP_NONE 0
+#define CERT_COMP_ZLIB 1
+#define CERT_COMP_BROTLI 2
+#define CERT_COMP_ZSTD 3
+#define CERT_COMP_MAX_ALGS 3
+
+// 서버 체인 Certificate 메시지 압축/해제 측정 결과
+typedef struct {
+    int alg;
+    uint32_t uncompressed_len;      // 핸드셰이크 헤더 포함 Certificate 메시지
+    uint32_t compressed_len;        // 핸드셰이크 헤더 포함 CompressedCertificate 메시지
+    double compress_ms;
+    double decompress_ms;
+} cert_comp_result_t;
+
+// "zlib,brotli,zstd" → 선호 순서 배열, 반환값: 개수 (잘못된 이름이면 -1)
+int cert_comp_parse(const char *list, int *algs, int max);
+
+const char* cert_comp_name(int alg);
+
+// 현재 OpenSSL 빌드에서 알고리즘 사용 가능 여부
+bool cert_comp_available(int alg);
+
+// SSL_CTX 설정: list가 NULL이면 송수신 모두 비활성(비압축 기준선)
+// precompress: 서버 체인을 컨텍스트 생성 시 한 번 압축해 핸드셰이크마다 압축하지 않음
+bool cert_comp_configure(SSL_CTX *ctx, const char *list, bool precompress);
+
+// 서버 컨텍스트의 인증서 체인으로 Certificate 메시지를 만들어 압축/해제 시간 측정
+bool cert_comp_bench(SSL_CTX *server_ctx, int alg, int iterations, cert_comp_result_t *result);
+
+#endif // CERT_COMP_H
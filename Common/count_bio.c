@@ -0,0 +1,117 @@
+#include "count_bio.h"
+#include <string.h>
+#include <pthread.h>
+
+static BIO_METHOD *count_method = NULL;
+static pthread_once_t count_once = PTHREAD_ONCE_INIT;
+
+static int count_write(BIO *bio, const char *data, int len) {
+    BIO *next = BIO_next(bio);
+    wire_count_t *counts = BIO_get_data(bio);
+
+    BIO_clear_retry_flags(bio);
+    counts->write_calls++;
+    int ret = BIO_write(next, data, len);
+    if (ret > 0) {
+        counts->bytes_tx += ret;
+        counts->writes++;
+        if (counts->capture) {
+            pcap_flow_data(counts->capture, true, data, (size_t)ret);
+        }
+    }
+    BIO_copy_next_retry(bio);
+    return ret;
+}
+
+static int count_read(BIO *bio, char *data, int len) {
+    BIO *next = BIO_next(bio);
+    wire_count_t *counts = BIO_get_data(bio);
+
+    BIO_clear_retry_flags(bio);
+    counts->read_calls++;
+    int ret = BIO_read(next, data, len);
+    if (ret > 0) {
+        counts->bytes_rx += ret;
+        counts->reads++;
+        if (counts->capture) {
+            pcap_flow_data(counts->capture, false, data, (size_t)ret);
+        }
+    }
+    BIO_copy_next_retry(bio);
+    return ret;
+}
+
+static long count_ctrl(BIO *bio, int cmd, long num, void *ptr) {
+    BIO *next = BIO_next(bio);
+    if (!next) {
+        return 0;
+    }
+    return BIO_ctrl(next, cmd, num, ptr);
+}
+
+static int count_create(BIO *bio) {
+    BIO_set_init(bio, 1);
+    return 1;
+}
+
+static void init_count_method(void) {
+    count_method = BIO_meth_new(BIO_get_new_index() | BIO_TYPE_FILTER, "wire counter");
+    if (!count_method) {
+        return;
+    }
+    BIO_meth_set_write(count_method, count_write);
+    BIO_meth_set_read(count_method, count_read);
+    BIO_meth_set_ctrl(count_method, count_ctrl);
+    BIO_meth_set_create(count_method, count_create);
+}
+
+BIO* count_bio_new(wire_count_t *counts) {
+    pthread_once(&count_once, init_count_method);
+    if (!count_method) {
+        return NULL;
+    }
+
+    BIO *bio = BIO_new(count_method);
+    if (bio) {
+        memset(counts, 0, sizeof(wire_count_t));
+        BIO_set_data(bio, counts);
+    }
+    return bio;
+}
+
+bool count_bio_attach(SSL *ssl, int fd, wire_count_t *counts) {
+    BIO *sock = BIO_new_socket(fd, BIO_NOCLOSE);
+    BIO *filter = sock ? count_bio_new(counts) : NULL;
+    if (!filter) {
+        BIO_free(sock);
+        return false;
+    }
+
+    BIO_push(filter, sock);
+    SSL_set_bio(ssl, filter, filter);
+    return true;
+}
+
+bool count_bio_attach_pair(SSL *ssl, size_t size, wire_count_t *counts, BIO **net) {
+    BIO *inner = NULL;
+    *net = NULL;
+    if (!BIO_new_bio_pair(&inner, size, net, size)) {
+        return false;
+    }
+    BIO *filter = count_bio_new(counts);
+    if (!filter) {
+        BIO_free(inner);
+        BIO_free(*net);
+        *net = NULL;
+        return false;
+    }
+
+    BIO_push(filter, inner);
+    SSL_set_bio(ssl, filter, filter);
+    return true;
+}
+
+void count_bio_fill_traffic(const wire_count_t *counts, traffic_metrics_t *traffic) {
+    traffic->bytes_tx_handshake = counts->bytes_tx;
+    traffic->bytes_rx_handshake = counts->bytes_rx;
+}
@@ -0,0 +1,33 @@
+#ifndef COUNT_BIO_H
+#define COUNT_BIO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <openssl/ssl.h>
+#include "metrics.h"
+#include "pcap_writer.h"
+
+// 소켓에 실제로 오간 바이트 (TLS 레코드 헤더/암호화 오버헤드 포함)
+typedef struct {
+    uint64_t bytes_tx;
+    uint64_t bytes_rx;
+    uint32_t writes;
+    uint32_t reads;
+    uint32_t write_calls;   // 실패(EAGAIN 포함)까지 센 시도 수 (소켓 BIO면 read/write 시스템 콜 수)
+    uint32_t read_calls;
+    pcap_flow_t *capture;   // 오간 바이트를 pcap으로도 기록 (NULL: 안 함, attach 이후 설정)
+} wire_count_t;
+
+// counts에 누적하는 필터 BIO 생성 (다음 BIO로 그대로 전달)
+BIO* count_bio_new(wire_count_t *counts);
+
+// SSL_set_fd 대체: 소켓 BIO 위에 카운팅 필터를 얹어 SSL에 연결
+bool count_bio_attach(SSL *ssl, int fd, wire_count_t *counts);
+
+// 소켓 대신 BIO pair(각 방향 size 바이트) 연결: SSL 쪽에 카운팅 필터, *net은 네트워크 쪽 (호출자가 BIO_free)
+bool count_bio_attach_pair(SSL *ssl, size_t size, wire_count_t *counts, BIO **net);
+
+// 현재까지의 바이트를 핸드셰이크 트래픽으로 기록 (핸드셰이크 완료 직후 호출)
+void count_bio_fill_traffic(const wire_count_t *counts, traffic_metrics_t *traffic);
+
+#endif // COUNT_BIO_H
@@ -0,0 +1,380 @@
+#include "handshake_trace.h"
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <openssl/x509v3.h>
+
+#define EXT_KEY_SHARE 51
+#define HELLO_RANDOM_OFFSET (4 + 2)
+
+// HelloRetryRequest는 ServerHello와 같은 타입, random이 SHA-256("HelloRetryRequest") (RFC 8446 4.1.3)
+static const unsigned char HRR_RANDOM[32] = {
+    0xCF, 0x21, 0xAD, 0x74, 0xE5, 0x9A, 0x61, 0x11, 0xBE, 0x1D, 0x8C, 0x02, 0x1E, 0x65, 0xB8, 0x91,
+    0xC2, 0xA2, 0x11, 0x16, 0x7A, 0xBB, 0x8C, 0x5E, 0x07, 0x9E, 0x09, 0xE2, 0xC8, 0xA8, 0x33, 0x9C
+};
+
+static int trace_index = -1;
+static pthread_once_t trace_once = PTHREAD_ONCE_INIT;
+
+static void init_trace_index(void) {
+    trace_index = SSL_get_ex_new_index(0, "hs_trace", NULL, NULL, NULL);
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// TLS 핸드셰이크 메시지 타입 → 추적 슬롯
+static int msg_slot(unsigned char type) {
+    switch (type) {
+    case SSL3_MT_CLIENT_HELLO:         return HS_MSG_CLIENT_HELLO;
+    case SSL3_MT_SERVER_HELLO:         return HS_MSG_SERVER_HELLO;
+    case SSL3_MT_ENCRYPTED_EXTENSIONS: return HS_MSG_ENCRYPTED_EXTENSIONS;
+    case SSL3_MT_CERTIFICATE_REQUEST:  return HS_MSG_CERTIFICATE_REQUEST;
+    case SSL3_MT_CERTIFICATE:          return HS_MSG_CERTIFICATE;
+#ifdef SSL3_MT_COMPRESSED_CERTIFICATE
+    case SSL3_MT_COMPRESSED_CERTIFICATE: return HS_MSG_CERTIFICATE;
+#endif
+    case SSL3_MT_CERTIFICATE_VERIFY:   return HS_MSG_CERTIFICATE_VERIFY;
+    case SSL3_MT_FINISHED:             return HS_MSG_FINISHED;
+    default:                           return -1;
+    }
+}
+
+static uint32_t get_u16(const unsigned char *p) {
+    return ((uint32_t)p[0] << 8) | p[1];
+}
+
+static uint32_t get_u24(const unsigned char *p) {
+    return ((uint32_t)p[0] << 16) | ((uint32_t)p[1] << 8) | p[2];
+}
+
+// Hello 메시지의 extensions 블록 위치 (없으면 NULL)
+static const unsigned char* hello_extensions(const unsigned char *msg, size_t len,
+                                             bool client_hello, size_t *ext_len) {
+    size_t off = HELLO_RANDOM_OFFSET + 32;      // 헤더, legacy_version, random
+    if (off + 1 > len) return NULL;
+    off += 1 + msg[off];                        // legacy_session_id
+    if (client_hello) {
+        if (off + 2 > len) return NULL;
+        off += 2 + get_u16(msg + off);          // cipher_suites
+        if (off + 1 > len) return NULL;
+        off += 1 + msg[off];                    // legacy_compression_methods
+    } else {
+        off += 2 + 1;                           // cipher_suite, compression_method
+    }
+    if (off + 2 > len) return NULL;
+    *ext_len = get_u16(msg + off);
+    off += 2;
+    if (off + *ext_len > len) return NULL;
+    return msg + off;
+}
+
+// key_share 확장의 key_exchange 바이트 합계와 엔트리 수 (HRR처럼 그룹만 있으면 0)
+static uint32_t key_share_len(const unsigned char *msg, size_t len, bool client_hello, uint32_t *entries) {
+    size_t ext_len;
+    const unsigned char *ext = hello_extensions(msg, len, client_hello, &ext_len);
+    if (!ext) return 0;
+
+    for (size_t off = 0; off + 4 <= ext_len;) {
+        uint32_t type = get_u16(ext + off);
+        uint32_t data_len = get_u16(ext + off + 2);
+        const unsigned char *data = ext + off + 4;
+        off += 4 + data_len;
+        if (off > ext_len) break;
+        if (type != EXT_KEY_SHARE) continue;
+
+        // ClientHello: client_shares<2> { group<2> key_exchange<2> }*, ServerHello: 엔트리 1개
+        size_t pos = client_hello ? 2 : 0;
+        uint32_t total = 0;
+        while (pos + 4 <= data_len) {
+            uint32_t kex_len = get_u16(data + pos + 2);
+            total += kex_len;
+            pos += 4 + kex_len;
+            if (entries) (*entries)++;
+        }
+        return total;
+    }
+    return 0;
+}
+
+// Certificate 메시지의 DER 인증서 크기 합계, 개수, 마지막 인증서 크기
+static uint32_t certificate_chain_len(const unsigned char *msg, size_t len,
+                                      uint32_t *count, uint32_t *last_len) {
+    size_t off = 4;
+    if (off + 1 > len) return 0;
+    off += 1 + msg[off];                        // certificate_request_context
+    if (off + 3 > len) return 0;
+    size_t end = off + 3 + get_u24(msg + off);
+    off += 3;
+    if (end > len) return 0;
+
+    uint32_t total = 0;
+    while (off + 3 <= end) {
+        uint32_t cert_len = get_u24(msg + off);
+        off += 3 + cert_len;
+        if (off + 2 > end) break;
+        total += cert_len;
+        (*count)++;
+        *last_len = cert_len;
+        off += 2 + get_u16(msg + off);          // CertificateEntry extensions
+    }
+    return total;
+}
+
+// CompressedCertificate: algorithm<2> uncompressed_length<3> compressed_certificate_message<1..2^24-1>
+static bool compressed_certificate(const unsigned char *msg, size_t len,
+                                   uint32_t *alg, uint32_t *uncompressed_len) {
+    if (msg[0] == SSL3_MT_CERTIFICATE || len < 4 + 2 + 3) return false;
+    *alg = get_u16(msg + 4);
+    *uncompressed_len = 4 + get_u24(msg + 4 + 2);
+    return true;
+}
+
+// CertificateVerify 서명 길이
+static uint32_t certificate_verify_sig_len(const unsigned char *msg, size_t len) {
+    if (len < 4 + 2 + 2) return 0;
+    return get_u16(msg + 4 + 2);
+}
+
+// 서버가 보낸 메시지인지 (클라이언트는 수신, 서버는 송신)
+static bool from_server(const SSL *ssl, int write_p) {
+    return SSL_is_server(ssl) ? write_p != 0 : write_p == 0;
+}
+
+// 메시지 내용에서 크기 정보 추출
+static void parse_message(hs_trace_t *trace, int slot, int write_p, SSL *ssl,
+                          const unsigned char *msg, size_t len) {
+    bool server_msg = from_server(ssl, write_p);
+
+    switch (slot) {
+    case HS_MSG_CLIENT_HELLO: {
+        uint32_t entries = 0;
+        trace->client_share_len = key_share_len(msg, len, true, &entries);
+        if (!trace->hello_retry) {
+            trace->client_share_count = entries;
+        }
+        break;
+    }
+    case HS_MSG_SERVER_HELLO:
+        trace->server_share_len = key_share_len(msg, len, false, NULL);
+        break;
+    case HS_MSG_CERTIFICATE: {
+        uint32_t alg, uncompressed_len;
+        if (compressed_certificate(msg, len, &alg, &uncompressed_len)) {
+            // 체인 크기는 압축 해제된 체인에서 완료 시점에 계산
+            if (server_msg) {
+                trace->cert_comp_alg = alg;
+                trace->server_cert_uncompressed = uncompressed_len;
+            } else {
+                trace->client_cert_uncompressed = uncompressed_len;
+            }
+        } else if (server_msg) {
+            trace->server_cert_count = 0;
+            trace->server_chain_len = certificate_chain_len(msg, len, &trace->server_cert_count,
+                                                            &trace->server_last_cert_len);
+        }
+        break;
+    }
+    case HS_MSG_CERTIFICATE_VERIFY:
+        if (server_msg) trace->server_sig_len = certificate_verify_sig_len(msg, len);
+        break;
+    default:
+        break;
+    }
+}
+
+// 검증된 체인의 루트 크기 (자체 서명 인증서만, 이 저장소는 클라이언트/서버가 같은 CA 사용)
+static uint32_t verified_root_len(const SSL *ssl) {
+    STACK_OF(X509) *chain = SSL_get0_verified_chain(ssl);
+    int n = chain ? sk_X509_num(chain) : 0;
+    if (n == 0) {
+        return 0;
+    }
+    X509 *root = sk_X509_value(chain, n - 1);
+    if ((X509_get_extension_flags(root) & EXFLAG_SS) == 0) {
+        return 0;
+    }
+    int len = i2d_X509(root, NULL);
+    return len > 0 ? (uint32_t)len : 0;
+}
+
+// 압축된 서버 Certificate의 체인 크기 (클라이언트만 수신한 체인을 알 수 있음)
+static void peer_chain_len(const SSL *ssl, hs_trace_t *trace) {
+    STACK_OF(X509) *chain = SSL_get_peer_cert_chain(ssl);
+    int n = chain ? sk_X509_num(chain) : 0;
+    trace->server_chain_len = 0;
+    trace->server_cert_count = 0;
+    for (int i = 0; i < n; i++) {
+        int len = i2d_X509(sk_X509_value(chain, i), NULL);
+        if (len > 0) {
+            trace->server_chain_len += (uint32_t)len;
+            trace->server_cert_count++;
+            trace->server_last_cert_len = (uint32_t)len;
+        }
+    }
+}
+
+static bool is_hello_retry(const unsigned char *msg, size_t len) {
+    return msg[0] == SSL3_MT_SERVER_HELLO && len >= HELLO_RANDOM_OFFSET + sizeof(HRR_RANDOM) &&
+           memcmp(msg + HELLO_RANDOM_OFFSET, HRR_RANDOM, sizeof(HRR_RANDOM)) == 0;
+}
+
+// HRR: 첫 ClientHello를 따로 보관하고 CH 슬롯을 비워 두 번째 ClientHello가 채우게 함
+static void record_hello_retry(hs_trace_t *trace, size_t len) {
+    uint64_t sent = trace->sent_ns[HS_MSG_CLIENT_HELLO];
+    trace->hello_retry = true;
+    trace->hello_retry_ns = now_ns();
+    trace->hello_retry_bytes += len;
+    trace->first_hello_ns = sent ? sent : trace->recv_ns[HS_MSG_CLIENT_HELLO];
+    trace->first_hello_bytes =
+        trace->sent_bytes[HS_MSG_CLIENT_HELLO] + trace->recv_bytes[HS_MSG_CLIENT_HELLO];
+    trace->sent_ns[HS_MSG_CLIENT_HELLO] = trace->recv_ns[HS_MSG_CLIENT_HELLO] = 0;
+    trace->sent_bytes[HS_MSG_CLIENT_HELLO] = trace->recv_bytes[HS_MSG_CLIENT_HELLO] = 0;
+}
+
+// 메시지 콜백: 핸드셰이크 메시지마다 첫 관측 시각만 기록
+static void trace_msg_cb(int write_p, int version, int content_type,
+                         const void *buf, size_t len, SSL *ssl, void *arg) {
+    (void)version;
+    (void)arg;
+
+    if ((content_type != SSL3_RT_HANDSHAKE && content_type != SSL3_RT_HEADER) || len == 0) {
+        return;
+    }
+    hs_trace_t *trace = SSL_get_ex_data(ssl, trace_index);
+    if (!trace) {
+        return;
+    }
+
+    // 레코드 헤더: 핸드셰이크 완료 전까지 양방향 레코드 수
+    if (content_type == SSL3_RT_HEADER) {
+        if (trace->done_ns == 0) {
+            trace->records++;
+        }
+        return;
+    }
+
+    int slot = msg_slot(((const unsigned char*)buf)[0]);
+    if (slot < 0) {
+        return;
+    }
+    if (slot == HS_MSG_SERVER_HELLO && is_hello_retry(buf, len)) {
+        record_hello_retry(trace, len);
+        return;
+    }
+    uint64_t *ts = write_p ? &trace->sent_ns[slot] : &trace->recv_ns[slot];
+    if (*ts == 0) {
+        *ts = now_ns();
+    }
+    // HRR 이후 두 번째 Hello가 실제 key_share이므로 매번 갱신
+    parse_message(trace, slot, write_p, ssl, buf, len);
+    uint32_t *bytes = write_p ? &trace->sent_bytes[slot] : &trace->recv_bytes[slot];
+    *bytes += len;
+}
+
+// 정보 콜백: 핸드셰이크 시작/완료 시각
+static void trace_info_cb(const SSL *ssl, int where, int ret) {
+    (void)ret;
+
+    if ((where & (SSL_CB_HANDSHAKE_START | SSL_CB_HANDSHAKE_DONE)) == 0) {
+        return;
+    }
+    hs_trace_t *trace = SSL_get_ex_data(ssl, trace_index);
+    if (!trace) {
+        return;
+    }
+
+    if ((where & SSL_CB_HANDSHAKE_START) && trace->start_ns == 0) {
+        trace->start_ns = now_ns();
+    }
+    if ((where & SSL_CB_HANDSHAKE_DONE) && trace->done_ns == 0) {
+        trace->done_ns = now_ns();
+        trace->root_len = verified_root_len(ssl);
+        if (trace->cert_comp_alg != 0 && !SSL_is_server(ssl)) {
+            peer_chain_len(ssl, trace);
+        }
+    }
+}
+
+void hs_trace_install(SSL_CTX *ctx) {
+    pthread_once(&trace_once, init_trace_index);
+    SSL_CTX_set_msg_callback(ctx, trace_msg_cb);
+    SSL_CTX_set_info_callback(ctx, trace_info_cb);
+}
+
+void hs_trace_attach(SSL *ssl, hs_trace_t *trace) {
+    pthread_once(&trace_once, init_trace_index);
+    memset(trace, 0, sizeof(hs_trace_t));
+    SSL_set_ex_data(ssl, trace_index, trace);
+}
+
+void hs_trace_detach(SSL *ssl) {
+    SSL_set_ex_data(ssl, trace_index, NULL);
+}
+
+// 두 시각 차이 (ms), 어느 한쪽이 미관측이면 0
+static double span_ms(uint64_t from, uint64_t to) {
+    if (from == 0 || to == 0 || to < from) {
+        return 0.0;
+    }
+    return (to - from) / 1000000.0;
+}
+
+void hs_trace_fill_metrics(const hs_trace_t *trace, bool is_server, handshake_metrics_t *metrics) {
+    if (is_server) {
+        metrics->t_clienthello_to_serverhello_ms =
+            span_ms(trace->recv_ns[HS_MSG_CLIENT_HELLO], trace->sent_ns[HS_MSG_SERVER_HELLO]);
+        metrics->t_finished_flight_ms =
+            span_ms(trace->sent_ns[HS_MSG_SERVER_HELLO], trace->sent_ns[HS_MSG_FINISHED]);
+    } else {
+        metrics->t_clienthello_to_serverhello_ms =
+            span_ms(trace->sent_ns[HS_MSG_CLIENT_HELLO], trace->recv_ns[HS_MSG_SERVER_HELLO]);
+        metrics->t_finished_flight_ms =
+            span_ms(trace->recv_ns[HS_MSG_FINISHED], trace->sent_ns[HS_MSG_FINISHED]);
+    }
+
+    metrics->t_cert_verify_ms =
+        span_ms(trace->recv_ns[HS_MSG_CERTIFICATE], trace->recv_ns[HS_MSG_FINISHED]);
+    metrics->t_hello_retry_ms = trace->hello_retry ?
+        span_ms(trace->first_hello_ns, is_server ? trace->recv_ns[HS_MSG_CLIENT_HELLO]
+                                                 : trace->sent_ns[HS_MSG_CLIENT_HELLO]) : 0.0;
+
+    // 메시지별 크기: 서버 메시지는 서버 기준 송신, 클라이언트 기준 수신
+    const uint32_t *server_side = is_server ? trace->sent_bytes : trace->recv_bytes;
+    const uint32_t *client_side = is_server ? trace->recv_bytes : trace->sent_bytes;
+    message_bytes_t *mb = &metrics->traffic.msg_bytes;
+
+    mb->client_hello = client_side[HS_MSG_CLIENT_HELLO];
+    mb->server_hello = server_side[HS_MSG_SERVER_HELLO];
+    mb->encrypted_extensions = server_side[HS_MSG_ENCRYPTED_EXTENSIONS];
+    mb->certificate_request = server_side[HS_MSG_CERTIFICATE_REQUEST];
+    mb->server_certificate = server_side[HS_MSG_CERTIFICATE];
+    mb->server_certificate_verify = server_side[HS_MSG_CERTIFICATE_VERIFY];
+    mb->server_finished = server_side[HS_MSG_FINISHED];
+    mb->client_certificate = client_side[HS_MSG_CERTIFICATE];
+    mb->client_certificate_verify = client_side[HS_MSG_CERTIFICATE_VERIFY];
+    mb->client_finished = client_side[HS_MSG_FINISHED];
+    mb->server_certificate_uncompressed =
+        trace->server_cert_uncompressed ? trace->server_cert_uncompressed : mb->server_certificate;
+    mb->client_certificate_uncompressed =
+        trace->client_cert_uncompressed ? trace->client_cert_uncompressed : mb->client_certificate;
+    mb->client_hello_initial = trace->first_hello_bytes;
+    mb->hello_retry_request = trace->hello_retry_bytes;
+    metrics->traffic.records_count = trace->records;
+
+    metrics->crypto.kem_keyshare_len = trace->client_share_len;
+    metrics->crypto.kem_ciphertext_len = trace->server_share_len;
+    metrics->crypto.sig_len = trace->server_sig_len;
+    // 자동 체인 구성으로 루트까지 전송했으면 마지막 인증서가 루트 (크기로 판별)
+    bool root_on_wire = trace->server_cert_count > 1 && trace->root_len == trace->server_last_cert_len;
+    metrics->crypto.cert_chain_size_excluding_root =
+        root_on_wire ? trace->server_chain_len - trace->root_len : trace->server_chain_len;
+    metrics->crypto.cert_chain_size_including_root =
+        root_on_wire ? trace->server_chain_len : trace->server_chain_len + trace->root_len;
+    metrics->crypto.cert_comp_alg = trace->cert_comp_alg;
+    metrics->crypto.key_shares_offered = trace->client_share_count;
+    metrics->crypto.hello_retry = trace->hello_retry;
+}
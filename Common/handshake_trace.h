@@ -0,0 +1,67 @@
+#ifndef HANDSHAKE_TRACE_H
+#define HANDSHAKE_TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <openssl/ssl.h>
+#include "metrics.h"
+
+// 추적하는 TLS 1.3 핸드셰이크 메시지
+typedef enum {
+    HS_MSG_CLIENT_HELLO,
+    HS_MSG_SERVER_HELLO,
+    HS_MSG_ENCRYPTED_EXTENSIONS,
+    HS_MSG_CERTIFICATE_REQUEST,
+    HS_MSG_CERTIFICATE,
+    HS_MSG_CERTIFICATE_VERIFY,
+    HS_MSG_FINISHED,
+    HS_MSG_COUNT
+} hs_msg_t;
+
+// 연결별 핸드셰이크 타임스탬프 (CLOCK_MONOTONIC ns, 0 = 미관측)와 메시지 크기
+typedef struct {
+    uint64_t start_ns;
+    uint64_t done_ns;
+    uint64_t sent_ns[HS_MSG_COUNT];
+    uint64_t recv_ns[HS_MSG_COUNT];
+    uint32_t sent_bytes[HS_MSG_COUNT];
+    uint32_t recv_bytes[HS_MSG_COUNT];
+    uint32_t records;               // 핸드셰이크 완료까지 송수신한 레코드 수
+    uint32_t client_share_len;      // ClientHello key_share key_exchange 합계
+    uint32_t server_share_len;      // ServerHello key_share key_exchange
+    uint32_t server_sig_len;        // 서버 CertificateVerify 서명 길이
+    uint32_t server_chain_len;      // 서버 Certificate의 DER 인증서 합계
+    uint32_t server_cert_count;
+    uint32_t server_last_cert_len;
+    uint32_t root_len;              // 검증된 체인의 루트 DER 크기
+    uint32_t cert_comp_alg;         // 서버 CompressedCertificate 알고리즘 (0 = 비압축)
+    uint32_t server_cert_uncompressed;  // CompressedCertificate의 uncompressed_length + 헤더
+    uint32_t client_cert_uncompressed;
+    bool hello_retry;               // HelloRetryRequest 관측 (CH 슬롯은 두 번째 ClientHello 기준)
+    uint64_t first_hello_ns;        // 첫 ClientHello 송신/수신 시각
+    uint64_t hello_retry_ns;        // HRR 송신/수신 시각
+    uint32_t first_hello_bytes;
+    uint32_t hello_retry_bytes;
+    uint32_t client_share_count;    // 첫 ClientHello key_share 엔트리 수
+} hs_trace_t;
+
+// 컨텍스트에 메시지/정보 콜백 설치 (trace가 연결되지 않은 SSL은 즉시 반환)
+void hs_trace_install(SSL_CTX *ctx);
+
+// 연결에 trace 연결 (초기화 포함)
+void hs_trace_attach(SSL *ssl, hs_trace_t *trace);
+
+// trace 분리 (trace 수명이 SSL보다 짧을 때)
+void hs_trace_detach(SSL *ssl);
+
+// 단계별 시간 계산
+//  - t_clienthello_to_serverhello_ms: 클라이언트 CH 송신→SH 수신 / 서버 CH 수신→SH 송신 (키 교환)
+//  - t_cert_verify_ms: 상대 Certificate 수신→상대 Finished 수신 (체인 검증 + CertificateVerify 검증)
+//  - t_finished_flight_ms: 클라이언트 서버 Finished 수신→자신의 Finished 송신 /
+//                          서버 SH 송신→Finished 송신 (자신의 Certificate/CertificateVerify 서명 포함)
+//  - t_hello_retry_ms: HRR이 있으면 첫 ClientHello→두 번째 ClientHello (추가 왕복 + 키 재생성)
+//    이때 t_clienthello_to_serverhello_ms는 두 번째 ClientHello 기준
+// 메시지별 크기, 레코드 수, key_share/서명/인증서 체인 크기도 함께 채움
+void hs_trace_fill_metrics(const hs_trace_t *trace, bool is_server, handshake_metrics_t *metrics);
+
+#endif // HANDSHAKE_TRACE_H
@@ -0,0 +1,154 @@
+#include "histogram.h"
+#include <string.h>
+#include <math.h>
+
+// 값 → 버킷 인덱스 (0: 0/음수/하한 미만)
+static int bucket_index(double value) {
+    if (!(value > 0.0)) {
+        return 0;
+    }
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    int exp = (int)((bits >> 52) & 0x7ff) - 1023;
+    if (exp < HIST_MIN_EXP) {
+        return 0;
+    }
+    if (exp >= HIST_MAX_EXP) {
+        return HIST_BUCKETS - 1;
+    }
+    int sub = (int)((bits >> (52 - HIST_SUB_BITS)) & (HIST_SUB_BUCKETS - 1));
+    return 1 + (exp - HIST_MIN_EXP) * HIST_SUB_BUCKETS + sub;
+}
+
+// 버킷 [lower, upper)
+static void bucket_bounds(int index, double *lower, double *upper) {
+    if (index == 0) {
+        *lower = 0.0;
+        *upper = ldexp(1.0, HIST_MIN_EXP);
+        return;
+    }
+    int k = index - 1;
+    int exp = k / HIST_SUB_BUCKETS + HIST_MIN_EXP;
+    int sub = k % HIST_SUB_BUCKETS;
+    *lower = ldexp(1.0 + (double)sub / HIST_SUB_BUCKETS, exp);
+    *upper = ldexp(1.0 + (double)(sub + 1) / HIST_SUB_BUCKETS, exp);
+}
+
+void hist_reset(histogram_t *hist) {
+    memset(hist, 0, sizeof(histogram_t));
+}
+
+void hist_record(histogram_t *hist, double value) {
+    hist->counts[bucket_index(value)]++;
+    hist->count++;
+    if (hist->count == 1 || value < hist->min) {
+        hist->min = value;
+    }
+    if (hist->count == 1 || value > hist->max) {
+        hist->max = value;
+    }
+    double delta = value - hist->mean;
+    hist->mean += delta / hist->count;
+    hist->m2 += delta * (value - hist->mean);
+}
+
+void hist_merge(histogram_t *dst, const histogram_t *src) {
+    if (src->count == 0) {
+        return;
+    }
+    if (dst->count == 0) {
+        *dst = *src;
+        return;
+    }
+    for (int i = 0; i < HIST_BUCKETS; i++) {
+        dst->counts[i] += src->counts[i];
+    }
+    double n = (double)(dst->count + src->count);
+    double delta = src->mean - dst->mean;
+    dst->m2 += src->m2 + delta * delta * dst->count * src->count / n;
+    dst->mean += delta * src->count / n;
+    dst->count += src->count;
+    if (src->min < dst->min) {
+        dst->min = src->min;
+    }
+    if (src->max > dst->max) {
+        dst->max = src->max;
+    }
+}
+
+// 정렬했을 때 rank번째(0부터) 표본 추정값
+static double sample_at(const histogram_t *hist, uint64_t rank) {
+    if (rank == 0) {
+        return hist->min;
+    }
+    if (rank >= hist->count - 1) {
+        return hist->max;
+    }
+    uint64_t seen = 0;
+    for (int i = 0; i < HIST_BUCKETS; i++) {
+        uint64_t c = hist->counts[i];
+        if (rank < seen + c) {
+            double lower, upper;
+            bucket_bounds(i, &lower, &upper);
+            double v = lower + (upper - lower) * ((rank - seen) + 0.5) / c;
+            return v < hist->min ? hist->min : (v > hist->max ? hist->max : v);
+        }
+        seen += c;
+    }
+    return hist->max;
+}
+
+double hist_percentile(const histogram_t *hist, double q) {
+    if (hist->count == 0) {
+        return 0.0;
+    }
+    double r = q * (hist->count - 1);
+    uint64_t lo = (uint64_t)floor(r);
+    double lo_value = sample_at(hist, lo);
+    if (r == (double)lo) {
+        return lo_value;
+    }
+    double hi_value = sample_at(hist, lo + 1);
+    return lo_value + (r - lo) * (hi_value - lo_value);
+}
+
+void hist_stats(const histogram_t *hist, stats_t *stats) {
+    memset(stats, 0, sizeof(stats_t));
+    if (hist->count == 0) {
+        return;
+    }
+    stats->count = hist->count;
+    stats->mean = hist->mean;
+    stats->min = hist->min;
+    stats->max = hist->max;
+    stats->p50 = hist_percentile(hist, 0.50);
+    stats->p90 = hist_percentile(hist, 0.90);
+    stats->p99 = hist_percentile(hist, 0.99);
+    stats->p999 = hist_percentile(hist, 0.999);
+    stats->p9999 = hist_percentile(hist, 0.9999);
+    stats->stddev = sqrt(hist->m2 / hist->count);
+}
+
+void hist_write_json(FILE *fp, const histogram_t *hist, int indent) {
+    fprintf(fp, "{\n");
+    fprintf(fp, "%*s\"sub_buckets\": %d,\n", indent + 2, "", HIST_SUB_BUCKETS);
+    fprintf(fp, "%*s\"count\": %lu,\n", indent + 2, "", hist->count);
+    fprintf(fp, "%*s\"buckets\": [", indent + 2, "");
+
+    bool first = true;
+    for (int i = 0; i < HIST_BUCKETS; i++) {
+        if (hist->counts[i] == 0) {
+            continue;
+        }
+        double lower, upper;
+        bucket_bounds(i, &lower, &upper);
+        fprintf(fp, "%s\n%*s[%.9g, %.9g, %lu]", first ? "" : ",", indent + 4, "",
+                lower, upper, hist->counts[i]);
+        first = false;
+    }
+    if (!first) {
+        fprintf(fp, "\n%*s", indent + 2, "");
+    }
+    fprintf(fp, "]\n");
+    fprintf(fp, "%*s}", indent, "");
+}
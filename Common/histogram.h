@@ -0,0 +1,42 @@
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include "metrics.h"
+
+// 로그-선형 히스토그램 (HDR 방식): 2의 거듭제곱 구간마다 128개 선형 하위 버킷
+// 상대 오차 <= 1/128, 메모리 고정, 기록 O(1) (IEEE 754 지수/가수 비트로 인덱스 계산)
+#define HIST_SUB_BITS 7
+#define HIST_SUB_BUCKETS (1 << HIST_SUB_BITS)
+#define HIST_MIN_EXP (-20)              // 2^-20 ≈ 1e-6 미만은 0 버킷
+#define HIST_MAX_EXP 44                 // 2^44 ≈ 1.8e13 이상은 마지막 버킷
+#define HIST_BUCKETS ((HIST_MAX_EXP - HIST_MIN_EXP) * HIST_SUB_BUCKETS + 1)
+
+// 스레드마다 하나씩 두고 기록한 뒤 hist_merge로 합침 (잠금 없음)
+typedef struct histogram {
+    uint64_t counts[HIST_BUCKETS];
+    uint64_t count;
+    double min;
+    double max;
+    double mean;        // Welford 누적 (평균/표준편차는 정확값)
+    double m2;
+} histogram_t;
+
+void hist_reset(histogram_t *hist);
+
+void hist_record(histogram_t *hist, double value);
+
+// src를 dst에 합침 (평균/분산은 Chan 병합 공식)
+void hist_merge(histogram_t *dst, const histogram_t *src);
+
+// q(0~1) 분위수: 표본 순위 q*(count-1) 양쪽 표본을 버킷 내 균등 분포로 추정해 선형 보간
+double hist_percentile(const histogram_t *hist, double q);
+
+// mean/p50/p90/p99/p99.9/p99.99/min/max/stddev/count
+void hist_stats(const histogram_t *hist, stats_t *stats);
+
+// 0이 아닌 버킷만 [하한, 상한, 개수] 배열로 출력 (indent: 줄 앞 공백 수)
+void hist_write_json(FILE *fp, const histogram_t *hist, int indent);
+
+#endif // HISTOGRAM_H
@@ -0,0 +1,274 @@
+#define _GNU_SOURCE
+#include "io_ring.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+
+#define CQ_ENTRIES_FACTOR 8     // 멀티샷 accept/recv는 제출 1개에 완료 여러 개
+
+struct io_ring {
+    int fd;
+    unsigned sq_entries;
+    unsigned *sq_head;
+    unsigned *sq_tail;
+    unsigned sq_mask;
+    unsigned sq_local_tail;     // 채웠지만 아직 커널에 공개하지 않은 꼬리
+    unsigned to_submit;
+    struct io_uring_sqe *sqes;
+    unsigned *cq_head;
+    unsigned *cq_tail;
+    unsigned cq_mask;
+    struct io_uring_cqe *cqes;
+    void *sq_ptr;
+    size_t sq_size;
+    void *cq_ptr;
+    size_t cq_size;
+    size_t sqes_size;
+    // 수신 버퍼 링 (그룹 0)
+    struct io_uring_buf_ring *br;
+    size_t br_size;
+    unsigned buf_count;
+    unsigned buf_size;
+    char *buf_base;
+    // 송신 등록 영역
+    void *region;
+    size_t region_len;
+    uint64_t enters;
+};
+
+static int sys_setup(unsigned entries, struct io_uring_params *p) {
+    return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+static int sys_enter(int fd, unsigned submit, unsigned wait_nr, unsigned flags, void *arg, size_t argsz) {
+    return (int)syscall(__NR_io_uring_enter, fd, submit, wait_nr, flags, arg, argsz);
+}
+
+static int sys_register(int fd, unsigned opcode, void *arg, unsigned nr) {
+    return (int)syscall(__NR_io_uring_register, fd, opcode, arg, nr);
+}
+
+io_ring_t* io_ring_new(unsigned entries) {
+    io_ring_t *ring = calloc(1, sizeof(io_ring_t));
+    if (!ring) {
+        return NULL;
+    }
+
+    // 단일 스레드 제출 + 완료 처리를 다음 enter로 미룸 (6.1+), 지원하지 않으면 기본 설정으로 재시도
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    p.flags = IORING_SETUP_CQSIZE | IORING_SETUP_SUBMIT_ALL | IORING_SETUP_SINGLE_ISSUER |
+              IORING_SETUP_DEFER_TASKRUN;
+    p.cq_entries = entries * CQ_ENTRIES_FACTOR;
+    ring->fd = sys_setup(entries, &p);
+    if (ring->fd < 0 && errno == EINVAL) {
+        memset(&p, 0, sizeof(p));
+        p.flags = IORING_SETUP_CQSIZE;
+        p.cq_entries = entries * CQ_ENTRIES_FACTOR;
+        ring->fd = sys_setup(entries, &p);
+    }
+    if (ring->fd < 0) {
+        perror("io_uring_setup");
+        free(ring);
+        return NULL;
+    }
+    if (!(p.features & IORING_FEAT_SINGLE_MMAP)) {
+        fprintf(stderr, "io_uring: kernel without IORING_FEAT_SINGLE_MMAP\n");
+        close(ring->fd);
+        free(ring);
+        return NULL;
+    }
+
+    ring->sq_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    ring->cq_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if (ring->cq_size > ring->sq_size) {
+        ring->sq_size = ring->cq_size;
+    }
+    ring->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sq_ptr = mmap(NULL, ring->sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        ring->fd, IORING_OFF_SQ_RING);
+    ring->sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ring->fd, IORING_OFF_SQES);
+    if (ring->sq_ptr == MAP_FAILED || ring->sqes == MAP_FAILED) {
+        perror("io_uring mmap");
+        if (ring->sq_ptr != MAP_FAILED) munmap(ring->sq_ptr, ring->sq_size);
+        if (ring->sqes != MAP_FAILED) munmap(ring->sqes, ring->sqes_size);
+        close(ring->fd);
+        free(ring);
+        return NULL;
+    }
+    ring->cq_ptr = ring->sq_ptr;
+
+    char *sq = ring->sq_ptr;
+    ring->sq_head = (unsigned*)(sq + p.sq_off.head);
+    ring->sq_tail = (unsigned*)(sq + p.sq_off.tail);
+    ring->sq_mask = *(unsigned*)(sq + p.sq_off.ring_mask);
+    ring->sq_entries = p.sq_entries;
+    ring->sq_local_tail = *ring->sq_tail;
+    // 엔트리를 꼬리 순서대로 채우므로 인덱스 배열은 항등
+    unsigned *array = (unsigned*)(sq + p.sq_off.array);
+    for (unsigned i = 0; i < p.sq_entries; i++) {
+        array[i] = i;
+    }
+
+    char *cq = ring->cq_ptr;
+    ring->cq_head = (unsigned*)(cq + p.cq_off.head);
+    ring->cq_tail = (unsigned*)(cq + p.cq_off.tail);
+    ring->cq_mask = *(unsigned*)(cq + p.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe*)(cq + p.cq_off.cqes);
+    return ring;
+}
+
+struct io_uring_sqe* io_ring_sqe(io_ring_t *ring) {
+    unsigned head = __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE);
+    if (ring->sq_local_tail - head >= ring->sq_entries) {
+        io_ring_enter(ring, 0, 0);
+        head = __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE);
+        if (ring->sq_local_tail - head >= ring->sq_entries) {
+            return NULL;
+        }
+    }
+    struct io_uring_sqe *sqe = &ring->sqes[ring->sq_local_tail & ring->sq_mask];
+    memset(sqe, 0, sizeof(*sqe));
+    ring->sq_local_tail++;
+    ring->to_submit++;
+    return sqe;
+}
+
+int io_ring_enter(io_ring_t *ring, unsigned wait_nr, int timeout_ms) {
+    __atomic_store_n(ring->sq_tail, ring->sq_local_tail, __ATOMIC_RELEASE);
+
+    unsigned flags = wait_nr > 0 ? IORING_ENTER_GETEVENTS : 0;
+    struct __kernel_timespec ts = {
+        .tv_sec = timeout_ms / 1000,
+        .tv_nsec = (long long)(timeout_ms % 1000) * 1000000LL
+    };
+    struct io_uring_getevents_arg arg;
+    memset(&arg, 0, sizeof(arg));
+    arg.ts = (uint64_t)(uintptr_t)&ts;
+    int ret;
+    if (wait_nr > 0 && timeout_ms > 0) {
+        flags |= IORING_ENTER_EXT_ARG;
+        ret = sys_enter(ring->fd, ring->to_submit, wait_nr, flags, &arg, sizeof(arg));
+    } else {
+        ret = sys_enter(ring->fd, ring->to_submit, wait_nr, flags, NULL, 0);
+    }
+    ring->enters++;
+    if (ret < 0) {
+        // 대기 중 시간 초과/시그널이어도 제출은 끝났을 수 있음 (SUBMIT_ALL)
+        if (errno == ETIME || errno == EINTR || errno == EBUSY) {
+            ring->to_submit = ring->sq_local_tail - __atomic_load_n(ring->sq_head, __ATOMIC_ACQUIRE);
+            return 0;
+        }
+        return -errno;
+    }
+    ring->to_submit -= (unsigned)ret < ring->to_submit ? (unsigned)ret : ring->to_submit;
+    return ret;
+}
+
+struct io_uring_cqe* io_ring_cqe(io_ring_t *ring) {
+    unsigned head = *ring->cq_head;
+    if (head == __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE)) {
+        return NULL;
+    }
+    return &ring->cqes[head & ring->cq_mask];
+}
+
+void io_ring_cqe_seen(io_ring_t *ring) {
+    __atomic_store_n(ring->cq_head, *ring->cq_head + 1, __ATOMIC_RELEASE);
+}
+
+bool io_ring_setup_bufs(io_ring_t *ring, unsigned count, unsigned size) {
+    ring->br_size = count * sizeof(struct io_uring_buf);
+    ring->br = mmap(NULL, ring->br_size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    ring->buf_base = mmap(NULL, (size_t)count * size, PROT_READ | PROT_WRITE,
+                          MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    if (ring->br == MAP_FAILED || ring->buf_base == MAP_FAILED) {
+        perror("io_uring buffer ring mmap");
+        if (ring->br != MAP_FAILED) munmap(ring->br, ring->br_size);
+        if (ring->buf_base != MAP_FAILED) munmap(ring->buf_base, (size_t)count * size);
+        ring->br = NULL;
+        ring->buf_base = NULL;
+        return false;
+    }
+
+    struct io_uring_buf_reg reg;
+    memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = (uint64_t)(uintptr_t)ring->br;
+    reg.ring_entries = count;
+    reg.bgid = 0;
+    if (sys_register(ring->fd, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+        perror("IORING_REGISTER_PBUF_RING");
+        munmap(ring->br, ring->br_size);
+        munmap(ring->buf_base, (size_t)count * size);
+        ring->br = NULL;
+        ring->buf_base = NULL;
+        return false;
+    }
+
+    ring->buf_count = count;
+    ring->buf_size = size;
+    for (unsigned i = 0; i < count; i++) {
+        io_ring_buf_recycle(ring, i);
+    }
+    return true;
+}
+
+void* io_ring_buf(io_ring_t *ring, unsigned bid) {
+    return ring->buf_base + (size_t)bid * ring->buf_size;
+}
+
+void io_ring_buf_recycle(io_ring_t *ring, unsigned bid) {
+    // 꼬리는 링 헤더의 resv 자리 (bufs[0]과 겹침), 커널은 꼬리만 읽음
+    unsigned short tail = ring->br->tail;
+    struct io_uring_buf *buf = &ring->br->bufs[tail & (ring->buf_count - 1)];
+    buf->addr = (uint64_t)(uintptr_t)io_ring_buf(ring, bid);
+    buf->len = ring->buf_size;
+    buf->bid = (unsigned short)bid;
+    __atomic_store_n(&ring->br->tail, (unsigned short)(tail + 1), __ATOMIC_RELEASE);
+}
+
+void* io_ring_register_region(io_ring_t *ring, size_t len) {
+    void *region = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    if (region == MAP_FAILED) {
+        perror("io_uring region mmap");
+        return NULL;
+    }
+    struct iovec iov = { .iov_base = region, .iov_len = len };
+    if (sys_register(ring->fd, IORING_REGISTER_BUFFERS, &iov, 1) < 0) {
+        perror("IORING_REGISTER_BUFFERS");
+        munmap(region, len);
+        return NULL;
+    }
+    ring->region = region;
+    ring->region_len = len;
+    return region;
+}
+
+uint64_t io_ring_enters(const io_ring_t *ring) {
+    return ring->enters;
+}
+
+void io_ring_free(io_ring_t *ring) {
+    if (!ring) {
+        return;
+    }
+    // 링을 닫으면 커널이 남은 요청을 취소하고 등록을 해제
+    close(ring->fd);
+    munmap(ring->sqes, ring->sqes_size);
+    munmap(ring->sq_ptr, ring->sq_size);
+    if (ring->br) {
+        munmap(ring->br, ring->br_size);
+        munmap(ring->buf_base, (size_t)ring->buf_count * ring->buf_size);
+    }
+    if (ring->region) {
+        munmap(ring->region, ring->region_len);
+    }
+    free(ring);
+}
@@ -0,0 +1,42 @@
+#ifndef IO_RING_H
+#define IO_RING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <linux/io_uring.h>
+
+// liburing 없이 io_uring_setup/enter/register 시스템 콜만으로 쓰는 최소 링 (스레드 1개 전용)
+//  - 제출 큐 엔트리는 io_ring_sqe로 받아 채우고, io_ring_enter가 한 번의 시스템 콜로 제출 + 완료 대기
+//  - 수신 버퍼는 커널이 고르는 버퍼 링(IORING_REGISTER_PBUF_RING, 그룹 0)
+//  - 송신 버퍼는 등록 버퍼 영역 1개(IORING_REGISTER_BUFFERS, 인덱스 0)를 잘라서 사용
+typedef struct io_ring io_ring_t;
+
+// entries: 제출 큐 크기 (완료 큐는 멀티샷 완료가 넘치지 않도록 더 크게), 실패 시 NULL
+io_ring_t* io_ring_new(unsigned entries);
+
+// 빈 제출 엔트리 (0으로 초기화, 큐가 차면 먼저 제출)
+struct io_uring_sqe* io_ring_sqe(io_ring_t *ring);
+
+// 쌓인 엔트리 제출 후 wait_nr개 완료까지 최대 timeout_ms 대기 (시간 초과/EINTR은 0, 오류 시 -errno)
+int io_ring_enter(io_ring_t *ring, unsigned wait_nr, int timeout_ms);
+
+// 다음 완료 엔트리 (없으면 NULL), 처리 후 io_ring_cqe_seen
+struct io_uring_cqe* io_ring_cqe(io_ring_t *ring);
+void io_ring_cqe_seen(io_ring_t *ring);
+
+// 수신 버퍼 링: count개(2의 거듭제곱) × size 바이트 등록 (실패 시 false)
+bool io_ring_setup_bufs(io_ring_t *ring, unsigned count, unsigned size);
+void* io_ring_buf(io_ring_t *ring, unsigned bid);
+// 소비한 수신 버퍼를 링에 반환
+void io_ring_buf_recycle(io_ring_t *ring, unsigned bid);
+
+// 송신용 등록 버퍼 영역 (len 바이트, 실패 시 NULL), WRITE_FIXED의 buf_index 0
+void* io_ring_register_region(io_ring_t *ring, size_t len);
+
+// io_uring_enter 호출 수
+uint64_t io_ring_enters(const io_ring_t *ring);
+
+void io_ring_free(io_ring_t *ring);
+
+#endif // IO_RING_H
@@ -1,4 +1,6 @@
 #include "json_output.h"
+#include "histogram.h"
+#include "cert_comp.h"
 #include <string.h>
 #include <time.h>
 
@@ -9,10 +11,49 @@ static void write_stats_json(FILE *fp, const char *name, stats_t *stats, bool la
     fprintf(fp, "          \"p50\": %.3f,\n", stats->p50);
     fprintf(fp, "          \"p90\": %.3f,\n", stats->p90);
     fprintf(fp, "          \"p99\": %.3f,\n", stats->p99);
-    fprintf(fp, "          \"stddev\": %.3f\n", stats->stddev);
+    fprintf(fp, "          \"p999\": %.3f,\n", stats->p999);
+    fprintf(fp, "          \"p9999\": %.3f,\n", stats->p9999);
+    fprintf(fp, "          \"min\": %.3f,\n", stats->min);
+    fprintf(fp, "          \"max\": %.3f,\n", stats->max);
+    fprintf(fp, "          \"stddev\": %.3f,\n", stats->stddev);
+    fprintf(fp, "          \"count\": %lu\n", stats->count);
     fprintf(fp, "        }%s\n", last ? "" : ",");
 }
 
+// handshake_metrics_t 전체 필드 통계 (필드당 한 줄)
+static void write_field_stats_json(FILE *fp, const benchmark_result_t *r) {
+    fprintf(fp, "      \"field_stats\": {\n");
+    for (int f = 0; f < METRIC_FIELD_COUNT; f++) {
+        const stats_t *s = &r->field_stats[f];
+        fprintf(fp, "        \"%s\": {\"mean\": %.6g, \"p50\": %.6g, \"p90\": %.6g, \"p99\": %.6g, "
+                "\"p999\": %.6g, \"p9999\": %.6g, \"min\": %.6g, \"max\": %.6g, \"stddev\": %.6g, "
+                "\"count\": %lu}%s\n",
+                METRIC_FIELDS[f].name, s->mean, s->p50, s->p90, s->p99, s->p999, s->p9999,
+                s->min, s->max, s->stddev, s->count, f < METRIC_FIELD_COUNT - 1 ? "," : "");
+    }
+    fprintf(fp, "      },\n");
+}
+
+// 핸드셰이크 메시지별 크기를 JSON 형식으로 출력
+static void write_message_bytes_json(FILE *fp, const message_bytes_t *mb) {
+    fprintf(fp, "        \"message_bytes\": {\n");
+    fprintf(fp, "          \"client_hello\": %u,\n", mb->client_hello);
+    fprintf(fp, "          \"server_hello\": %u,\n", mb->server_hello);
+    fprintf(fp, "          \"encrypted_extensions\": %u,\n", mb->encrypted_extensions);
+    fprintf(fp, "          \"certificate_request\": %u,\n", mb->certificate_request);
+    fprintf(fp, "          \"server_certificate\": %u,\n", mb->server_certificate);
+    fprintf(fp, "          \"server_certificate_verify\": %u,\n", mb->server_certificate_verify);
+    fprintf(fp, "          \"server_finished\": %u,\n", mb->server_finished);
+    fprintf(fp, "          \"client_certificate\": %u,\n", mb->client_certificate);
+    fprintf(fp, "          \"client_certificate_verify\": %u,\n", mb->client_certificate_verify);
+    fprintf(fp, "          \"client_finished\": %u,\n", mb->client_finished);
+    fprintf(fp, "          \"server_certificate_uncompressed\": %u,\n", mb->server_certificate_uncompressed);
+    fprintf(fp, "          \"client_certificate_uncompressed\": %u,\n", mb->client_certificate_uncompressed);
+    fprintf(fp, "          \"client_hello_initial\": %u,\n", mb->client_hello_initial);
+    fprintf(fp, "          \"hello_retry_request\": %u\n", mb->hello_retry_request);
+    fprintf(fp, "        }\n");
+}
+
 // JSON 결과 파일 작성
 void write_json_results(const char *filename, 
                         metadata_t *metadata,
@@ -33,12 +74,23 @@ void write_json_results(const char *filename,
     fprintf(fp, "    \"version_or_commit\": \"%s\",\n", metadata->version_or_commit);
     fprintf(fp, "    \"platform\": \"%s\",\n", metadata->platform);
     fprintf(fp, "    \"network\": {\n");
-    fprintf(fp, "      \"rtt_ms\": %d,\n", metadata->rtt_ms);
-    fprintf(fp, "      \"mtu\": %d\n", metadata->mtu);
+    fprintf(fp, "      \"rtt_ms\": %.3f,\n", metadata->rtt_ms);
+    fprintf(fp, "      \"mtu\": %d,\n", metadata->mtu);
+    fprintf(fp, "      \"emulated\": %s,\n", metadata->netem ? "true" : "false");
+    fprintf(fp, "      \"bandwidth_mbps\": %.3f,\n", metadata->bandwidth_mbps);
+    fprintf(fp, "      \"loss_pct\": %.3f,\n", metadata->loss_pct);
+    fprintf(fp, "      \"segment_bytes\": %d,\n", metadata->segment_bytes);
+    fprintf(fp, "      \"initcwnd\": %d,\n", metadata->initcwnd);
+    fprintf(fp, "      \"nodelay\": %s\n", metadata->nodelay ? "true" : "false");
     fprintf(fp, "    },\n");
     fprintf(fp, "    \"cipher\": \"%s\",\n", metadata->cipher);
     fprintf(fp, "    \"tls_version\": \"%s\",\n", metadata->tls_version);
     fprintf(fp, "    \"mTLS\": %s,\n", metadata->mtls ? "true" : "false");
+    fprintf(fp, "    \"groups\": {\"client\": \"%s\", \"server\": \"%s\"},\n",
+            metadata->client_groups[0] ? metadata->client_groups : "combo",
+            metadata->server_groups[0] ? metadata->server_groups : "combo");
+    fprintf(fp, "    \"cert_compression\": {\"algorithms\": \"%s\", \"precompressed\": %s},\n",
+            metadata->cert_compression, metadata->cert_precompress ? "true" : "false");
     fprintf(fp, "    \"runs_per_combo\": %d,\n", metadata->runs_per_combo);
     fprintf(fp, "    \"date\": \"%s\"\n", metadata->date);
     fprintf(fp, "  },\n");
@@ -68,7 +120,8 @@ void write_json_results(const char *filename,
         write_stats_json(fp, "t_handshake_total_ms", &r->t_handshake_total_ms, false);
         write_stats_json(fp, "t_clienthello_to_serverhello_ms", &r->t_clienthello_to_serverhello_ms, false);
         write_stats_json(fp, "t_cert_verify_ms", &r->t_cert_verify_ms, false);
-        write_stats_json(fp, "t_finished_flight_ms", &r->t_finished_flight_ms, true);
+        write_stats_json(fp, "t_finished_flight_ms", &r->t_finished_flight_ms, false);
+        write_stats_json(fp, "t_hello_retry_ms", &r->t_hello_retry_ms, true);
         fprintf(fp, "      },\n");
         
         // 트래픽
@@ -77,12 +130,24 @@ void write_json_results(const char *filename,
         fprintf(fp, "        \"bytes_rx_handshake\": %lu,\n", r->traffic_avg.bytes_rx_handshake);
         fprintf(fp, "        \"records_count\": %u,\n", r->traffic_avg.records_count);
         fprintf(fp, "        \"packets_count\": %u,\n", r->traffic_avg.packets_count);
-        fprintf(fp, "        \"retransmits\": %u\n", r->traffic_avg.retransmits);
+        fprintf(fp, "        \"retransmits\": %u,\n", r->traffic_avg.retransmits);
+        fprintf(fp, "        \"tcp\": {\n");
+        fprintf(fp, "          \"segs_out\": %u,\n", r->traffic_avg.segs_out);
+        fprintf(fp, "          \"segs_in\": %u,\n", r->traffic_avg.segs_in);
+        fprintf(fp, "          \"snd_cwnd\": %u,\n", r->traffic_avg.snd_cwnd);
+        fprintf(fp, "          \"snd_mss\": %u,\n", r->traffic_avg.snd_mss);
+        fprintf(fp, "          \"rtt_us\": %u,\n", r->traffic_avg.tcp_rtt_us);
+        fprintf(fp, "          \"server_flight_bytes\": %u,\n", r->traffic_avg.server_flight_bytes);
+        fprintf(fp, "          \"server_flight_rounds\": %u\n", r->traffic_avg.server_flight_rounds);
+        fprintf(fp, "        },\n");
+        write_message_bytes_json(fp, &r->traffic_avg.msg_bytes);
         fprintf(fp, "      },\n");
         
         // 암호화
         fprintf(fp, "      \"crypto\": {\n");
         fprintf(fp, "        \"kem_keyshare_len\": %u,\n", r->crypto_avg.kem_keyshare_len);
+        fprintf(fp, "        \"kem_ciphertext_len\": %u,\n", r->crypto_avg.kem_ciphertext_len);
+        fprintf(fp, "        \"kem_keygen_ms\": %.3f,\n", r->crypto_avg.kem_keygen_ms);
         fprintf(fp, "        \"kem_encap_ms\": {\"client\": %.3f, \"server\": %.3f},\n",
                 r->crypto_avg.kem_encap_ms_client, r->crypto_avg.kem_encap_ms_server);
         fprintf(fp, "        \"kem_decap_ms\": {\"client\": %.3f, \"server\": %.3f},\n",
@@ -92,15 +157,35 @@ void write_json_results(const char *filename,
                 r->crypto_avg.sign_ms_server, r->crypto_avg.sign_ms_client);
         fprintf(fp, "        \"verify_ms\": {\"server\": %.3f, \"client\": %.3f},\n",
                 r->crypto_avg.verify_ms_server, r->crypto_avg.verify_ms_client);
-        fprintf(fp, "        \"cert_chain_size_bytes\": {\"excluding_root\": %u, \"including_root\": %u}\n",
+        fprintf(fp, "        \"cert_chain_size_bytes\": {\"excluding_root\": %u, \"including_root\": %u},\n",
                 r->crypto_avg.cert_chain_size_excluding_root, r->crypto_avg.cert_chain_size_including_root);
+        fprintf(fp, "        \"cert_compression\": {\"algorithm\": \"%s\", \"compress_ms\": %.4f, \"decompress_ms\": %.4f},\n",
+                cert_comp_name((int)r->crypto_avg.cert_comp_alg),
+                r->crypto_avg.cert_compress_ms, r->crypto_avg.cert_decompress_ms);
+        fprintf(fp, "        \"primitives_ms\": {\"kem_keygen\": %.4f, \"kem_encap\": %.4f, \"kem_decap\": %.4f, "
+                "\"sign\": %.4f, \"verify\": %.4f},\n", r->prim_ms.kem_keygen_ms, r->prim_ms.kem_encap_ms,
+                r->prim_ms.kem_decap_ms, r->prim_ms.sign_ms, r->prim_ms.verify_ms);
+        fprintf(fp, "        \"key_shares_offered\": %u,\n", r->crypto_avg.key_shares_offered);
+        fprintf(fp, "        \"hello_retry\": {\"runs\": %d, \"rate\": %.3f}\n", r->hello_retry_runs,
+                r->successful_runs > 0 ? (double)r->hello_retry_runs / r->successful_runs : 0.0);
         fprintf(fp, "      },\n");
         
         // 리소스
         fprintf(fp, "      \"resources\": {\n");
         fprintf(fp, "        \"peak_heap_bytes\": %lu,\n", r->resources_avg.peak_heap_bytes);
+        fprintf(fp, "        \"heap_retained_bytes\": %lu,\n", r->resources_avg.heap_retained_bytes);
+        fprintf(fp, "        \"heap_allocs\": %lu,\n", r->resources_avg.heap_allocs);
         fprintf(fp, "        \"stack_usage_bytes\": %lu,\n", r->resources_avg.stack_usage_bytes);
         fprintf(fp, "        \"cpu_cycles\": %lu,\n", r->resources_avg.cpu_cycles);
+        fprintf(fp, "        \"instructions\": %lu,\n", r->resources_avg.instructions);
+        fprintf(fp, "        \"cache_misses\": %lu,\n", r->resources_avg.cache_misses);
+        fprintf(fp, "        \"branch_misses\": %lu,\n", r->resources_avg.branch_misses);
+        fprintf(fp, "        \"task_clock_ns\": %lu,\n", r->resources_avg.task_clock_ns);
+        fprintf(fp, "        \"cpu_time_ns\": %lu,\n", r->resources_avg.cpu_time_ns);
+        fprintf(fp, "        \"server_cpu_cycles\": %lu,\n", r->resources_avg.server_cpu_cycles);
+        fprintf(fp, "        \"server_cpu_time_ns\": %lu,\n", r->resources_avg.server_cpu_time_ns);
+        fprintf(fp, "        \"server_peak_heap_bytes\": %lu,\n", r->resources_avg.server_peak_heap_bytes);
+        fprintf(fp, "        \"server_heap_retained_bytes\": %lu,\n", r->resources_avg.server_heap_retained_bytes);
         fprintf(fp, "        \"energy_mJ\": %.3f\n", r->resources_avg.energy_mJ);
         fprintf(fp, "      },\n");
         
@@ -111,10 +196,25 @@ void write_json_results(const char *filename,
         fprintf(fp, "        \"session_resumption_ok\": %s,\n", 
                 r->reliability_avg.session_resumption_ok ? "true" : "false");
         fprintf(fp, "        \"t_resumption_ms\": %.3f,\n", r->reliability_avg.t_resumption_ms);
+        fprintf(fp, "        \"resumption_speedup\": %.3f,\n",
+                r->reliability_avg.t_resumption_ms > 0 ?
+                r->t_handshake_total_ms.mean / r->reliability_avg.t_resumption_ms : 0.0);
+        fprintf(fp, "        \"psk_ke_ok\": %s,\n", r->reliability_avg.psk_ke_ok ? "true" : "false");
+        fprintf(fp, "        \"t_resumption_psk_ke_ms\": %.3f,\n", r->reliability_avg.t_resumption_psk_ke_ms);
         fprintf(fp, "        \"zero_rtt_ok\": %s,\n", 
                 r->reliability_avg.zero_rtt_ok ? "true" : "false");
         fprintf(fp, "        \"t_0rtt_ms\": %.3f\n", r->reliability_avg.t_0rtt_ms);
-        fprintf(fp, "      }\n");
+        fprintf(fp, "      },\n");
+        
+        // 전체 필드 통계와 레이턴시 히스토그램 버킷
+        write_field_stats_json(fp, r);
+        fprintf(fp, "      \"latency_histogram_ms\": ");
+        if (r->latency_hist) {
+            hist_write_json(fp, r->latency_hist, 6);
+            fprintf(fp, "\n");
+        } else {
+            fprintf(fp, "null\n");
+        }
         
         fprintf(fp, "    }%s\n", i < result_count - 1 ? "," : "");
     }
@@ -138,13 +238,13 @@ void write_csv_results(const char *filename,
     
     // 헤더
     fprintf(fp, "group,sigalg,t_total_ms_mean,t_total_ms_p50,t_total_ms_p90,");
-    fprintf(fp, "bytes_tx,bytes_rx,kem_keyshare_len,sig_len,peak_heap_bytes,success_rate\n");
+    fprintf(fp, "bytes_tx,bytes_rx,kem_keyshare_len,kem_ciphertext_len,sig_len,cert_chain_bytes,peak_heap_bytes,success_rate\n");
     
     // 데이터 행
     for (int i = 0; i < result_count; i++) {
         benchmark_result_t *r = &results[i];
         
-        fprintf(fp, "%s,%s,%.3f,%.3f,%.3f,%lu,%lu,%u,%u,%lu,%.3f\n",
+        fprintf(fp, "%s,%s,%.3f,%.3f,%.3f,%lu,%lu,%u,%u,%u,%u,%lu,%.3f\n",
                 r->group,
                 r->sigalg,
                 r->t_handshake_total_ms.mean,
@@ -153,7 +253,9 @@ void write_csv_results(const char *filename,
                 r->traffic_avg.bytes_tx_handshake,
                 r->traffic_avg.bytes_rx_handshake,
                 r->crypto_avg.kem_keyshare_len,
+                r->crypto_avg.kem_ciphertext_len,
                 r->crypto_avg.sig_len,
+                r->crypto_avg.cert_chain_size_excluding_root,
                 r->resources_avg.peak_heap_bytes,
                 r->reliability_avg.success_rate);
     }
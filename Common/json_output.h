@@ -9,11 +9,21 @@ typedef struct {
     char library[64];
     char version_or_commit[128];
     char platform[128];
-    int rtt_ms;
+    double rtt_ms;          // 에뮬레이션한 RTT (중계기 없으면 0)
     int mtu;
+    bool netem;             // 지연/대역폭/손실 중계기 경유 여부 (Common/net_emu.c)
+    double bandwidth_mbps;  // 0: 무제한
+    double loss_pct;
+    int segment_bytes;
+    int initcwnd;           // 에뮬레이션한 초기 혼잡 윈도 (0: 모델 없음)
+    bool nodelay;           // TCP_NODELAY
+    char client_groups[128];    // 클라이언트 제시 그룹 (빈 문자열 = 조합 그룹)
+    char server_groups[128];
     char cipher[64];
     char tls_version[16];
     bool mtls;
+    char cert_compression[32];  // 협상 허용 목록 ("none" = 비활성)
+    bool cert_precompress;
     int runs_per_combo;
     char date[64];
 } metadata_t;
@@ -0,0 +1,230 @@
+#include "mem_track.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <openssl/crypto.h>
+
+// 블록 앞에 붙는 헤더 (16바이트라 malloc 정렬 유지)
+typedef struct {
+    size_t size;        // 요청 크기
+    size_t cls;         // 풀 크기 클래스 (POOL_DIRECT: malloc 직접)
+} block_header_t;
+
+#define POOL_CLASSES 10             // 64B ~ 32KB 블록
+#define POOL_MIN_SHIFT 6
+#define POOL_DIRECT ((size_t)-1)
+#define POOL_MAX_CACHED 256         // 클래스당 스레드 캐시 상한
+
+static bool installed;
+static bool pool_mode;
+
+static _Atomic int64_t global_live;
+static _Atomic int64_t global_peak;
+static _Atomic uint64_t global_allocs;
+static _Atomic uint64_t global_frees;
+static _Atomic uint64_t global_pool_hits;
+
+static __thread mem_account_t *current;
+
+// 스레드 로컬 free list (블록 본문 첫 8바이트에 다음 포인터 저장)
+static __thread void *cache_head[POOL_CLASSES];
+static __thread uint32_t cache_count[POOL_CLASSES];
+static __thread int cache_state;    // 0: 미등록, 1: 사용 중, 2: 스레드 종료로 닫힘
+
+static pthread_key_t cache_key;
+static pthread_once_t cache_once = PTHREAD_ONCE_INIT;
+
+static size_t class_block_size(size_t cls) {
+    return (size_t)1 << (cls + POOL_MIN_SHIFT);
+}
+
+static size_t size_class(size_t size) {
+    size_t block = size + sizeof(block_header_t);
+    for (size_t cls = 0; cls < POOL_CLASSES; cls++) {
+        if (block <= class_block_size(cls)) {
+            return cls;
+        }
+    }
+    return POOL_DIRECT;
+}
+
+// 스레드 종료 시 캐시 반환 (이후 해제는 free로 직행)
+static void cache_release(void *arg) {
+    (void)arg;
+    for (int cls = 0; cls < POOL_CLASSES; cls++) {
+        void *block = cache_head[cls];
+        while (block) {
+            void *next = *(void**)((block_header_t*)block + 1);
+            free(block);
+            block = next;
+        }
+        cache_head[cls] = NULL;
+        cache_count[cls] = 0;
+    }
+    cache_state = 2;
+}
+
+static void cache_key_init(void) {
+    pthread_key_create(&cache_key, cache_release);
+}
+
+static bool cache_usable(void) {
+    if (cache_state == 0) {
+        pthread_once(&cache_once, cache_key_init);
+        pthread_setspecific(cache_key, (void*)1);
+        cache_state = 1;
+    }
+    return cache_state == 1;
+}
+
+static void account(int64_t delta) {
+    int64_t live = atomic_fetch_add_explicit(&global_live, delta, memory_order_relaxed) + delta;
+    int64_t peak = atomic_load_explicit(&global_peak, memory_order_relaxed);
+    while (live > peak &&
+           !atomic_compare_exchange_weak_explicit(&global_peak, &peak, live,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+    }
+
+    mem_account_t *a = current;
+    if (a) {
+        a->live += delta;
+        if (a->live > a->peak) {
+            a->peak = a->live;
+        }
+    }
+}
+
+static block_header_t* block_get(size_t size) {
+    size_t cls = pool_mode ? size_class(size) : POOL_DIRECT;
+    block_header_t *h = NULL;
+
+    if (cls != POOL_DIRECT) {
+        if (cache_usable() && cache_head[cls]) {
+            h = cache_head[cls];
+            cache_head[cls] = *(void**)(h + 1);
+            cache_count[cls]--;
+            atomic_fetch_add_explicit(&global_pool_hits, 1, memory_order_relaxed);
+        } else {
+            h = malloc(class_block_size(cls));
+        }
+    } else {
+        h = malloc(sizeof(block_header_t) + size);
+    }
+    if (h) {
+        h->size = size;
+        h->cls = cls;
+    }
+    return h;
+}
+
+static void block_put(block_header_t *h) {
+    size_t cls = h->cls;
+    if (cls != POOL_DIRECT && cache_count[cls] < POOL_MAX_CACHED && cache_usable()) {
+        *(void**)(h + 1) = cache_head[cls];
+        cache_head[cls] = h;
+        cache_count[cls]++;
+        return;
+    }
+    free(h);
+}
+
+static void* track_malloc(size_t size, const char *file, int line) {
+    (void)file;
+    (void)line;
+    block_header_t *h = block_get(size);
+    if (!h) {
+        return NULL;
+    }
+    atomic_fetch_add_explicit(&global_allocs, 1, memory_order_relaxed);
+    if (current) {
+        current->allocs++;
+    }
+    account((int64_t)size);
+    return h + 1;
+}
+
+static void track_free(void *ptr, const char *file, int line) {
+    (void)file;
+    (void)line;
+    if (!ptr) {
+        return;
+    }
+    block_header_t *h = (block_header_t*)ptr - 1;
+    atomic_fetch_add_explicit(&global_frees, 1, memory_order_relaxed);
+    if (current) {
+        current->frees++;
+    }
+    account(-(int64_t)h->size);
+    block_put(h);
+}
+
+static void* track_realloc(void *ptr, size_t size, const char *file, int line) {
+    if (!ptr) {
+        return track_malloc(size, file, line);
+    }
+    if (size == 0) {
+        track_free(ptr, file, line);
+        return NULL;
+    }
+
+    block_header_t *h = (block_header_t*)ptr - 1;
+
+    // 풀 블록에 여유가 있으면 제자리 확장/축소
+    if (h->cls != POOL_DIRECT && size + sizeof(block_header_t) <= class_block_size(h->cls)) {
+        account((int64_t)size - (int64_t)h->size);
+        h->size = size;
+        return ptr;
+    }
+    if (h->cls == POOL_DIRECT) {
+        size_t old = h->size;
+        block_header_t *n = realloc(h, sizeof(block_header_t) + size);
+        if (!n) {
+            return NULL;
+        }
+        n->size = size;
+        account((int64_t)size - (int64_t)old);
+        return n + 1;
+    }
+
+    void *p = track_malloc(size, file, line);
+    if (p) {
+        memcpy(p, ptr, h->size < size ? h->size : size);
+        track_free(ptr, file, line);
+    }
+    return p;
+}
+
+bool mem_track_install(bool pool) {
+    pool_mode = pool;
+    installed = CRYPTO_set_mem_functions(track_malloc, track_realloc, track_free) == 1;
+    if (!installed) {
+        fprintf(stderr, "Warning: OpenSSL already allocated memory, heap accounting disabled\n");
+    }
+    return installed;
+}
+
+bool mem_track_enabled(void) {
+    return installed;
+}
+
+mem_account_t* mem_track_switch(mem_account_t *account) {
+    mem_account_t *prev = current;
+    current = account;
+    return prev;
+}
+
+void mem_track_global(mem_global_t *global) {
+    global->live = atomic_load(&global_live);
+    global->peak = atomic_load(&global_peak);
+    global->allocs = atomic_load(&global_allocs);
+    global->frees = atomic_load(&global_frees);
+    global->pool_hits = atomic_load(&global_pool_hits);
+}
+
+void mem_fill_resources(const mem_account_t *account, resource_metrics_t *resources) {
+    resources->peak_heap_bytes = account->peak > 0 ? (uint64_t)account->peak : 0;
+    resources->heap_retained_bytes = account->live > 0 ? (uint64_t)account->live : 0;
+    resources->heap_allocs = account->allocs;
+}
@@ -0,0 +1,40 @@
+#ifndef MEM_TRACK_H
+#define MEM_TRACK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "metrics.h"
+
+// 연결별 힙 계정 (current로 지정된 동안의 OpenSSL 할당/해제만 반영)
+// 한 연결은 한 스레드에서만 구동되므로 원자 연산 없이 갱신
+typedef struct {
+    int64_t live;       // 할당 - 해제 바이트 (다른 계정에서 만든 블록 해제 시 음수 가능)
+    int64_t peak;
+    uint64_t allocs;
+    uint64_t frees;
+} mem_account_t;
+
+// 프로세스 전체 통계
+typedef struct {
+    int64_t live;
+    int64_t peak;
+    uint64_t allocs;
+    uint64_t frees;
+    uint64_t pool_hits;     // 풀 모드: 스레드 캐시에서 재사용한 블록 수
+} mem_global_t;
+
+// OpenSSL 메모리 훅 설치 (main 시작 직후, OpenSSL이 처음 할당하기 전에 호출)
+// pool: 크기 클래스별 스레드 로컬 free list로 malloc/free 왕복을 줄임
+bool mem_track_install(bool pool);
+
+bool mem_track_enabled(void);
+
+// 현재 스레드의 계정 교체, 이전 계정 반환 (NULL: 전역 통계만)
+mem_account_t* mem_track_switch(mem_account_t *account);
+
+void mem_track_global(mem_global_t *global);
+
+// peak_heap_bytes(핸드셰이크 중 최대), heap_allocs, heap_retained_bytes(핸드셰이크 후 남은 바이트) 기록
+void mem_fill_resources(const mem_account_t *account, resource_metrics_t *resources);
+
+#endif // MEM_TRACK_H
@@ -1,15 +1,15 @@
 #include "metrics.h"
+#include "histogram.h"
 #include <string.h>
-#include <math.h>
 #include <stdlib.h>
 
 // 타이머 시작
-void start_timer(timer_t *timer) {
+void start_timer(bench_timer_t *timer) {
     clock_gettime(CLOCK_MONOTONIC, &timer->start);
 }
 
 // 타이머 종료 및 밀리초 반환
-double end_timer(timer_t *timer) {
+double end_timer(bench_timer_t *timer) {
     clock_gettime(CLOCK_MONOTONIC, &timer->end);
     
     double start_ms = timer->start.tv_sec * 1000.0 + timer->start.tv_nsec / 1000000.0;
@@ -18,45 +18,139 @@ double end_timer(timer_t *timer) {
     return end_ms - start_ms;
 }
 
-// 비교 함수 (qsort용)
-static int compare_double(const void *a, const void *b) {
-    double diff = *(double*)a - *(double*)b;
-    return (diff > 0) - (diff < 0);
-}
-
-// 통계 계산
+// 통계 계산 (histogram_t는 수십 KB라 힙에 할당, 실패 시 모두 0)
 void calculate_stats(double *values, int count, stats_t *stats) {
-    if (count == 0) {
+    histogram_t *hist = malloc(sizeof(histogram_t));
+    if (!hist) {
         memset(stats, 0, sizeof(stats_t));
         return;
     }
-    
-    // 정렬
-    double *sorted = malloc(count * sizeof(double));
-    memcpy(sorted, values, count * sizeof(double));
-    qsort(sorted, count, sizeof(double), compare_double);
-    
-    // 평균
-    double sum = 0.0;
+    hist_reset(hist);
     for (int i = 0; i < count; i++) {
-        sum += sorted[i];
+        hist_record(hist, values[i]);
     }
-    stats->mean = sum / count;
-    
-    // 백분위수
-    stats->p50 = sorted[(int)(count * 0.50)];
-    stats->p90 = sorted[(int)(count * 0.90)];
-    stats->p99 = sorted[(int)(count * 0.99)];
-    
-    // 표준편차
-    double variance = 0.0;
-    for (int i = 0; i < count; i++) {
-        double diff = sorted[i] - stats->mean;
-        variance += diff * diff;
+    hist_stats(hist, stats);
+    free(hist);
+}
+
+#define FIELD(path, type) { #path, offsetof(handshake_metrics_t, path), type }
+
+// 실행마다 채워지는 수치 필드 (server_* 등 결과에만 기록되는 값은 제외)
+const metric_field_t METRIC_FIELDS[] = {
+    FIELD(t_handshake_total_ms, METRIC_DOUBLE),
+    FIELD(t_clienthello_to_serverhello_ms, METRIC_DOUBLE),
+    FIELD(t_cert_verify_ms, METRIC_DOUBLE),
+    FIELD(t_finished_flight_ms, METRIC_DOUBLE),
+    FIELD(t_hello_retry_ms, METRIC_DOUBLE),
+    FIELD(rtt_ms, METRIC_DOUBLE),
+    FIELD(traffic.bytes_tx_handshake, METRIC_U64),
+    FIELD(traffic.bytes_rx_handshake, METRIC_U64),
+    FIELD(traffic.records_count, METRIC_U32),
+    FIELD(traffic.packets_count, METRIC_U32),
+    FIELD(traffic.retransmits, METRIC_U32),
+    FIELD(traffic.segs_out, METRIC_U32),
+    FIELD(traffic.segs_in, METRIC_U32),
+    FIELD(traffic.snd_cwnd, METRIC_U32),
+    FIELD(traffic.snd_mss, METRIC_U32),
+    FIELD(traffic.tcp_rtt_us, METRIC_U32),
+    FIELD(traffic.server_flight_bytes, METRIC_U32),
+    FIELD(traffic.server_flight_rounds, METRIC_U32),
+    FIELD(traffic.msg_bytes.client_hello, METRIC_U32),
+    FIELD(traffic.msg_bytes.server_hello, METRIC_U32),
+    FIELD(traffic.msg_bytes.encrypted_extensions, METRIC_U32),
+    FIELD(traffic.msg_bytes.certificate_request, METRIC_U32),
+    FIELD(traffic.msg_bytes.server_certificate, METRIC_U32),
+    FIELD(traffic.msg_bytes.server_certificate_verify, METRIC_U32),
+    FIELD(traffic.msg_bytes.server_finished, METRIC_U32),
+    FIELD(traffic.msg_bytes.client_certificate, METRIC_U32),
+    FIELD(traffic.msg_bytes.client_certificate_verify, METRIC_U32),
+    FIELD(traffic.msg_bytes.client_finished, METRIC_U32),
+    FIELD(traffic.msg_bytes.server_certificate_uncompressed, METRIC_U32),
+    FIELD(traffic.msg_bytes.client_certificate_uncompressed, METRIC_U32),
+    FIELD(traffic.msg_bytes.client_hello_initial, METRIC_U32),
+    FIELD(traffic.msg_bytes.hello_retry_request, METRIC_U32),
+    FIELD(crypto.kem_keyshare_len, METRIC_U32),
+    FIELD(crypto.kem_ciphertext_len, METRIC_U32),
+    FIELD(crypto.kem_keygen_ms, METRIC_DOUBLE),
+    FIELD(crypto.kem_encap_ms_client, METRIC_DOUBLE),
+    FIELD(crypto.kem_encap_ms_server, METRIC_DOUBLE),
+    FIELD(crypto.kem_decap_ms_client, METRIC_DOUBLE),
+    FIELD(crypto.kem_decap_ms_server, METRIC_DOUBLE),
+    FIELD(crypto.sig_len, METRIC_U32),
+    FIELD(crypto.sign_ms_server, METRIC_DOUBLE),
+    FIELD(crypto.sign_ms_client, METRIC_DOUBLE),
+    FIELD(crypto.verify_ms_server, METRIC_DOUBLE),
+    FIELD(crypto.verify_ms_client, METRIC_DOUBLE),
+    FIELD(crypto.cert_chain_size_excluding_root, METRIC_U32),
+    FIELD(crypto.cert_chain_size_including_root, METRIC_U32),
+    FIELD(crypto.key_shares_offered, METRIC_U32),
+    FIELD(crypto.hello_retry, METRIC_BOOL),
+    FIELD(resources.peak_heap_bytes, METRIC_U64),
+    FIELD(resources.heap_retained_bytes, METRIC_U64),
+    FIELD(resources.heap_allocs, METRIC_U64),
+    FIELD(resources.stack_usage_bytes, METRIC_U64),
+    FIELD(resources.cpu_cycles, METRIC_U64),
+    FIELD(resources.instructions, METRIC_U64),
+    FIELD(resources.cache_misses, METRIC_U64),
+    FIELD(resources.branch_misses, METRIC_U64),
+    FIELD(resources.task_clock_ns, METRIC_U64),
+    FIELD(resources.cpu_time_ns, METRIC_U64),
+    FIELD(resources.energy_mJ, METRIC_DOUBLE),
+    FIELD(reliability.session_resumption_ok, METRIC_BOOL),
+    FIELD(reliability.t_resumption_ms, METRIC_DOUBLE),
+    FIELD(reliability.psk_ke_ok, METRIC_BOOL),
+    FIELD(reliability.t_resumption_psk_ke_ms, METRIC_DOUBLE),
+    FIELD(reliability.zero_rtt_ok, METRIC_BOOL),
+    FIELD(reliability.t_0rtt_ms, METRIC_DOUBLE),
+};
+
+#undef FIELD
+
+const int METRIC_FIELD_COUNT = sizeof(METRIC_FIELDS) / sizeof(METRIC_FIELDS[0]);
+
+_Static_assert(sizeof(METRIC_FIELDS) / sizeof(METRIC_FIELDS[0]) <= METRIC_FIELD_MAX,
+               "METRIC_FIELD_MAX too small");
+
+double metric_field_value(const handshake_metrics_t *metrics, const metric_field_t *field) {
+    const char *p = (const char*)metrics + field->offset;
+    switch (field->type) {
+    case METRIC_U32:
+        return *(const uint32_t*)p;
+    case METRIC_U64:
+        return (double)*(const uint64_t*)p;
+    case METRIC_DOUBLE:
+        return *(const double*)p;
+    case METRIC_BOOL:
+        return *(const bool*)p ? 1.0 : 0.0;
     }
-    stats->stddev = sqrt(variance / count);
-    
-    free(sorted);
+    return 0.0;
+}
+
+// 메시지별 크기 필드 (평균 계산용, 필드를 추가하면 여기에도 추가)
+static const size_t MSG_BYTES_FIELDS[] = {
+    offsetof(message_bytes_t, client_hello),
+    offsetof(message_bytes_t, server_hello),
+    offsetof(message_bytes_t, encrypted_extensions),
+    offsetof(message_bytes_t, certificate_request),
+    offsetof(message_bytes_t, server_certificate),
+    offsetof(message_bytes_t, server_certificate_verify),
+    offsetof(message_bytes_t, server_finished),
+    offsetof(message_bytes_t, client_certificate),
+    offsetof(message_bytes_t, client_certificate_verify),
+    offsetof(message_bytes_t, client_finished),
+    offsetof(message_bytes_t, server_certificate_uncompressed),
+    offsetof(message_bytes_t, client_certificate_uncompressed),
+    offsetof(message_bytes_t, client_hello_initial),
+    offsetof(message_bytes_t, hello_retry_request),
+};
+
+#define MSG_BYTES_FIELD_COUNT (sizeof(MSG_BYTES_FIELDS) / sizeof(MSG_BYTES_FIELDS[0]))
+
+_Static_assert(MSG_BYTES_FIELD_COUNT * sizeof(uint32_t) == sizeof(message_bytes_t),
+               "MSG_BYTES_FIELDS out of sync with message_bytes_t");
+
+static uint32_t* msg_bytes_field(message_bytes_t *mb, size_t k) {
+    return (uint32_t*)((char*)mb + MSG_BYTES_FIELDS[k]);
 }
 
 // 메트릭 초기화
@@ -69,82 +163,171 @@ void init_benchmark_result(benchmark_result_t *result) {
     memset(result, 0, sizeof(benchmark_result_t));
 }
 
+void free_benchmark_result(benchmark_result_t *result) {
+    free(result->latency_hist);
+    result->latency_hist = NULL;
+}
+
 // 메트릭 집계
 void aggregate_metrics(handshake_metrics_t *metrics, int count, benchmark_result_t *result) {
     result->total_runs = count;
     result->successful_runs = 0;
     
-    // 시간 메트릭용 배열
-    double *t_total = malloc(count * sizeof(double));
-    double *t_ch_to_sh = malloc(count * sizeof(double));
-    double *t_cert_verify = malloc(count * sizeof(double));
-    double *t_finished = malloc(count * sizeof(double));
-    
     int valid_count = 0;
     
     // 트래픽, 암호화, 리소스 메트릭 평균 계산
     uint64_t total_bytes_tx = 0, total_bytes_rx = 0;
     uint32_t total_records = 0, total_packets = 0, total_retransmits = 0;
-    uint64_t total_heap = 0, total_stack = 0, total_cycles = 0;
+    uint64_t total_segs_out = 0, total_segs_in = 0, total_cwnd = 0, total_mss = 0, total_tcp_rtt = 0;
+    uint64_t total_flight_bytes = 0, total_flight_rounds = 0;
+    uint64_t total_msg[MSG_BYTES_FIELD_COUNT] = {0};
+    uint64_t total_heap = 0, total_retained = 0, total_allocs = 0, total_stack = 0, total_cycles = 0;
+    uint64_t total_instructions = 0, total_cache_misses = 0, total_branch_misses = 0;
+    uint64_t total_task_clock = 0, total_cpu_time = 0;
     double total_energy = 0.0;
     
     for (int i = 0; i < count; i++) {
         if (metrics[i].success) {
             result->successful_runs++;
-            
-            t_total[valid_count] = metrics[i].t_handshake_total_ms;
-            t_ch_to_sh[valid_count] = metrics[i].t_clienthello_to_serverhello_ms;
-            t_cert_verify[valid_count] = metrics[i].t_cert_verify_ms;
-            t_finished[valid_count] = metrics[i].t_finished_flight_ms;
             valid_count++;
+            if (metrics[i].crypto.hello_retry) {
+                result->hello_retry_runs++;
+            }
             
             total_bytes_tx += metrics[i].traffic.bytes_tx_handshake;
             total_bytes_rx += metrics[i].traffic.bytes_rx_handshake;
             total_records += metrics[i].traffic.records_count;
             total_packets += metrics[i].traffic.packets_count;
             total_retransmits += metrics[i].traffic.retransmits;
+            total_segs_out += metrics[i].traffic.segs_out;
+            total_segs_in += metrics[i].traffic.segs_in;
+            total_cwnd += metrics[i].traffic.snd_cwnd;
+            total_mss += metrics[i].traffic.snd_mss;
+            total_tcp_rtt += metrics[i].traffic.tcp_rtt_us;
+            total_flight_bytes += metrics[i].traffic.server_flight_bytes;
+            total_flight_rounds += metrics[i].traffic.server_flight_rounds;
+            
+            // 메시지별 크기
+            for (size_t k = 0; k < MSG_BYTES_FIELD_COUNT; k++) {
+                total_msg[k] += *msg_bytes_field(&metrics[i].traffic.msg_bytes, k);
+            }
             
             total_heap += metrics[i].resources.peak_heap_bytes;
+            total_retained += metrics[i].resources.heap_retained_bytes;
+            total_allocs += metrics[i].resources.heap_allocs;
             total_stack += metrics[i].resources.stack_usage_bytes;
             total_cycles += metrics[i].resources.cpu_cycles;
+            total_instructions += metrics[i].resources.instructions;
+            total_cache_misses += metrics[i].resources.cache_misses;
+            total_branch_misses += metrics[i].resources.branch_misses;
+            total_task_clock += metrics[i].resources.task_clock_ns;
+            total_cpu_time += metrics[i].resources.cpu_time_ns;
             total_energy += metrics[i].resources.energy_mJ;
         }
     }
     
-    // 통계 계산
-    if (valid_count > 0) {
-        calculate_stats(t_total, valid_count, &result->t_handshake_total_ms);
-        calculate_stats(t_ch_to_sh, valid_count, &result->t_clienthello_to_serverhello_ms);
-        calculate_stats(t_cert_verify, valid_count, &result->t_cert_verify_ms);
-        calculate_stats(t_finished, valid_count, &result->t_finished_flight_ms);
+    // 필드별 통계: 힙의 히스토그램 1개를 재사용, 전체 레이턴시 분포만 결과에 보관 (할당 실패 시 통계 생략)
+    histogram_t *hist = malloc(sizeof(histogram_t));
+    for (int f = 0; hist && f < METRIC_FIELD_COUNT; f++) {
+        hist_reset(hist);
+        for (int i = 0; i < count; i++) {
+            if (metrics[i].success) {
+                hist_record(hist, metric_field_value(&metrics[i], &METRIC_FIELDS[f]));
+            }
+        }
+        hist_stats(hist, &result->field_stats[f]);
         
+        if (METRIC_FIELDS[f].offset == offsetof(handshake_metrics_t, t_handshake_total_ms)) {
+            result->t_handshake_total_ms = result->field_stats[f];
+            if (!result->latency_hist) {
+                result->latency_hist = malloc(sizeof(histogram_t));
+            }
+            if (result->latency_hist) {
+                *result->latency_hist = *hist;
+            }
+        } else if (METRIC_FIELDS[f].offset == offsetof(handshake_metrics_t, t_clienthello_to_serverhello_ms)) {
+            result->t_clienthello_to_serverhello_ms = result->field_stats[f];
+        } else if (METRIC_FIELDS[f].offset == offsetof(handshake_metrics_t, t_cert_verify_ms)) {
+            result->t_cert_verify_ms = result->field_stats[f];
+        } else if (METRIC_FIELDS[f].offset == offsetof(handshake_metrics_t, t_finished_flight_ms)) {
+            result->t_finished_flight_ms = result->field_stats[f];
+        } else if (METRIC_FIELDS[f].offset == offsetof(handshake_metrics_t, t_hello_retry_ms)) {
+            result->t_hello_retry_ms = result->field_stats[f];
+        }
+    }
+    free(hist);
+    
+    if (valid_count > 0) {
         // 평균값
         result->traffic_avg.bytes_tx_handshake = total_bytes_tx / valid_count;
         result->traffic_avg.bytes_rx_handshake = total_bytes_rx / valid_count;
         result->traffic_avg.records_count = total_records / valid_count;
         result->traffic_avg.packets_count = total_packets / valid_count;
         result->traffic_avg.retransmits = total_retransmits / valid_count;
+        result->traffic_avg.segs_out = total_segs_out / valid_count;
+        result->traffic_avg.segs_in = total_segs_in / valid_count;
+        result->traffic_avg.snd_cwnd = total_cwnd / valid_count;
+        result->traffic_avg.snd_mss = total_mss / valid_count;
+        result->traffic_avg.tcp_rtt_us = total_tcp_rtt / valid_count;
+        result->traffic_avg.server_flight_bytes = total_flight_bytes / valid_count;
+        result->traffic_avg.server_flight_rounds = total_flight_rounds / valid_count;
+        for (size_t k = 0; k < MSG_BYTES_FIELD_COUNT; k++) {
+            *msg_bytes_field(&result->traffic_avg.msg_bytes, k) = total_msg[k] / valid_count;
+        }
         
         result->resources_avg.peak_heap_bytes = total_heap / valid_count;
+        result->resources_avg.heap_retained_bytes = total_retained / valid_count;
+        result->resources_avg.heap_allocs = total_allocs / valid_count;
         result->resources_avg.stack_usage_bytes = total_stack / valid_count;
         result->resources_avg.cpu_cycles = total_cycles / valid_count;
+        result->resources_avg.instructions = total_instructions / valid_count;
+        result->resources_avg.cache_misses = total_cache_misses / valid_count;
+        result->resources_avg.branch_misses = total_branch_misses / valid_count;
+        result->resources_avg.task_clock_ns = total_task_clock / valid_count;
+        result->resources_avg.cpu_time_ns = total_cpu_time / valid_count;
         result->resources_avg.energy_mJ = total_energy / valid_count;
         
         // 성공률
         result->reliability_avg.success_rate = (double)result->successful_runs / result->total_runs;
     }
     
-    // 첫 번째 성공한 실행의 암호화 메트릭 사용
+    // 암호화 메트릭: 크기는 첫 번째 성공한 실행, 연산 시간은 평균
+    crypto_metrics_t crypto_sum;
+    memset(&crypto_sum, 0, sizeof(crypto_sum));
+    bool have_sizes = false;
+    
     for (int i = 0; i < count; i++) {
-        if (metrics[i].success) {
-            result->crypto_avg = metrics[i].crypto;
-            break;
+        if (!metrics[i].success) {
+            continue;
+        }
+        const crypto_metrics_t *c = &metrics[i].crypto;
+        if (!have_sizes) {
+            crypto_sum = *c;
+            have_sizes = true;
+            continue;
         }
+        crypto_sum.kem_keygen_ms += c->kem_keygen_ms;
+        crypto_sum.kem_encap_ms_client += c->kem_encap_ms_client;
+        crypto_sum.kem_encap_ms_server += c->kem_encap_ms_server;
+        crypto_sum.kem_decap_ms_client += c->kem_decap_ms_client;
+        crypto_sum.kem_decap_ms_server += c->kem_decap_ms_server;
+        crypto_sum.sign_ms_server += c->sign_ms_server;
+        crypto_sum.sign_ms_client += c->sign_ms_client;
+        crypto_sum.verify_ms_server += c->verify_ms_server;
+        crypto_sum.verify_ms_client += c->verify_ms_client;
     }
     
-    free(t_total);
-    free(t_ch_to_sh);
-    free(t_cert_verify);
-    free(t_finished);
+    if (valid_count > 0) {
+        crypto_sum.kem_keygen_ms /= valid_count;
+        crypto_sum.kem_encap_ms_client /= valid_count;
+        crypto_sum.kem_encap_ms_server /= valid_count;
+        crypto_sum.kem_decap_ms_client /= valid_count;
+        crypto_sum.kem_decap_ms_server /= valid_count;
+        crypto_sum.sign_ms_server /= valid_count;
+        crypto_sum.sign_ms_client /= valid_count;
+        crypto_sum.verify_ms_server /= valid_count;
+        crypto_sum.verify_ms_client /= valid_count;
+    }
+    result->crypto_avg = crypto_sum;
 }
 
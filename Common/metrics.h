@@ -2,6 +2,7 @@
 #define METRICS_H
 
 #include <stdint.h>
+#include <stddef.h>
 #include <stdbool.h>
 #include <time.h>
 
@@ -9,20 +10,27 @@
 typedef struct {
     struct timespec start;
     struct timespec end;
-} timer_t;
+} bench_timer_t;
 
-// 통계 구조체
+// 통계 구조체 (백분위수는 histogram_t 기반 보간값)
 typedef struct {
     double mean;
     double p50;
     double p90;
     double p99;
+    double p999;
+    double p9999;
+    double min;
+    double max;
     double stddev;
+    uint64_t count;
 } stats_t;
 
 // 암호화 메트릭
 typedef struct {
-    uint32_t kem_keyshare_len;
+    uint32_t kem_keyshare_len;      // ClientHello key_share (KEM 공개키)
+    uint32_t kem_ciphertext_len;    // ServerHello key_share (KEM 암호문)
+    double kem_keygen_ms;           // 클라이언트 임시 키 생성
     double kem_encap_ms_client;
     double kem_encap_ms_server;
     double kem_decap_ms_client;
@@ -34,22 +42,64 @@ typedef struct {
     double verify_ms_client;
     uint32_t cert_chain_size_excluding_root;
     uint32_t cert_chain_size_including_root;
+    uint32_t cert_comp_alg;         // 서버 Certificate 압축 알고리즘 (RFC 8879, 0 = 비압축)
+    double cert_compress_ms;        // 서버 체인 1회 압축 (bench_driver 조합별 측정)
+    double cert_decompress_ms;
+    uint32_t key_shares_offered;    // 첫 ClientHello가 보낸 key_share 수
+    bool hello_retry;               // 서버가 HelloRetryRequest로 다른 그룹을 요구
 } crypto_metrics_t;
 
+// 핸드셰이크 메시지별 크기 (메시지 헤더 4바이트 포함, 레코드 오버헤드 제외)
+typedef struct {
+    uint32_t client_hello;
+    uint32_t server_hello;
+    uint32_t encrypted_extensions;
+    uint32_t certificate_request;
+    uint32_t server_certificate;
+    uint32_t server_certificate_verify;
+    uint32_t server_finished;
+    uint32_t client_certificate;
+    uint32_t client_certificate_verify;
+    uint32_t client_finished;
+    uint32_t server_certificate_uncompressed;   // 압축 전 Certificate 크기 (비압축이면 server_certificate와 같음)
+    uint32_t client_certificate_uncompressed;
+    uint32_t client_hello_initial;  // HRR 전 첫 ClientHello (HRR 없으면 0, client_hello는 두 번째)
+    uint32_t hello_retry_request;
+} message_bytes_t;
+
 // 트래픽 메트릭
 typedef struct {
     uint64_t bytes_tx_handshake;
     uint64_t bytes_rx_handshake;
     uint32_t records_count;
-    uint32_t packets_count;
+    uint32_t packets_count;         // TCP 세그먼트 송수신 합 (TCP_INFO, 핸드셰이크 구간)
     uint32_t retransmits;
+    uint32_t segs_out;
+    uint32_t segs_in;
+    uint32_t snd_cwnd;              // 핸드셰이크 시작 시 혼잡 윈도 (세그먼트)
+    uint32_t snd_mss;
+    uint32_t tcp_rtt_us;            // 핸드셰이크 종료 시 커널 RTT 추정
+    uint32_t server_flight_bytes;   // 서버 첫 비행 와이어 바이트 추정
+    uint32_t server_flight_rounds;  // 그 비행이 슬로 스타트로 필요한 왕복 수
+    message_bytes_t msg_bytes;
 } traffic_metrics_t;
 
-// 리소스 메트릭
+// 리소스 메트릭 (하드웨어 카운터는 측정한 쪽 스레드 기준, 핸드셰이크 구간만)
 typedef struct {
-    uint64_t peak_heap_bytes;
+    uint64_t peak_heap_bytes;       // 연결 계정 기준 핸드셰이크 중 최대 OpenSSL 힙 (mem_track)
+    uint64_t heap_retained_bytes;   // 핸드셰이크 완료 후에도 연결이 유지하는 바이트
+    uint64_t heap_allocs;           // 핸드셰이크 중 할당 호출 수
     uint64_t stack_usage_bytes;
     uint64_t cpu_cycles;
+    uint64_t instructions;
+    uint64_t cache_misses;
+    uint64_t branch_misses;
+    uint64_t task_clock_ns;
+    uint64_t cpu_time_ns;           // CLOCK_THREAD_CPUTIME_ID
+    uint64_t server_cpu_cycles;     // 서버 엔진 핸드셰이크당 평균 (bench_driver)
+    uint64_t server_cpu_time_ns;
+    uint64_t server_peak_heap_bytes;
+    uint64_t server_heap_retained_bytes;
     double energy_mJ;
 } resource_metrics_t;
 
@@ -59,9 +109,11 @@ typedef struct {
     int alert_codes[16];
     int alert_count;
     bool session_resumption_ok;
-    double t_resumption_ms;
+    double t_resumption_ms;         // psk_dhe_ke 재개 핸드셰이크
+    bool psk_ke_ok;
+    double t_resumption_psk_ke_ms;  // psk_ke 재개 핸드셰이크 (키 교환 없음)
     bool zero_rtt_ok;
-    double t_0rtt_ms;
+    double t_0rtt_ms;               // early data 요청 → 응답
 } reliability_metrics_t;
 
 // 핸드셰이크 메트릭 (단일 실행)
@@ -70,6 +122,7 @@ typedef struct {
     double t_clienthello_to_serverhello_ms;
     double t_cert_verify_ms;
     double t_finished_flight_ms;
+    double t_hello_retry_ms;        // HRR 추가 왕복 (handshake_trace.h)
     double rtt_ms;
     
     traffic_metrics_t traffic;
@@ -81,6 +134,38 @@ typedef struct {
     char error_msg[256];
 } handshake_metrics_t;
 
+// handshake_metrics_t의 수치 필드 설명 (필드 전체 통계용)
+typedef enum {
+    METRIC_U32,
+    METRIC_U64,
+    METRIC_DOUBLE,
+    METRIC_BOOL
+} metric_type_t;
+
+typedef struct {
+    const char *name;       // 점 경로 (예: "traffic.msg_bytes.server_certificate")
+    size_t offset;
+    metric_type_t type;
+} metric_field_t;
+
+#define METRIC_FIELD_MAX 80
+
+extern const metric_field_t METRIC_FIELDS[];
+extern const int METRIC_FIELD_COUNT;
+
+double metric_field_value(const handshake_metrics_t *metrics, const metric_field_t *field);
+
+struct histogram;
+
+// 핸드셰이크와 분리한 EVP 단일 연산 시간 (bench_driver 조합별, 측정하지 않으면 모두 0)
+typedef struct {
+    double kem_keygen_ms;   // 클라이언트 임시 키 생성
+    double kem_encap_ms;    // 서버
+    double kem_decap_ms;    // 클라이언트
+    double sign_ms;         // CertificateVerify 서명 (양쪽 같은 알고리즘)
+    double verify_ms;
+} prim_timings_t;
+
 // 벤치마크 결과 (N회 실행 집계)
 typedef struct {
     char group[64];
@@ -90,26 +175,33 @@ typedef struct {
     stats_t t_clienthello_to_serverhello_ms;
     stats_t t_cert_verify_ms;
     stats_t t_finished_flight_ms;
+    stats_t t_hello_retry_ms;
     
     traffic_metrics_t traffic_avg;
     crypto_metrics_t crypto_avg;
     resource_metrics_t resources_avg;
     reliability_metrics_t reliability_avg;
+    prim_timings_t prim_ms;     // crypto_avg(핸드셰이크 집계)와 별도
     
     int total_runs;
     int successful_runs;
+    int hello_retry_runs;       // HRR이 발생한 성공 실행 수
+    
+    stats_t field_stats[METRIC_FIELD_MAX];  // METRIC_FIELDS 순서, 성공한 실행만
+    struct histogram *latency_hist;         // t_handshake_total_ms 분포 (free_benchmark_result로 해제)
 } benchmark_result_t;
 
 // 타이머 함수
-void start_timer(timer_t *timer);
-double end_timer(timer_t *timer);
+void start_timer(bench_timer_t *timer);
+double end_timer(bench_timer_t *timer);
 
-// 통계 계산
+// 통계 계산 (정렬 없이 히스토그램 1개로 계산)
 void calculate_stats(double *values, int count, stats_t *stats);
 
 // 메트릭 초기화
 void init_handshake_metrics(handshake_metrics_t *metrics);
 void init_benchmark_result(benchmark_result_t *result);
+void free_benchmark_result(benchmark_result_t *result);
 
 // 메트릭 집계
 void aggregate_metrics(handshake_metrics_t *metrics, int count, benchmark_result_t *result);
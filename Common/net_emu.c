@@ -0,0 +1,457 @@
+#define _GNU_SOURCE
+#include "net_emu.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <sys/socket.h>
+#include <netinet/tcp.h>
+
+#define EMU_MAX_EVENTS 64
+#define EMU_READ_SIZE 65536
+#define EMU_MAX_QUEUED (4 * 1024 * 1024)    // 방향별 큐 상한 (넘으면 읽기 중단 → 송신 측 TCP 흐름 제어)
+#define EMU_HEADER_BYTES 40                 // IPv4 + TCP 헤더 (옵션 제외)
+#define EMU_MIN_RTO_MS 200.0                // Linux TCP_RTO_MIN
+
+// 전달 대기 세그먼트 (due_ns에 목적지 소켓으로 씀)
+typedef struct segment {
+    uint64_t due_ns;
+    uint32_t len;
+    uint32_t off;               // 부분 전송된 바이트
+    struct segment *next;
+    unsigned char data[];
+} segment_t;
+
+// 한 방향 링크 (src에서 읽어 지연 후 dst로 씀)
+typedef struct {
+    int src;
+    int dst;
+    segment_t *head;
+    segment_t *tail;
+    size_t queued;
+    uint64_t link_free_ns;      // 직렬화 중인 마지막 세그먼트가 링크를 비우는 시각
+    uint64_t last_due_ns;       // TCP는 순서대로 전달하므로 도착 시각은 단조 증가
+    uint32_t cwnd;              // 슬로 스타트 모델: 현재 왕복에 보낼 수 있는 세그먼트 수
+    uint32_t round_sent;
+    uint64_t round_ns;          // 현재 왕복 첫 세그먼트가 링크에 오른 시각
+    bool eof;                   // src가 닫힘 (큐를 비운 뒤 dst에 FIN 전달)
+    bool shut;
+} flow_t;
+
+struct relay;
+
+// epoll 등록 단위 (리스너/타이머/깨우기는 relay NULL)
+typedef struct {
+    struct relay *relay;
+    int side;
+} endpoint_t;
+
+typedef struct relay {
+    int fd[2];                  // 0: 클라이언트 쪽, 1: 서버(upstream) 쪽
+    flow_t flow[2];             // flow[i]: fd[i]에서 읽어 반대쪽으로 전달
+    endpoint_t ep[2];
+    uint32_t events[2];         // 현재 epoll 관심 이벤트
+    struct relay *prev;
+    struct relay *next;
+} relay_t;
+
+struct net_emu {
+    net_emu_config_t config;
+    struct sockaddr_in upstream;
+    int listen_fd;
+    int epfd;
+    int timer_fd;
+    int wake_fd;
+    endpoint_t listen_ep;
+    endpoint_t timer_ep;
+    endpoint_t wake_ep;
+    pthread_t thread;
+    atomic_int stop;
+    relay_t *relays;
+    uint32_t segment;
+    uint64_t delay_ns;
+    uint64_t rto_ns;
+    unsigned int rng;
+    net_emu_stats_t stats;
+};
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+bool net_emu_enabled(const net_emu_config_t *config) {
+    return config->delay_ms > 0 || config->bandwidth_mbps > 0 || config->loss_pct > 0 || config->initcwnd > 0 ||
+           (config->mtu > 0 && config->mtu != NET_EMU_DEFAULT_MTU);
+}
+
+uint32_t net_emu_segment_size(const net_emu_config_t *config) {
+    int mtu = config->mtu > 0 ? config->mtu : NET_EMU_DEFAULT_MTU;
+    return mtu > EMU_HEADER_BYTES * 2 ? (uint32_t)(mtu - EMU_HEADER_BYTES) : EMU_HEADER_BYTES;
+}
+
+void net_emu_describe(const net_emu_config_t *config, char *buf, size_t len) {
+    char bw[32];
+    if (config->bandwidth_mbps > 0) {
+        snprintf(bw, sizeof(bw), "%.1f Mbit/s", config->bandwidth_mbps);
+    } else {
+        snprintf(bw, sizeof(bw), "unlimited");
+    }
+    char cwnd[32] = "";
+    if (config->initcwnd > 0) {
+        snprintf(cwnd, sizeof(cwnd), ", initcwnd %d", config->initcwnd);
+    }
+    snprintf(buf, len, "rtt %.1f ms, %s, mtu %d (segment %u B), loss %.2f%%%s",
+             config->delay_ms * 2, bw, config->mtu > 0 ? config->mtu : NET_EMU_DEFAULT_MTU,
+             net_emu_segment_size(config), config->loss_pct, cwnd);
+}
+
+// 지연된 세그먼트 사이에 Nagle이 끼어들지 않도록 즉시 전송
+static void set_socket_options(int fd) {
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+}
+
+static void epoll_set(struct net_emu *emu, relay_t *r, int side, uint32_t events) {
+    if (r->events[side] == events) {
+        return;
+    }
+    struct epoll_event ev = { .events = events, .data.ptr = &r->ep[side] };
+    epoll_ctl(emu->epfd, EPOLL_CTL_MOD, r->fd[side], &ev);
+    r->events[side] = events;
+}
+
+static void relay_close(struct net_emu *emu, relay_t *r) {
+    for (int side = 0; side < 2; side++) {
+        epoll_ctl(emu->epfd, EPOLL_CTL_DEL, r->fd[side], NULL);
+        close(r->fd[side]);
+        segment_t *s = r->flow[side].head;
+        while (s) {
+            segment_t *next = s->next;
+            free(s);
+            s = next;
+        }
+    }
+    if (r->prev) r->prev->next = r->next;
+    else emu->relays = r->next;
+    if (r->next) r->next->prev = r->prev;
+    free(r);
+}
+
+// 읽은 바이트를 세그먼트로 나눠 도착 시각 예약
+//  - 직렬화: 링크가 비는 시각부터 len × 8 / bandwidth
+//  - 전파: + delay, 손실: + RTO (뒤 세그먼트도 순서 유지를 위해 함께 대기)
+//  - 혼잡 윈도: cwnd개를 보낸 뒤에는 그 왕복 첫 세그먼트의 ACK(RTT 후)까지 대기, cwnd 2배
+static bool flow_schedule(struct net_emu *emu, flow_t *f, const unsigned char *data, size_t len, uint64_t now) {
+    while (len > 0) {
+        uint32_t n = len < emu->segment ? (uint32_t)len : emu->segment;
+        segment_t *s = malloc(sizeof(segment_t) + n);
+        if (!s) {
+            return false;
+        }
+        memcpy(s->data, data, n);
+        s->len = n;
+        s->off = 0;
+        s->next = NULL;
+
+        uint64_t start = f->link_free_ns > now ? f->link_free_ns : now;
+        if (emu->config.initcwnd > 0) {
+            // 유휴(RTO 이상) 후에는 초기 윈도로 재시작 (Linux slow start after idle)
+            if (f->cwnd == 0 || now > f->last_due_ns + emu->rto_ns) {
+                f->cwnd = (uint32_t)emu->config.initcwnd;
+                f->round_sent = 0;
+            } else if (f->round_sent >= f->cwnd) {
+                uint64_t acked = f->round_ns + 2 * emu->delay_ns;
+                start = acked > start ? acked : start;
+                f->cwnd *= 2;
+                f->round_sent = 0;
+            }
+            if (f->round_sent++ == 0) {
+                f->round_ns = start;
+            }
+        }
+        uint64_t tx_ns = emu->config.bandwidth_mbps > 0
+            ? (uint64_t)((n + EMU_HEADER_BYTES) * 8.0 * 1000.0 / emu->config.bandwidth_mbps) : 0;
+        f->link_free_ns = start + tx_ns;
+
+        uint64_t due = f->link_free_ns + emu->delay_ns;
+        if (emu->config.loss_pct > 0 &&
+            rand_r(&emu->rng) < emu->config.loss_pct / 100.0 * ((double)RAND_MAX + 1.0)) {
+            due += emu->rto_ns;
+            emu->stats.lost++;
+        }
+        if (due < f->last_due_ns) {
+            due = f->last_due_ns;
+        }
+        f->last_due_ns = due;
+        s->due_ns = due;
+
+        if (f->tail) f->tail->next = s;
+        else f->head = s;
+        f->tail = s;
+        f->queued += n;
+
+        data += n;
+        len -= n;
+    }
+    return true;
+}
+
+// src에서 읽을 수 있는 만큼 읽기 (false: 연결 오류)
+static bool flow_read(struct net_emu *emu, flow_t *f) {
+    unsigned char buf[EMU_READ_SIZE];
+
+    while (!f->eof && f->queued < EMU_MAX_QUEUED) {
+        ssize_t n = recv(f->src, buf, sizeof(buf), 0);
+        if (n > 0) {
+            if (!flow_schedule(emu, f, buf, (size_t)n, now_ns())) {
+                return false;
+            }
+            continue;
+        }
+        if (n == 0) {
+            f->eof = true;
+            break;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        }
+        if (errno != EINTR) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 도착 시각이 된 세그먼트를 dst로 전달 (false: 연결 오류)
+static bool flow_deliver(struct net_emu *emu, flow_t *f, uint64_t now, bool *blocked) {
+    *blocked = false;
+    while (f->head && f->head->due_ns <= now) {
+        segment_t *s = f->head;
+        ssize_t n = send(f->dst, s->data + s->off, s->len - s->off, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+                *blocked = true;
+                return true;
+            }
+            return false;
+        }
+        s->off += (uint32_t)n;
+        if (s->off < s->len) {
+            *blocked = true;
+            return true;
+        }
+
+        f->head = s->next;
+        if (!f->head) f->tail = NULL;
+        f->queued -= s->len;
+        emu->stats.segments++;
+        emu->stats.bytes += s->len;
+        free(s);
+    }
+    if (!f->head && f->eof && !f->shut) {
+        shutdown(f->dst, SHUT_WR);
+        f->shut = true;
+    }
+    return true;
+}
+
+// 만료 세그먼트 전달, epoll 관심 이벤트 갱신, 다음 타이머 시각 계산
+static void relays_service(struct net_emu *emu) {
+    uint64_t now = now_ns();
+    uint64_t next_due = UINT64_MAX;
+
+    relay_t *r = emu->relays;
+    while (r) {
+        relay_t *next = r->next;
+        bool blocked[2] = {false, false};
+        bool ok = flow_deliver(emu, &r->flow[0], now, &blocked[0]) &&
+                  flow_deliver(emu, &r->flow[1], now, &blocked[1]);
+
+        if (!ok || (r->flow[0].shut && r->flow[1].shut)) {
+            relay_close(emu, r);
+            r = next;
+            continue;
+        }
+
+        for (int side = 0; side < 2; side++) {
+            flow_t *out = &r->flow[side];           // 이 소켓에서 읽는 방향
+            flow_t *in = &r->flow[1 - side];        // 이 소켓으로 쓰는 방향
+            uint32_t events = 0;
+            if (!out->eof && out->queued < EMU_MAX_QUEUED) events |= EPOLLIN;
+            if (blocked[1 - side]) events |= EPOLLOUT;
+            epoll_set(emu, r, side, events);
+
+            if (in->head && !blocked[1 - side] && in->head->due_ns < next_due) {
+                next_due = in->head->due_ns;
+            }
+        }
+        r = next;
+    }
+
+    // 다음 도착 시각에 깨어나도록 절대 시각 타이머 설정 (없으면 해제)
+    struct itimerspec its;
+    memset(&its, 0, sizeof(its));
+    if (next_due != UINT64_MAX) {
+        its.it_value.tv_sec = next_due / 1000000000ULL;
+        its.it_value.tv_nsec = next_due % 1000000000ULL;
+    }
+    timerfd_settime(emu->timer_fd, TFD_TIMER_ABSTIME, &its, NULL);
+}
+
+// 대기 중인 연결 수락 후 upstream에 연결
+static void accept_relays(struct net_emu *emu) {
+    for (;;) {
+        int client = accept4(emu->listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (client < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                perror("accept4");
+            }
+            return;
+        }
+
+        // upstream은 루프백이므로 블로킹 connect 후 논블로킹으로 전환
+        int server = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        relay_t *r = server >= 0 ? calloc(1, sizeof(relay_t)) : NULL;
+        if (!r || connect(server, (const struct sockaddr*)&emu->upstream, sizeof(emu->upstream)) < 0 ||
+            fcntl(server, F_SETFL, fcntl(server, F_GETFL, 0) | O_NONBLOCK) < 0) {
+            perror("net_emu upstream connect");
+            free(r);
+            if (server >= 0) close(server);
+            close(client);
+            continue;
+        }
+        set_socket_options(client);
+        set_socket_options(server);
+
+        r->fd[0] = client;
+        r->fd[1] = server;
+        for (int side = 0; side < 2; side++) {
+            r->flow[side].src = r->fd[side];
+            r->flow[side].dst = r->fd[1 - side];
+            r->ep[side] = (endpoint_t){ .relay = r, .side = side };
+            r->events[side] = EPOLLIN;
+            struct epoll_event ev = { .events = EPOLLIN, .data.ptr = &r->ep[side] };
+            epoll_ctl(emu->epfd, EPOLL_CTL_ADD, r->fd[side], &ev);
+        }
+
+        r->next = emu->relays;
+        if (emu->relays) emu->relays->prev = r;
+        emu->relays = r;
+        emu->stats.connections++;
+    }
+}
+
+static void* emu_main(void *arg) {
+    struct net_emu *emu = arg;
+    struct epoll_event events[EMU_MAX_EVENTS];
+
+    while (!atomic_load(&emu->stop)) {
+        int n = epoll_wait(emu->epfd, events, EMU_MAX_EVENTS, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            perror("epoll_wait");
+            break;
+        }
+
+        for (int i = 0; i < n; i++) {
+            endpoint_t *ep = events[i].data.ptr;
+            uint64_t ticks;
+            if (ep == &emu->listen_ep) {
+                accept_relays(emu);
+            } else if (ep == &emu->timer_ep) {
+                if (read(emu->timer_fd, &ticks, sizeof(ticks)) < 0) { /* 만료 횟수는 사용하지 않음 */ }
+            } else if (ep == &emu->wake_ep) {
+                if (read(emu->wake_fd, &ticks, sizeof(ticks)) < 0) { /* 정지 요청 */ }
+            } else if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                relay_t *r = ep->relay;
+                if ((events[i].events & EPOLLERR) || !flow_read(emu, &r->flow[ep->side])) {
+                    // 한쪽이 리셋되면 relays_service에서 양쪽 모두 닫음 (배치 도중에는 해제하지 않음)
+                    r->flow[0].eof = r->flow[1].eof = true;
+                    r->flow[0].shut = r->flow[1].shut = true;
+                }
+            }
+        }
+        relays_service(emu);
+    }
+
+    while (emu->relays) {
+        relay_close(emu, emu->relays);
+    }
+    return NULL;
+}
+
+net_emu_t* net_emu_start(const net_emu_config_t *config, int listen_fd, const struct sockaddr_in *upstream) {
+    if (fcntl(listen_fd, F_SETFL, fcntl(listen_fd, F_GETFL, 0) | O_NONBLOCK) < 0) {
+        perror("fcntl");
+        return NULL;
+    }
+
+    struct net_emu *emu = calloc(1, sizeof(struct net_emu));
+    if (!emu) {
+        return NULL;
+    }
+    emu->config = *config;
+    emu->upstream = *upstream;
+    emu->listen_fd = listen_fd;
+    emu->segment = net_emu_segment_size(config);
+    emu->delay_ns = (uint64_t)(config->delay_ms * 1e6);
+    double rto_ms = config->rto_ms > 0 ? config->rto_ms : config->delay_ms * 4;
+    emu->rto_ns = (uint64_t)((rto_ms > EMU_MIN_RTO_MS ? rto_ms : EMU_MIN_RTO_MS) * 1e6);
+    emu->rng = config->seed ? config->seed : 1;
+    atomic_init(&emu->stop, 0);
+
+    emu->listen_ep = (endpoint_t){ .relay = NULL, .side = -1 };
+    emu->timer_ep = (endpoint_t){ .relay = NULL, .side = -2 };
+    emu->wake_ep = (endpoint_t){ .relay = NULL, .side = -3 };
+
+    emu->epfd = epoll_create1(EPOLL_CLOEXEC);
+    emu->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    emu->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    struct epoll_event listen_ev = { .events = EPOLLIN, .data.ptr = &emu->listen_ep };
+    struct epoll_event timer_ev = { .events = EPOLLIN, .data.ptr = &emu->timer_ep };
+    struct epoll_event wake_ev = { .events = EPOLLIN, .data.ptr = &emu->wake_ep };
+
+    if (emu->epfd < 0 || emu->timer_fd < 0 || emu->wake_fd < 0 ||
+        epoll_ctl(emu->epfd, EPOLL_CTL_ADD, listen_fd, &listen_ev) < 0 ||
+        epoll_ctl(emu->epfd, EPOLL_CTL_ADD, emu->timer_fd, &timer_ev) < 0 ||
+        epoll_ctl(emu->epfd, EPOLL_CTL_ADD, emu->wake_fd, &wake_ev) < 0 ||
+        pthread_create(&emu->thread, NULL, emu_main, emu) != 0) {
+        perror("net_emu_start");
+        if (emu->epfd >= 0) close(emu->epfd);
+        if (emu->timer_fd >= 0) close(emu->timer_fd);
+        if (emu->wake_fd >= 0) close(emu->wake_fd);
+        free(emu);
+        return NULL;
+    }
+    return emu;
+}
+
+void net_emu_stop(net_emu_t *emu, net_emu_stats_t *stats) {
+    if (!emu) {
+        return;
+    }
+
+    atomic_store(&emu->stop, 1);
+    uint64_t one = 1;
+    if (write(emu->wake_fd, &one, sizeof(one)) < 0) {
+        perror("net_emu wake");
+    }
+    pthread_join(emu->thread, NULL);
+
+    if (stats) {
+        *stats = emu->stats;
+    }
+    close(emu->epfd);
+    close(emu->timer_fd);
+    close(emu->wake_fd);
+    free(emu);
+}
@@ -0,0 +1,47 @@
+#ifndef NET_EMU_H
+#define NET_EMU_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <netinet/in.h>
+
+// 사용자 공간 TCP 중계기로 흉내 내는 링크 특성 (tc netem 권한 없이 한 머신에서 WAN/모바일 재현)
+typedef struct {
+    double delay_ms;        // 방향별 단방향 지연 (RTT = 2 × delay_ms)
+    double bandwidth_mbps;  // 방향별 링크 속도 (0: 무제한), 세그먼트 직렬화 시간으로 반영
+    int mtu;                // 세그먼트 크기 = MTU - 40 (IPv4 + TCP 헤더)
+    double loss_pct;        // 세그먼트 손실 확률(%), 손실은 재전송 타임아웃만큼의 지연으로 모델
+    double rto_ms;          // 손실 시 추가 지연 (0: max(200, 2 × RTT))
+    int initcwnd;           // 송신 측 초기 혼잡 윈도(세그먼트), 왕복마다 2배 (0: 모델 없음)
+    unsigned int seed;      // 손실 난수 시드 (같은 시드면 같은 손실 패턴)
+} net_emu_config_t;
+
+#define NET_EMU_DEFAULT_MTU 1500
+
+// 중계 통계 (정지 시 수집)
+typedef struct {
+    uint64_t connections;
+    uint64_t segments;      // 전달한 세그먼트 (양방향)
+    uint64_t bytes;
+    uint64_t lost;          // 손실 처리(재전송 지연)한 세그먼트
+} net_emu_stats_t;
+
+typedef struct net_emu net_emu_t;
+
+// 지연/대역폭/손실/혼잡 윈도 중 하나라도 설정되었는지
+bool net_emu_enabled(const net_emu_config_t *config);
+
+// 세그먼트 페이로드 크기 (바이트)
+uint32_t net_emu_segment_size(const net_emu_config_t *config);
+
+// listen_fd로 받은 연결마다 upstream에 연결해 양방향 중계하는 스레드 시작 (실패 시 NULL)
+net_emu_t* net_emu_start(const net_emu_config_t *config, int listen_fd, const struct sockaddr_in *upstream);
+
+// 중계 스레드 정지, 남은 연결 정리 후 해제
+void net_emu_stop(net_emu_t *emu, net_emu_stats_t *stats);
+
+// 설정 한 줄 요약 ("rtt 50.0 ms, 10.0 Mbit/s, mtu 1500, loss 1.0%")
+void net_emu_describe(const net_emu_config_t *config, char *buf, size_t len);
+
+#endif // NET_EMU_H
@@ -0,0 +1,234 @@
+#include "pcap_writer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+#define PCAP_MAGIC 0xa1b2c3d4           // 마이크로초 타임스탬프
+#define PCAP_SNAPLEN 65535
+#define LINKTYPE_RAW 101                // 링크 헤더 없이 IP 패킷
+#define IP_HEADER 20
+#define TCP_HEADER 20
+#define TLS_RECORD_HEADER 5
+#define MAX_PAYLOAD (PCAP_SNAPLEN - IP_HEADER - TCP_HEADER)
+#define FLOW_BUFFER (16384 + 2048 + TLS_RECORD_HEADER)   // TLSCiphertext 최대 길이
+
+#define TCP_FIN 0x01
+#define TCP_SYN 0x02
+#define TCP_PSH 0x08
+#define TCP_ACK 0x10
+
+struct pcap_file {
+    FILE *fp;
+    pthread_mutex_t lock;
+};
+
+// 방향 0: 이쪽 → 상대, 1: 상대 → 이쪽
+typedef struct {
+    uint32_t seq;
+    size_t len;
+    unsigned char buf[FLOW_BUFFER];
+} pcap_dir_t;
+
+struct pcap_flow {
+    pcap_file_t *file;
+    struct sockaddr_in addr[2];     // 0: 이쪽, 1: 상대
+    uint16_t ip_id;
+    pcap_dir_t dir[2];
+};
+
+static void put16(unsigned char *p, uint16_t v) {
+    p[0] = (unsigned char)(v >> 8);
+    p[1] = (unsigned char)v;
+}
+
+static void put32(unsigned char *p, uint32_t v) {
+    p[0] = (unsigned char)(v >> 24);
+    p[1] = (unsigned char)(v >> 16);
+    p[2] = (unsigned char)(v >> 8);
+    p[3] = (unsigned char)v;
+}
+
+pcap_file_t* pcap_open(const char *path, bool append) {
+    pcap_file_t *file = calloc(1, sizeof(pcap_file_t));
+    if (!file) {
+        return NULL;
+    }
+    file->fp = fopen(path, append ? "ab" : "wb");
+    if (!file->fp) {
+        perror(path);
+        free(file);
+        return NULL;
+    }
+    pthread_mutex_init(&file->lock, NULL);
+
+    // 전역 헤더는 파일 호스트 바이트 순서 (magic으로 판별)
+    fseek(file->fp, 0, SEEK_END);
+    if (ftell(file->fp) == 0) {
+        struct {
+            uint32_t magic;
+            uint16_t version_major;
+            uint16_t version_minor;
+            int32_t thiszone;
+            uint32_t sigfigs;
+            uint32_t snaplen;
+            uint32_t network;
+        } header = { PCAP_MAGIC, 2, 4, 0, 0, PCAP_SNAPLEN, LINKTYPE_RAW };
+        fwrite(&header, sizeof(header), 1, file->fp);
+    }
+    return file;
+}
+
+void pcap_close(pcap_file_t *file) {
+    if (!file) {
+        return;
+    }
+    fclose(file->fp);
+    pthread_mutex_destroy(&file->lock);
+    free(file);
+}
+
+void pcap_combo_path(char *buf, size_t len, const char *dir, const char *groups,
+                     const char *sigalgs, const char *side) {
+    snprintf(buf, len, "%s/%s_%s_%s.pcap", dir, groups, sigalgs ? sigalgs : "default", side);
+    for (char *p = buf + strlen(dir) + 1; *p; p++) {
+        if (*p == ':' || *p == ',') {
+            *p = '-';
+        }
+    }
+}
+
+static uint16_t ip_checksum(const unsigned char *p, size_t len) {
+    uint32_t sum = 0;
+    for (size_t i = 0; i + 1 < len; i += 2) {
+        sum += (uint32_t)(p[i] << 8 | p[i + 1]);
+    }
+    while (sum >> 16) {
+        sum = (sum & 0xffff) + (sum >> 16);
+    }
+    return (uint16_t)~sum;
+}
+
+// IPv4/TCP 헤더를 붙여 패킷 1개 기록 (TCP 체크섬은 0, Wireshark 기본 설정은 검사하지 않음)
+static void emit(pcap_flow_t *flow, int d, uint8_t flags, const unsigned char *payload, size_t len) {
+    unsigned char hdr[16 + IP_HEADER + TCP_HEADER];
+    unsigned char *ip = hdr + 16;
+    unsigned char *tcp = ip + IP_HEADER;
+    const struct sockaddr_in *src = &flow->addr[d];
+    const struct sockaddr_in *dst = &flow->addr[1 - d];
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+
+    uint32_t caplen = (uint32_t)(IP_HEADER + TCP_HEADER + len);
+    uint32_t record[4] = { (uint32_t)ts.tv_sec, (uint32_t)(ts.tv_nsec / 1000), caplen, caplen };
+    memcpy(hdr, record, sizeof(record));
+
+    memset(ip, 0, IP_HEADER + TCP_HEADER);
+    ip[0] = 0x45;
+    put16(ip + 2, (uint16_t)caplen);
+    put16(ip + 4, flow->ip_id++);
+    put16(ip + 6, 0x4000);                      // DF
+    ip[8] = 64;
+    ip[9] = IPPROTO_TCP;
+    memcpy(ip + 12, &src->sin_addr, 4);
+    memcpy(ip + 16, &dst->sin_addr, 4);
+    put16(ip + 10, ip_checksum(ip, IP_HEADER));
+
+    memcpy(tcp, &src->sin_port, 2);
+    memcpy(tcp + 2, &dst->sin_port, 2);
+    put32(tcp + 4, flow->dir[d].seq);
+    put32(tcp + 8, (flags & TCP_ACK) ? flow->dir[1 - d].seq : 0);
+    tcp[12] = (TCP_HEADER / 4) << 4;
+    tcp[13] = flags;
+    put16(tcp + 14, 65535);
+
+    // SYN/FIN은 시퀀스 1개 소비
+    flow->dir[d].seq += (uint32_t)len + ((flags & (TCP_SYN | TCP_FIN)) ? 1 : 0);
+
+    pthread_mutex_lock(&flow->file->lock);
+    fwrite(hdr, sizeof(hdr), 1, flow->file->fp);
+    if (len > 0) {
+        fwrite(payload, len, 1, flow->file->fp);
+    }
+    pthread_mutex_unlock(&flow->file->lock);
+}
+
+static void emit_data(pcap_flow_t *flow, int d, const unsigned char *data, size_t len) {
+    while (len > 0) {
+        size_t n = len < MAX_PAYLOAD ? len : MAX_PAYLOAD;
+        emit(flow, d, TCP_PSH | TCP_ACK, data, n);
+        data += n;
+        len -= n;
+    }
+}
+
+pcap_flow_t* pcap_flow_new(pcap_file_t *file, int fd, bool is_server) {
+    pcap_flow_t *flow = file ? calloc(1, sizeof(pcap_flow_t)) : NULL;
+    if (!flow) {
+        return NULL;
+    }
+    socklen_t len = sizeof(flow->addr[0]);
+    getsockname(fd, (struct sockaddr*)&flow->addr[0], &len);
+    len = sizeof(flow->addr[1]);
+    getpeername(fd, (struct sockaddr*)&flow->addr[1], &len);
+    flow->file = file;
+    flow->ip_id = 1;
+    flow->dir[0].seq = is_server ? 2000000000u : 1000000000u;
+    flow->dir[1].seq = is_server ? 1000000000u : 2000000000u;
+
+    int opener = is_server ? 1 : 0;
+    emit(flow, opener, TCP_SYN, NULL, 0);
+    emit(flow, 1 - opener, TCP_SYN | TCP_ACK, NULL, 0);
+    emit(flow, opener, TCP_ACK, NULL, 0);
+    return flow;
+}
+
+void pcap_flow_data(pcap_flow_t *flow, bool outbound, const void *data, size_t len) {
+    int d = outbound ? 0 : 1;
+    pcap_dir_t *dir = &flow->dir[d];
+    const unsigned char *p = data;
+
+    // 읽기는 헤더/본문이 나뉘어 오므로 레코드가 완성될 때 기록 (시각 = 마지막 바이트 도착)
+    while (len > 0) {
+        size_t n = sizeof(dir->buf) - dir->len;
+        n = len < n ? len : n;
+        memcpy(dir->buf + dir->len, p, n);
+        dir->len += n;
+        p += n;
+        len -= n;
+
+        size_t off = 0;
+        while (dir->len - off >= TLS_RECORD_HEADER) {
+            size_t record = TLS_RECORD_HEADER + ((size_t)dir->buf[off + 3] << 8 | dir->buf[off + 4]);
+            if (record > sizeof(dir->buf)) {
+                // TLS가 아닌 스트림: 재조립 없이 그대로 기록
+                record = dir->len - off;
+            } else if (dir->len - off < record) {
+                break;
+            }
+            emit_data(flow, d, dir->buf + off, record);
+            off += record;
+        }
+        memmove(dir->buf, dir->buf + off, dir->len - off);
+        dir->len -= off;
+    }
+}
+
+void pcap_flow_free(pcap_flow_t *flow) {
+    if (!flow) {
+        return;
+    }
+    for (int d = 0; d < 2; d++) {
+        emit_data(flow, d, flow->dir[d].buf, flow->dir[d].len);
+    }
+    emit(flow, 0, TCP_FIN | TCP_ACK, NULL, 0);
+    // 서버는 보통 시그널로 종료되므로 연결마다 디스크로 내보냄
+    pthread_mutex_lock(&flow->file->lock);
+    fflush(flow->file->fp);
+    pthread_mutex_unlock(&flow->file->lock);
+    free(flow);
+}
@@ -0,0 +1,32 @@
+#ifndef PCAP_WRITER_H
+#define PCAP_WRITER_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+// tcpdump(root) 없이 소켓 BIO를 지나는 TLS 레코드를 pcap으로 기록 (LINKTYPE_RAW, IPv4/TCP 헤더 합성)
+// 파일 하나를 여러 연결/스레드가 공유 (패킷 단위 잠금)
+typedef struct pcap_file pcap_file_t;
+
+// 연결 하나의 양방향 스트림 (레코드 경계 재조립, 시퀀스 번호)
+typedef struct pcap_flow pcap_flow_t;
+
+// append: 기존 파일 뒤에 이어 씀 (비었거나 없으면 헤더부터), false면 새로 씀
+pcap_file_t* pcap_open(const char *path, bool append);
+
+void pcap_close(pcap_file_t *file);
+
+// 조합별 파일 경로 "<dir>/<groups>_<sigalgs>_<side>.pcap" (목록 구분자 ':'/','는 '-')
+void pcap_combo_path(char *buf, size_t len, const char *dir, const char *groups,
+                     const char *sigalgs, const char *side);
+
+// 소켓 주소로 흐름 생성 후 SYN/SYN-ACK/ACK 기록 (is_server: 상대가 연결을 연 쪽)
+pcap_flow_t* pcap_flow_new(pcap_file_t *file, int fd, bool is_server);
+
+// 소켓으로 오간 바이트 추가, 완성된 TLS 레코드마다 패킷 1개 (outbound: 이쪽이 송신)
+void pcap_flow_data(pcap_flow_t *flow, bool outbound, const void *data, size_t len);
+
+// 남은 바이트와 FIN 기록 후 해제 (NULL 허용)
+void pcap_flow_free(pcap_flow_t *flow);
+
+#endif // PCAP_WRITER_H
@@ -0,0 +1,168 @@
+#include "perf_counters.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+// 스레드별 카운터 그룹
+typedef struct {
+    int fds[PERF_COUNTER_COUNT];    // -1: 열리지 않음
+    int index[PERF_COUNTER_COUNT];  // 그룹 읽기 결과에서의 위치
+    int nr;                         // 그룹에 열린 이벤트 수
+    bool hw;
+} perf_group_t;
+
+static pthread_key_t group_key;
+static pthread_once_t group_once = PTHREAD_ONCE_INIT;
+
+static const struct {
+    uint32_t type;
+    uint64_t config;
+    const char *name;
+} PERF_EVENTS[PERF_COUNTER_COUNT] = {
+    [PERF_TASK_CLOCK]    = {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK, "task_clock_ns"},
+    [PERF_CYCLES]        = {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, "cycles"},
+    [PERF_INSTRUCTIONS]  = {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, "instructions"},
+    [PERF_CACHE_MISSES]  = {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, "cache_misses"},
+    [PERF_BRANCH_MISSES] = {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, "branch_misses"},
+};
+
+static void close_group(void *arg) {
+    perf_group_t *g = arg;
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        if (g->fds[i] >= 0) {
+            close(g->fds[i]);
+        }
+    }
+    free(g);
+}
+
+static void init_group_key(void) {
+    pthread_key_create(&group_key, close_group);
+}
+
+static int open_event(perf_counter_t counter, int group_fd, bool exclude_kernel) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_EVENTS[counter].type;
+    attr.config = PERF_EVENTS[counter].config;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                       PERF_FORMAT_TOTAL_TIME_RUNNING;
+    attr.exclude_kernel = exclude_kernel;
+    attr.exclude_hv = 1;
+
+    // pid 0, cpu -1: 호출 스레드가 어느 CPU에서 돌든 그 스레드만 측정
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+// 현재 스레드의 그룹 (없으면 열기)
+static perf_group_t* thread_group(void) {
+    pthread_once(&group_once, init_group_key);
+
+    perf_group_t *g = pthread_getspecific(group_key);
+    if (g) {
+        return g;
+    }
+    g = calloc(1, sizeof(perf_group_t));
+    if (!g) {
+        return NULL;
+    }
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        g->fds[i] = -1;
+    }
+
+    // 커널 구간 포함을 먼저 시도하고, perf_event_paranoid >= 2면 사용자 공간만
+    bool exclude_kernel = false;
+    int leader = open_event(PERF_TASK_CLOCK, -1, exclude_kernel);
+    if (leader < 0) {
+        exclude_kernel = true;
+        leader = open_event(PERF_TASK_CLOCK, -1, exclude_kernel);
+    }
+    if (leader >= 0) {
+        g->fds[PERF_TASK_CLOCK] = leader;
+        g->index[PERF_TASK_CLOCK] = g->nr++;
+        for (int i = PERF_CYCLES; i < PERF_COUNTER_COUNT; i++) {
+            int fd = open_event(i, leader, exclude_kernel);
+            if (fd >= 0) {
+                g->fds[i] = fd;
+                g->index[i] = g->nr++;
+                g->hw = true;
+            }
+        }
+        ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    pthread_setspecific(group_key, g);
+    return g;
+}
+
+static uint64_t thread_cpu_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// 그룹 1회 read로 모든 카운터 읽기 (멀티플렉싱 시 실행 비율로 보정)
+static void read_values(perf_values_t *values) {
+    memset(values, 0, sizeof(perf_values_t));
+    values->cpu_ns = thread_cpu_ns();
+
+    perf_group_t *g = thread_group();
+    if (!g || g->nr == 0) {
+        return;
+    }
+
+    uint64_t buf[3 + PERF_COUNTER_COUNT];
+    if (read(g->fds[PERF_TASK_CLOCK], buf, sizeof(buf)) < (ssize_t)((3 + g->nr) * sizeof(uint64_t))) {
+        return;
+    }
+    uint64_t enabled = buf[1], running = buf[2];
+    double scale = (running > 0 && running < enabled) ? (double)enabled / running : 1.0;
+
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        if (g->fds[i] >= 0) {
+            values->counters[i] = (uint64_t)(buf[3 + g->index[i]] * scale);
+        }
+    }
+}
+
+void perf_begin(perf_values_t *start) {
+    read_values(start);
+}
+
+void perf_end(const perf_values_t *start, perf_values_t *acc) {
+    perf_values_t now;
+    read_values(&now);
+
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        if (now.counters[i] > start->counters[i]) {
+            acc->counters[i] += now.counters[i] - start->counters[i];
+        }
+    }
+    acc->cpu_ns += now.cpu_ns - start->cpu_ns;
+}
+
+bool perf_hw_available(void) {
+    perf_group_t *g = thread_group();
+    return g && g->hw;
+}
+
+const char* perf_counter_name(perf_counter_t counter) {
+    return counter < PERF_COUNTER_COUNT ? PERF_EVENTS[counter].name : "?";
+}
+
+void perf_fill_resources(const perf_values_t *acc, resource_metrics_t *resources) {
+    resources->cpu_cycles = acc->counters[PERF_CYCLES];
+    resources->instructions = acc->counters[PERF_INSTRUCTIONS];
+    resources->cache_misses = acc->counters[PERF_CACHE_MISSES];
+    resources->branch_misses = acc->counters[PERF_BRANCH_MISSES];
+    resources->task_clock_ns = acc->counters[PERF_TASK_CLOCK];
+    resources->cpu_time_ns = acc->cpu_ns;
+}
@@ -0,0 +1,38 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "metrics.h"
+
+// 핸드셰이크 구간에서 읽는 카운터 (perf_event_open, 호출 스레드 전용)
+typedef enum {
+    PERF_TASK_CLOCK,        // ns (그룹 리더, 소프트웨어 이벤트라 PMU가 없어도 동작)
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_CACHE_MISSES,
+    PERF_BRANCH_MISSES,
+    PERF_COUNTER_COUNT
+} perf_counter_t;
+
+// 카운터 값 + 스레드 CPU 시간 (CLOCK_THREAD_CPUTIME_ID)
+typedef struct {
+    uint64_t counters[PERF_COUNTER_COUNT];
+    uint64_t cpu_ns;
+} perf_values_t;
+
+// 구간 시작: 현재 스레드의 값 기록 (첫 호출 시 스레드별 카운터 그룹을 열고, 스레드 종료 시 자동 해제)
+void perf_begin(perf_values_t *start);
+
+// 구간 종료: (현재 - start)를 acc에 누적 (논블로킹 상태 머신은 SSL 호출마다 begin/end)
+void perf_end(const perf_values_t *start, perf_values_t *acc);
+
+// 현재 스레드에서 열린 하드웨어 카운터가 있는지 (없으면 task-clock/CPU 시간만 유효)
+bool perf_hw_available(void);
+
+const char* perf_counter_name(perf_counter_t counter);
+
+// 누적값을 핸드셰이크당 resource 메트릭으로 기록
+void perf_fill_resources(const perf_values_t *acc, resource_metrics_t *resources);
+
+#endif // PERF_COUNTERS_H
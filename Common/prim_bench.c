@@ -0,0 +1,380 @@
+#include "prim_bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <openssl/evp.h>
+#include <openssl/err.h>
+#include <openssl/rsa.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#define PRIM_BUF_SIZE 32768         // SLH-DSA-128f 서명(17088B), ML-KEM-1024 암호문(1568B) 수용
+#define TLS13_SIGNED_LEN 130        // CertificateVerify 서명 입력: 64 공백 + 문맥 문자열 + 0 + SHA-256
+
+// 이름별 EVP 후보 (OpenSSL 3.5+ 내장 이름 → oqsprovider 이름 순)
+typedef struct {
+    const char *name;
+    prim_kind_t kind;
+    const char *candidates[3];
+    const char *md;
+    bool ecdh;
+    bool pss;
+} prim_name_map_t;
+
+static const prim_name_map_t PRIM_NAMES[] = {
+    {"x25519", PRIM_KEM, {"X25519", NULL, NULL}, NULL, true, false},
+    {"mlkem512", PRIM_KEM, {"ML-KEM-512", "mlkem512", NULL}, NULL, false, false},
+    {"mlkem768", PRIM_KEM, {"ML-KEM-768", "mlkem768", NULL}, NULL, false, false},
+    {"mlkem1024", PRIM_KEM, {"ML-KEM-1024", "mlkem1024", NULL}, NULL, false, false},
+    {"X25519MLKEM768", PRIM_KEM, {"X25519MLKEM768", NULL, NULL}, NULL, false, false},
+    {"SecP256r1MLKEM768", PRIM_KEM, {"SecP256r1MLKEM768", "p256_mlkem768", NULL}, NULL, false, false},
+    {"SecP384r1MLKEM1024", PRIM_KEM, {"SecP384r1MLKEM1024", "p384_mlkem1024", NULL}, NULL, false, false},
+    {"ecdsa_secp256r1_sha256", PRIM_SIG, {"EC", NULL, NULL}, "SHA256", false, false},
+    {"ed25519", PRIM_SIG, {"ED25519", NULL, NULL}, NULL, false, false},
+    {"rsa_pss_rsae_sha256", PRIM_SIG, {"RSA", NULL, NULL}, "SHA256", false, true},
+    {"mldsa44", PRIM_SIG, {"ML-DSA-44", "mldsa44", "dilithium2"}, NULL, false, false},
+    {"mldsa65", PRIM_SIG, {"ML-DSA-65", "mldsa65", "dilithium3"}, NULL, false, false},
+    {"mldsa87", PRIM_SIG, {"ML-DSA-87", "mldsa87", "dilithium5"}, NULL, false, false},
+    {"slhdsa_sha2_128s", PRIM_SIG, {"SLH-DSA-SHA2-128s", "sphincssha2128ssimple", NULL}, NULL, false, false},
+    {"slhdsa_sha2_128f", PRIM_SIG, {"SLH-DSA-SHA2-128f", "sphincssha2128fsimple", NULL}, NULL, false, false},
+};
+
+#define PRIM_NAME_COUNT (sizeof(PRIM_NAMES) / sizeof(prim_name_map_t))
+
+// 스레드별 상태 (키와 버퍼를 스레드마다 따로 가짐)
+typedef struct {
+    const prim_alg_t *alg;
+    prim_op_t op;
+    int iterations;
+    int warmup;
+    pthread_barrier_t *barrier;
+
+    EVP_PKEY_CTX *gen_ctx;
+    EVP_PKEY *key;              // 장기 키 (KEM 수신자 / 서명자)
+    EVP_PKEY *peer;             // ECDH 상대 임시 키
+    EVP_PKEY_CTX *op_ctx;       // encap/decap용
+    EVP_MD_CTX *md_ctx;
+    const EVP_MD *md;
+    unsigned char buf[PRIM_BUF_SIZE];
+    size_t buf_len;             // 암호문 또는 서명 길이
+    unsigned char secret[128];
+    unsigned char msg[TLS13_SIGNED_LEN];
+
+    bool ok;
+    double elapsed_ns;
+    double cycles;
+} prim_thread_t;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static uint64_t read_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static EVP_PKEY_CTX* new_gen_ctx(const prim_alg_t *alg) {
+    EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new_from_name(NULL, alg->evp_name, NULL);
+    if (!ctx || EVP_PKEY_keygen_init(ctx) <= 0) {
+        EVP_PKEY_CTX_free(ctx);
+        return NULL;
+    }
+    // ECDSA P-256
+    if (strcmp(alg->evp_name, "EC") == 0 &&
+        EVP_PKEY_CTX_set_group_name(ctx, "P-256") <= 0) {
+        EVP_PKEY_CTX_free(ctx);
+        return NULL;
+    }
+    return ctx;
+}
+
+static EVP_PKEY* keygen(EVP_PKEY_CTX *gen_ctx) {
+    EVP_PKEY *key = NULL;
+    if (EVP_PKEY_keygen(gen_ctx, &key) <= 0) {
+        return NULL;
+    }
+    return key;
+}
+
+// ECDH 공유 비밀 계산
+static bool derive(EVP_PKEY *own, EVP_PKEY *peer, unsigned char *secret, size_t *len) {
+    EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new(own, NULL);
+    bool ok = ctx && EVP_PKEY_derive_init(ctx) > 0 &&
+              EVP_PKEY_derive_set_peer(ctx, peer) > 0 &&
+              EVP_PKEY_derive(ctx, secret, len) > 0;
+    EVP_PKEY_CTX_free(ctx);
+    return ok;
+}
+
+// 서명/검증 초기화 (rsa_pss_rsae는 RSA 키에 PSS 패딩)
+static bool sign_init(prim_thread_t *t, bool verify) {
+    EVP_PKEY_CTX *pctx = NULL;
+    int ret = verify ? EVP_DigestVerifyInit(t->md_ctx, &pctx, t->md, NULL, t->key)
+                     : EVP_DigestSignInit(t->md_ctx, &pctx, t->md, NULL, t->key);
+    if (ret <= 0) {
+        return false;
+    }
+    return !t->alg->pss || EVP_PKEY_CTX_set_rsa_padding(pctx, RSA_PKCS1_PSS_PADDING) > 0;
+}
+
+// 연산 1회 (측정 루프 본체)
+static bool run_op(prim_thread_t *t) {
+    const prim_alg_t *alg = t->alg;
+    size_t len = sizeof(t->secret);
+
+    switch (t->op) {
+    case PRIM_KEYGEN: {
+        EVP_PKEY *key = keygen(t->gen_ctx);
+        EVP_PKEY_free(key);
+        return key != NULL;
+    }
+    case PRIM_ENCAP:
+        if (alg->ecdh) {
+            // 서버 측: 임시 키 생성 후 클라이언트 공개키와 ECDH
+            EVP_PKEY *eph = keygen(t->gen_ctx);
+            bool ok = eph && derive(eph, t->key, t->secret, &len);
+            EVP_PKEY_free(eph);
+            return ok;
+        }
+        t->buf_len = sizeof(t->buf);
+        return EVP_PKEY_encapsulate(t->op_ctx, t->buf, &t->buf_len, t->secret, &len) > 0;
+    case PRIM_DECAP:
+        if (alg->ecdh) {
+            return derive(t->key, t->peer, t->secret, &len);
+        }
+        return EVP_PKEY_decapsulate(t->op_ctx, t->secret, &len, t->buf, t->buf_len) > 0;
+    case PRIM_SIGN: {
+        // 핸드셰이크마다 새로 초기화하는 TLS와 동일하게 매번 init
+        size_t sig_len = sizeof(t->buf);
+        return sign_init(t, false) &&
+               EVP_DigestSign(t->md_ctx, t->buf, &sig_len, t->msg, sizeof(t->msg)) > 0;
+    }
+    case PRIM_VERIFY:
+        return sign_init(t, true) &&
+               EVP_DigestVerify(t->md_ctx, t->buf, t->buf_len, t->msg, sizeof(t->msg)) > 0;
+    default:
+        return false;
+    }
+}
+
+// 연산에 필요한 키/암호문/서명 준비
+static bool setup_thread(prim_thread_t *t) {
+    const prim_alg_t *alg = t->alg;
+
+    memset(t->msg, 0x20, 64);
+    t->md = alg->md ? EVP_get_digestbyname(alg->md) : NULL;
+    t->gen_ctx = new_gen_ctx(alg);
+    t->md_ctx = EVP_MD_CTX_new();
+    if (!t->gen_ctx || !t->md_ctx) {
+        return false;
+    }
+    t->key = keygen(t->gen_ctx);
+    if (!t->key) {
+        return false;
+    }
+
+    if (alg->kind == PRIM_KEM) {
+        if (alg->ecdh) {
+            t->peer = keygen(t->gen_ctx);
+            return t->peer != NULL;
+        }
+        size_t len = sizeof(t->secret);
+        t->op_ctx = EVP_PKEY_CTX_new_from_pkey(NULL, t->key, NULL);
+        if (!t->op_ctx || EVP_PKEY_encapsulate_init(t->op_ctx, NULL) <= 0) {
+            return false;
+        }
+        t->buf_len = sizeof(t->buf);
+        if (EVP_PKEY_encapsulate(t->op_ctx, t->buf, &t->buf_len, t->secret, &len) <= 0) {
+            return false;
+        }
+        if (t->op == PRIM_DECAP && EVP_PKEY_decapsulate_init(t->op_ctx, NULL) <= 0) {
+            return false;
+        }
+        return true;
+    }
+
+    // 검증용 서명 1개 생성
+    t->buf_len = sizeof(t->buf);
+    return sign_init(t, false) &&
+           EVP_DigestSign(t->md_ctx, t->buf, &t->buf_len, t->msg, sizeof(t->msg)) > 0;
+}
+
+static void cleanup_thread(prim_thread_t *t) {
+    EVP_PKEY_CTX_free(t->gen_ctx);
+    EVP_PKEY_CTX_free(t->op_ctx);
+    EVP_PKEY_free(t->key);
+    EVP_PKEY_free(t->peer);
+    EVP_MD_CTX_free(t->md_ctx);
+}
+
+static void* prim_thread_main(void *arg) {
+    prim_thread_t *t = arg;
+
+    bool ready = setup_thread(t);
+    pthread_barrier_wait(t->barrier);       // 모든 스레드가 동시에 측정 시작
+    if (!ready) {
+        return NULL;
+    }
+
+    for (int i = 0; i < t->warmup; i++) {
+        if (!run_op(t)) {
+            return NULL;
+        }
+    }
+
+    uint64_t c0 = read_cycles();
+    uint64_t t0 = now_ns();
+    for (int i = 0; i < t->iterations; i++) {
+        if (!run_op(t)) {
+            return NULL;
+        }
+    }
+    t->elapsed_ns = (double)(now_ns() - t0);
+    t->cycles = (double)(read_cycles() - c0);
+    t->ok = true;
+    return NULL;
+}
+
+bool prim_resolve(const char *name, prim_alg_t *alg) {
+    memset(alg, 0, sizeof(prim_alg_t));
+
+    for (size_t i = 0; i < PRIM_NAME_COUNT; i++) {
+        const prim_name_map_t *m = &PRIM_NAMES[i];
+        if (strcmp(m->name, name) != 0) {
+            continue;
+        }
+        alg->name = m->name;
+        alg->kind = m->kind;
+        alg->md = m->md;
+        alg->ecdh = m->ecdh;
+        alg->pss = m->pss;
+
+        for (int c = 0; c < 3 && m->candidates[c]; c++) {
+            snprintf(alg->evp_name, sizeof(alg->evp_name), "%s", m->candidates[c]);
+            EVP_PKEY_CTX *ctx = new_gen_ctx(alg);
+            if (ctx) {
+                EVP_PKEY_CTX_free(ctx);
+                return true;
+            }
+        }
+        break;
+    }
+    ERR_clear_error();
+    return false;
+}
+
+bool prim_op_applies(const prim_alg_t *alg, prim_op_t op) {
+    if (op == PRIM_KEYGEN) {
+        return true;
+    }
+    if (alg->kind == PRIM_KEM) {
+        return op == PRIM_ENCAP || op == PRIM_DECAP;
+    }
+    return op == PRIM_SIGN || op == PRIM_VERIFY;
+}
+
+const char* prim_op_name(prim_op_t op) {
+    switch (op) {
+    case PRIM_KEYGEN: return "keygen";
+    case PRIM_ENCAP:  return "encap";
+    case PRIM_DECAP:  return "decap";
+    case PRIM_SIGN:   return "sign";
+    case PRIM_VERIFY: return "verify";
+    default:          return "?";
+    }
+}
+
+int prim_bench_run(const prim_alg_t *alg, prim_op_t op, int iterations, int warmup,
+                   int threads, prim_result_t *result) {
+    memset(result, 0, sizeof(prim_result_t));
+    result->threads = threads;
+    if (!prim_op_applies(alg, op) || iterations <= 0 || threads <= 0) {
+        return -1;
+    }
+
+    prim_thread_t *t = calloc(threads, sizeof(prim_thread_t));
+    pthread_t *tids = calloc(threads, sizeof(pthread_t));
+    pthread_barrier_t barrier;
+    if (!t || !tids) {
+        free(t);
+        free(tids);
+        return -1;
+    }
+    pthread_barrier_init(&barrier, NULL, threads);
+
+    int started = 0;
+    for (int i = 0; i < threads; i++) {
+        t[i].alg = alg;
+        t[i].op = op;
+        t[i].iterations = iterations;
+        t[i].warmup = warmup;
+        t[i].barrier = &barrier;
+        if (pthread_create(&tids[i], NULL, prim_thread_main, &t[i]) != 0) {
+            break;
+        }
+        started++;
+    }
+    // 생성 실패 시 barrier에서 멈추지 않도록 남은 자리를 채움
+    for (int i = started; i < threads; i++) {
+        pthread_barrier_wait(&barrier);
+    }
+
+    int ok = 0;
+    double ns_sum = 0.0, cycles_sum = 0.0;
+    for (int i = 0; i < started; i++) {
+        pthread_join(tids[i], NULL);
+        if (t[i].ok) {
+            ok++;
+            ns_sum += t[i].elapsed_ns / iterations;
+            cycles_sum += t[i].cycles / iterations;
+            result->ops_per_sec += iterations / (t[i].elapsed_ns / 1e9);
+        }
+        cleanup_thread(&t[i]);
+    }
+
+    if (ok == threads) {
+        result->available = true;
+        result->ns_per_op = ns_sum / ok;
+        result->cycles_per_op = cycles_sum / ok;
+    }
+
+    pthread_barrier_destroy(&barrier);
+    free(t);
+    free(tids);
+    ERR_clear_error();
+    return result->available ? 0 : -1;
+}
+
+// 단일 스레드 연산 시간 (ms, 실패 시 0)
+static double op_ms(const prim_alg_t *alg, prim_op_t op, int iterations) {
+    prim_result_t r;
+    int warmup = iterations / 10 > 0 ? iterations / 10 : 1;
+    if (prim_bench_run(alg, op, iterations, warmup, 1, &r) != 0) {
+        return 0.0;
+    }
+    return r.ns_per_op / 1e6;
+}
+
+void prim_measure(const char *group, const char *sigalg, int iterations, prim_timings_t *timings) {
+    prim_alg_t kem, sig;
+
+    memset(timings, 0, sizeof(prim_timings_t));
+    if (prim_resolve(group, &kem)) {
+        timings->kem_keygen_ms = op_ms(&kem, PRIM_KEYGEN, iterations);
+        timings->kem_encap_ms = op_ms(&kem, PRIM_ENCAP, iterations);
+        timings->kem_decap_ms = op_ms(&kem, PRIM_DECAP, iterations);
+    }
+    if (prim_resolve(sigalg, &sig)) {
+        timings->sign_ms = op_ms(&sig, PRIM_SIGN, iterations);
+        timings->verify_ms = op_ms(&sig, PRIM_VERIFY, iterations);
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef PRIM_BENCH_H
+#define PRIM_BENCH_H
+
+#include <stdbool.h>
+#include "metrics.h"
+
+// 측정하는 단일 암호 연산
+typedef enum {
+    PRIM_KEYGEN,
+    PRIM_ENCAP,     // KEM: 캡슐화 (x25519는 임시 키 생성 + ECDH, TLS 서버 측과 동일)
+    PRIM_DECAP,     // KEM: 역캡슐화 (x25519는 ECDH)
+    PRIM_SIGN,      // 서명: TLS 1.3 CertificateVerify 크기 입력 서명
+    PRIM_VERIFY,
+    PRIM_OP_COUNT
+} prim_op_t;
+
+typedef enum {
+    PRIM_KEM,
+    PRIM_SIG
+} prim_kind_t;
+
+// 알고리즘 매트릭스(algorithms.conf) 이름 → EVP 알고리즘
+typedef struct {
+    const char *name;       // "mlkem768", "mldsa65" 등
+    prim_kind_t kind;
+    char evp_name[32];      // 해석된 EVP 이름 ("ML-KEM-768", "dilithium3" 등)
+    const char *md;         // 서명 다이제스트 (ML-DSA는 NULL)
+    bool ecdh;              // KEM을 ECDH로 구성 (x25519)
+    bool pss;               // RSA 서명을 PSS 패딩으로 (rsa_pss_rsae_sha256)
+} prim_alg_t;
+
+// 연산 1개의 측정 결과
+typedef struct {
+    bool available;
+    int threads;
+    double ns_per_op;       // 스레드별 평균
+    double cycles_per_op;   // TSC 기준 (x86 외에는 0)
+    double ops_per_sec;     // 모든 스레드 합계
+} prim_result_t;
+
+// 이름을 현재 OpenSSL(프로바이더 포함)의 EVP 알고리즘으로 해석 (미지원이면 false)
+bool prim_resolve(const char *name, prim_alg_t *alg);
+
+// 해당 종류에서 의미 있는 연산인지 (KEM: keygen/encap/decap, 서명: keygen/sign/verify)
+bool prim_op_applies(const prim_alg_t *alg, prim_op_t op);
+
+const char* prim_op_name(prim_op_t op);
+
+// 스레드마다 독립 키로 warmup 후 iterations회 반복 측정 (0: 성공)
+int prim_bench_run(const prim_alg_t *alg, prim_op_t op, int iterations, int warmup,
+                   int threads, prim_result_t *result);
+
+// 조합의 KEM/서명 단일 연산 시간 측정 (단일 스레드, 미지원 알고리즘은 0)
+//  - TLS 1.3: 클라이언트 keygen + decap, 서버 encap, 양쪽 모두 sign/verify (mTLS)
+void prim_measure(const char *group, const char *sigalg, int iterations, prim_timings_t *timings);
+
+#endif // PRIM_BENCH_H
@@ -0,0 +1,127 @@
+#include "tcp_stats.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+// glibc의 netinet/tcp.h에는 tcpi_segs_out 등 4.x 이후 필드가 없으므로 커널 헤더 사용
+#include <linux/tcp.h>
+
+#define RECORD_HEADER 5
+#define CCS_RECORD 6                // 미들박스 호환 ChangeCipherSpec
+#define AEAD_RECORD_OVERHEAD 22     // 레코드 헤더 + 내부 content type + 16 B 태그
+
+bool tcp_sample(int fd, tcp_sample_t *sample) {
+    struct tcp_info info;
+    socklen_t len = sizeof(info);
+
+    memset(sample, 0, sizeof(tcp_sample_t));
+    memset(&info, 0, sizeof(info));
+    if (fd < 0 || getsockopt(fd, IPPROTO_TCP, TCP_INFO, &info, &len) < 0) {
+        return false;
+    }
+    // 오래된 커널은 짧은 구조체를 돌려주므로 나머지는 0으로 남음
+    sample->valid = true;
+    sample->segs_out = info.tcpi_segs_out;
+    sample->segs_in = info.tcpi_segs_in;
+    sample->total_retrans = info.tcpi_total_retrans;
+    sample->snd_cwnd = info.tcpi_snd_cwnd;
+    sample->snd_mss = info.tcpi_snd_mss;
+    sample->rtt_us = info.tcpi_rtt;
+    sample->rttvar_us = info.tcpi_rttvar;
+    return true;
+}
+
+bool tcp_set_nodelay(int fd, bool on) {
+    int value = on ? 1 : 0;
+    return setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &value, sizeof(value)) == 0;
+}
+
+// TcpExt: 이름 줄 다음에 같은 순서의 값 줄
+bool tcp_listen_overflows(uint64_t *overflows, uint64_t *drops) {
+    FILE *fp = fopen("/proc/net/netstat", "r");
+    if (!fp) {
+        return false;
+    }
+    // TcpExt 헤더/값 줄은 커널 버전마다 길어지므로 고정 버퍼 대신 getline (잘리면 필드가 사라짐)
+    char *names = NULL, *values = NULL;
+    size_t names_cap = 0, values_cap = 0;
+    bool found = false;
+    *overflows = 0;
+    *drops = 0;
+    while (!found && getline(&names, &names_cap, fp) > 0 && getline(&values, &values_cap, fp) > 0) {
+        if (strncmp(names, "TcpExt:", 7) != 0) {
+            continue;
+        }
+        char *name_save, *value_save;
+        char *name = strtok_r(names, " \n", &name_save);
+        char *value = strtok_r(values, " \n", &value_save);
+        while (name && value) {
+            if (strcmp(name, "ListenOverflows") == 0) {
+                *overflows = strtoull(value, NULL, 10);
+                found = true;
+            } else if (strcmp(name, "ListenDrops") == 0) {
+                *drops = strtoull(value, NULL, 10);
+            }
+            name = strtok_r(NULL, " \n", &name_save);
+            value = strtok_r(NULL, " \n", &value_save);
+        }
+    }
+    free(names);
+    free(values);
+    fclose(fp);
+    return found;
+}
+
+uint32_t tcp_server_flight_bytes(const message_bytes_t *mb) {
+    if (mb->server_hello == 0) {
+        return 0;
+    }
+    // ServerHello는 평문 레코드, 나머지는 메시지마다 암호화 레코드 하나
+    const uint32_t encrypted[] = {
+        mb->encrypted_extensions, mb->certificate_request, mb->server_certificate,
+        mb->server_certificate_verify, mb->server_finished
+    };
+    uint32_t bytes = RECORD_HEADER + mb->server_hello + CCS_RECORD;
+    for (size_t i = 0; i < sizeof(encrypted) / sizeof(encrypted[0]); i++) {
+        if (encrypted[i] > 0) {
+            bytes += encrypted[i] + AEAD_RECORD_OVERHEAD;
+        }
+    }
+    return bytes;
+}
+
+uint32_t tcp_flight_rounds(uint32_t bytes, uint32_t mss, uint32_t cwnd) {
+    if (bytes == 0 || mss == 0 || cwnd == 0) {
+        return 0;
+    }
+    uint64_t segments = (bytes + mss - 1) / mss;
+    uint64_t window = cwnd;
+    uint32_t rounds = 0;
+    while (segments > 0) {
+        segments = segments > window ? segments - window : 0;
+        window *= 2;
+        rounds++;
+    }
+    return rounds;
+}
+
+void tcp_fill_traffic(const tcp_sample_t *start, const tcp_sample_t *end, bool server,
+                      traffic_metrics_t *traffic) {
+    if (!start->valid || !end->valid) {
+        return;
+    }
+    traffic->segs_out = end->segs_out - start->segs_out;
+    traffic->segs_in = end->segs_in - start->segs_in;
+    traffic->packets_count = traffic->segs_out + traffic->segs_in;
+    traffic->retransmits = end->total_retrans - start->total_retrans;
+    traffic->snd_cwnd = start->snd_cwnd;
+    traffic->snd_mss = end->snd_mss;
+    traffic->tcp_rtt_us = end->rtt_us;
+    traffic->server_flight_bytes = tcp_server_flight_bytes(&traffic->msg_bytes);
+    // 서버 비행의 왕복 수는 서버 소켓의 혼잡 윈도가 결정
+    if (server) {
+        traffic->server_flight_rounds =
+            tcp_flight_rounds(traffic->server_flight_bytes, traffic->snd_mss, traffic->snd_cwnd);
+    }
+}
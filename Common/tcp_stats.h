@@ -0,0 +1,42 @@
+#ifndef TCP_STATS_H
+#define TCP_STATS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "metrics.h"
+
+#define TCP_INIT_CWND 10            // 리눅스 기본 초기 혼잡 윈도 (RFC 6928, route initcwnd 미설정 시)
+
+// 핸드셰이크 구간 전송 계층 관측용 TCP_INFO 스냅샷 (커널이 모르는 필드는 0)
+typedef struct {
+    bool valid;
+    uint32_t segs_out;          // 보낸 세그먼트 (재전송 포함)
+    uint32_t segs_in;
+    uint32_t total_retrans;
+    uint32_t snd_cwnd;          // 세그먼트 단위
+    uint32_t snd_mss;
+    uint32_t rtt_us;            // 커널 smoothed RTT
+    uint32_t rttvar_us;
+} tcp_sample_t;
+
+// getsockopt(TCP_INFO) 스냅샷 (실패 시 valid=false)
+bool tcp_sample(int fd, tcp_sample_t *sample);
+
+// TCP_NODELAY 설정
+bool tcp_set_nodelay(int fd, bool on);
+
+// 시스템 전체 수락 큐 넘침 카운터 (/proc/net/netstat TcpExt ListenOverflows/ListenDrops, 실패 시 false)
+bool tcp_listen_overflows(uint64_t *overflows, uint64_t *drops);
+
+// 서버 첫 비행(ServerHello ~ Finished)의 와이어 바이트 추정 (메시지 크기 + 레코드 오버헤드)
+uint32_t tcp_server_flight_bytes(const message_bytes_t *msg_bytes);
+
+// 슬로 스타트에서 bytes를 보내는 데 필요한 왕복 수 (cwnd 세그먼트로 시작해 왕복마다 2배)
+uint32_t tcp_flight_rounds(uint32_t bytes, uint32_t mss, uint32_t cwnd);
+
+// 시작/종료 스냅샷 차이를 트래픽 메트릭에 기록 (hs_trace_fill_metrics 이후 호출)
+//  - server_flight_rounds는 서버 소켓 샘플(server=true)의 cwnd/MSS로만 계산 (클라이언트는 0으로 둠)
+void tcp_fill_traffic(const tcp_sample_t *start, const tcp_sample_t *end, bool server,
+                      traffic_metrics_t *traffic);
+
+#endif // TCP_STATS_H
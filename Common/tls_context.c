@@ -0,0 +1,172 @@
+#include "tls_context.h"
+#include "handshake_trace.h"
+#include "cert_comp.h"
+#include <stdio.h>
+#include <string.h>
+#include <openssl/err.h>
+
+// OpenSSL 오류 출력
+void print_ssl_error(const char *msg) {
+    fprintf(stderr, "%s\n", msg);
+    ERR_print_errors_fp(stderr);
+}
+
+// 그룹 목록 설정, '*' 접두사는 첫 ClientHello에 key_share를 보낼 그룹 (OpenSSL 3.5+)
+static void set_groups(SSL_CTX *ctx, const char *groups) {
+#if OPENSSL_VERSION_NUMBER < 0x30500000L
+    char plain[512];
+    if (strchr(groups, '*') && strlen(groups) < sizeof(plain)) {
+        // 이전 버전은 구문을 모르므로 '*'를 지우고 첫 그룹의 key_share만 보냄
+        size_t n = 0;
+        for (const char *p = groups; *p; p++) {
+            if (*p != '*') {
+                plain[n++] = *p;
+            }
+        }
+        plain[n] = '\0';
+        fprintf(stderr, "Warning: key share selection '*' needs OpenSSL 3.5+, using %s (first group only)\n",
+                plain);
+        groups = plain;
+    }
+#endif
+    if (SSL_CTX_set1_groups_list(ctx, groups) != 1) {
+        fprintf(stderr, "Warning: Failed to set groups: %s\n", groups);
+    }
+}
+
+// 공통 설정: 프로토콜, cipher suite, 그룹, 서명 알고리즘
+static SSL_CTX* create_base_context(const SSL_METHOD *method, const tls_ctx_config_t *config) {
+    SSL_CTX *ctx = SSL_CTX_new_ex(config->libctx, config->propq, method);
+    if (!ctx) {
+        print_ssl_error("Unable to create SSL context");
+        return NULL;
+    }
+    if (config->async) {
+        SSL_CTX_set_mode(ctx, SSL_MODE_ASYNC);
+    }
+
+    // TLS 1.3만 사용
+    SSL_CTX_set_min_proto_version(ctx, TLS1_3_VERSION);
+    SSL_CTX_set_max_proto_version(ctx, TLS1_3_VERSION);
+
+    // Cipher suite 고정: TLS_AES_128_GCM_SHA256
+    if (SSL_CTX_set_ciphersuites(ctx, "TLS_AES_128_GCM_SHA256") != 1) {
+        print_ssl_error("Failed to set cipher suite");
+        SSL_CTX_free(ctx);
+        return NULL;
+    }
+
+    // 그룹 설정 (KEM)
+    if (config->groups) {
+        set_groups(ctx, config->groups);
+    }
+
+    // 서명 알고리즘 설정
+    if (config->sigalgs && SSL_CTX_set1_sigalgs_list(ctx, config->sigalgs) != 1) {
+        fprintf(stderr, "Warning: Failed to set sigalgs: %s\n", config->sigalgs);
+    }
+
+    // 단계별 타이밍 콜백 (trace를 연결한 SSL만 기록하므로 항상 설치)
+    hs_trace_install(ctx);
+
+    return ctx;
+}
+
+// 서버 SSL 컨텍스트 생성
+SSL_CTX* create_server_context(const tls_ctx_config_t *config) {
+    SSL_CTX *ctx = create_base_context(TLS_server_method(), config);
+    if (!ctx) {
+        return NULL;
+    }
+
+    // 서버 인증서 로드
+    if (SSL_CTX_use_certificate_file(ctx, config->cert_file, SSL_FILETYPE_PEM) <= 0) {
+        print_ssl_error("Failed to load certificate");
+        SSL_CTX_free(ctx);
+        return NULL;
+    }
+
+    // 서버 개인키 로드
+    if (SSL_CTX_use_PrivateKey_file(ctx, config->key_file, SSL_FILETYPE_PEM) <= 0) {
+        print_ssl_error("Failed to load private key");
+        SSL_CTX_free(ctx);
+        return NULL;
+    }
+
+    // mTLS 설정: 클라이언트 인증서 요구
+    SSL_CTX_set_verify(ctx, SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT, NULL);
+
+    // 클라이언트 인증 시 세션 재개에는 session id context가 필요
+    static const unsigned char sid_ctx[] = "tls13-pqc-bench";
+    SSL_CTX_set_session_id_context(ctx, sid_ctx, sizeof(sid_ctx) - 1);
+
+    // 0-RTT: stateless 티켓은 재전송 방지 시 early data를 거부하므로 벤치마크용으로 해제
+    if (config->early_data) {
+        SSL_CTX_set_max_early_data(ctx, TLS_MAX_EARLY_DATA);
+        SSL_CTX_set_options(ctx, SSL_OP_NO_ANTI_REPLAY);
+    }
+
+    // psk_ke: 허용만 하면 클라이언트가 psk_dhe_ke도 제시할 때 DHE가 선택됨
+    if (config->psk_ke) {
+        SSL_CTX_set_options(ctx, SSL_OP_ALLOW_NO_DHE_KEX);
+#ifdef SSL_OP_PREFER_NO_DHE_KEX
+        SSL_CTX_set_options(ctx, SSL_OP_PREFER_NO_DHE_KEX);
+#else
+        fprintf(stderr, "Warning: OpenSSL < 3.3 has no SSL_OP_PREFER_NO_DHE_KEX, resumption will use psk_dhe_ke\n");
+#endif
+    }
+
+    // CA 인증서 로드
+    if (SSL_CTX_load_verify_locations(ctx, config->ca_file, NULL) != 1) {
+        print_ssl_error("Failed to load CA certificate");
+        SSL_CTX_free(ctx);
+        return NULL;
+    }
+
+    // 인증서 압축 (미리 압축은 인증서 로드 이후여야 함, 실패해도 비압축으로 계속)
+    cert_comp_configure(ctx, config->cert_comp, config->cert_precompress);
+
+    return ctx;
+}
+
+// 클라이언트 SSL 컨텍스트 생성
+SSL_CTX* create_client_context(const tls_ctx_config_t *config) {
+    SSL_CTX *ctx = create_base_context(TLS_client_method(), config);
+    if (!ctx) {
+        return NULL;
+    }
+
+    // 클라이언트 인증서 로드 (mTLS)
+    if (SSL_CTX_use_certificate_file(ctx, config->cert_file, SSL_FILETYPE_PEM) <= 0) {
+        print_ssl_error("Failed to load client certificate");
+        SSL_CTX_free(ctx);
+        return NULL;
+    }
+
+    // 클라이언트 개인키 로드
+    if (SSL_CTX_use_PrivateKey_file(ctx, config->key_file, SSL_FILETYPE_PEM) <= 0) {
+        print_ssl_error("Failed to load client private key");
+        SSL_CTX_free(ctx);
+        return NULL;
+    }
+
+    // CA 인증서 로드 (서버 검증용)
+    if (SSL_CTX_load_verify_locations(ctx, config->ca_file, NULL) != 1) {
+        print_ssl_error("Failed to load CA certificate");
+        SSL_CTX_free(ctx);
+        return NULL;
+    }
+
+    // 서버 인증서 검증 활성화
+    SSL_CTX_set_verify(ctx, SSL_VERIFY_PEER, NULL);
+
+    // 인증서 압축: 서버 Certificate 수신(압축 해제)과 자신의 Certificate 송신 모두 적용
+    cert_comp_configure(ctx, config->cert_comp, false);
+
+    // psk_ke 제시 (연결별로 SSL_set_options/SSL_clear_options로도 바꿀 수 있음)
+    if (config->psk_ke) {
+        SSL_CTX_set_options(ctx, SSL_OP_ALLOW_NO_DHE_KEX);
+    }
+
+    return ctx;
+}
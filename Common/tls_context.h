@@ -0,0 +1,35 @@
+#ifndef TLS_CONTEXT_H
+#define TLS_CONTEXT_H
+
+#include <stdbool.h>
+#include <openssl/ssl.h>
+
+// SSL 컨텍스트 설정 (서버/클라이언트 공통)
+typedef struct {
+    const char *cert_file;
+    const char *key_file;
+    const char *ca_file;
+    const char *groups;
+    const char *sigalgs;
+    bool early_data;        // 서버: 0-RTT 수락 (max_early_data, anti-replay 해제)
+    bool psk_ke;            // psk_ke 허용 (서버는 지원 시 psk_dhe_ke보다 우선)
+    const char *cert_comp;  // 인증서 압축 선호 목록 "zlib,brotli,zstd" (NULL = 비활성, OpenSSL 3.2+)
+    bool cert_precompress;  // 서버: 컨텍스트 생성 시 체인을 미리 압축
+    OSSL_LIB_CTX *libctx;   // NULL = 기본 라이브러리 컨텍스트
+    const char *propq;      // 알고리즘 조회 속성 질의 (NULL = 없음)
+    bool async;             // SSL_MODE_ASYNC: 프로바이더가 작업을 멈추면 SSL_ERROR_WANT_ASYNC
+} tls_ctx_config_t;
+
+// 서버가 수락하는 최대 early data 크기
+#define TLS_MAX_EARLY_DATA 16384
+
+// OpenSSL 오류 출력
+void print_ssl_error(const char *msg);
+
+// 서버 컨텍스트: TLS 1.3, TLS_AES_128_GCM_SHA256, 클라이언트 인증서 필수(mTLS)
+SSL_CTX* create_server_context(const tls_ctx_config_t *config);
+
+// 클라이언트 컨텍스트: TLS 1.3, TLS_AES_128_GCM_SHA256, 서버 인증서 검증
+SSL_CTX* create_client_context(const tls_ctx_config_t *config);
+
+#endif // TLS_CONTEXT_H
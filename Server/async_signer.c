@@ -0,0 +1,620 @@
+#define _GNU_SOURCE
+#include "async_signer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/eventfd.h>
+#include <openssl/async.h>
+#include <openssl/conf.h>
+#include <openssl/core_dispatch.h>
+#include <openssl/core_names.h>
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/params.h>
+#include <openssl/provider.h>
+#include "../Common/tls_context.h"
+
+// 위임 대상 키 종류: <식별자, 키 관리 이름, 서명 연산 이름>
+//  - OpenSSL 3.0 기본 프로바이더, oqsprovider(dilithium/mldsa/sphincs), OpenSSL 3.5 내장 이름
+#define SIGNER_KEY_TYPES(X) \
+    X(ec, "EC", "ECDSA") \
+    X(ed25519, "ED25519", "ED25519") \
+    X(ed448, "ED448", "ED448") \
+    X(rsa, "RSA", "RSA") \
+    X(dilithium2, "dilithium2", "dilithium2") \
+    X(dilithium3, "dilithium3", "dilithium3") \
+    X(dilithium5, "dilithium5", "dilithium5") \
+    X(mldsa44, "mldsa44", "mldsa44") \
+    X(mldsa65, "mldsa65", "mldsa65") \
+    X(mldsa87, "mldsa87", "mldsa87") \
+    X(ml_dsa_44, "ML-DSA-44", "ML-DSA-44") \
+    X(ml_dsa_65, "ML-DSA-65", "ML-DSA-65") \
+    X(ml_dsa_87, "ML-DSA-87", "ML-DSA-87") \
+    X(sphincs128s, "sphincssha2128ssimple", "sphincssha2128ssimple") \
+    X(sphincs128f, "sphincssha2128fsimple", "sphincssha2128fsimple") \
+    X(slh_dsa_128s, "SLH-DSA-SHA2-128s", "SLH-DSA-SHA2-128s") \
+    X(slh_dsa_128f, "SLH-DSA-SHA2-128f", "SLH-DSA-SHA2-128f")
+
+// 가져온 키: 실제 키는 기본 라이브러리 컨텍스트(원래 프로바이더)에 다시 만들어 워커에서 사용
+typedef struct {
+    const char *type;
+    EVP_PKEY *pkey;
+} signer_key_t;
+
+// 서명/검증 컨텍스트: 설정만 모아 두고 실제 연산 때 원래 프로바이더 컨텍스트를 만듦
+typedef struct {
+    signer_key_t *key;
+    char mdname[64];        // "" = 다이제스트 없음 (Ed25519, ML-DSA)
+    bool verify;
+    OSSL_PARAM *params;     // set_ctx_params 누적 (패딩, salt 길이 등, 깊은 복사)
+    EVP_MD_CTX *stream;     // update/final 경로 (I/O 스레드에서 바로 처리)
+} signer_op_t;
+
+// 풀에 넘기는 작업 (제출한 ASYNC_JOB 스택에 있으므로 done 이후에는 접근 금지)
+typedef struct signer_job {
+    const signer_op_t *op;
+    unsigned char *sig;
+    size_t siglen;
+    size_t sigsize;
+    const unsigned char *tbs;
+    size_t tbslen;
+    int ret;
+    int efd;                // 완료 알림 (ASYNC_WAIT_CTX 대기 fd)
+    uint64_t submit_ns;
+    uint64_t start_ns;
+    uint64_t end_ns;
+    atomic_bool done;
+    struct signer_job *next;
+} signer_job_t;
+
+static struct {
+    OSSL_LIB_CTX *libctx;
+    OSSL_PROVIDER *provider;
+    OSSL_PROVIDER *base;
+    pthread_t *threads;
+    int count;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    signer_job_t *head;
+    signer_job_t *tail;
+    uint64_t depth;
+    bool stop;
+    atomic_bool running;
+    signer_stats_t stats;
+} pool = { .lock = PTHREAD_MUTEX_INITIALIZER, .cond = PTHREAD_COND_INITIALIZER };
+
+static __thread signer_account_t *current;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// ---------------------------------------------------------------------------
+// 실제 연산 (원래 프로바이더, 워커 또는 호출 스레드에서 실행)
+// ---------------------------------------------------------------------------
+
+static EVP_MD_CTX* op_begin(const signer_op_t *op) {
+    EVP_MD_CTX *md = EVP_MD_CTX_new();
+    EVP_PKEY_CTX *pctx = NULL;
+    const char *mdname = op->mdname[0] ? op->mdname : NULL;
+    if (!md) {
+        return NULL;
+    }
+    int ok = op->verify
+        ? EVP_DigestVerifyInit_ex(md, &pctx, mdname, NULL, NULL, op->key->pkey, NULL)
+        : EVP_DigestSignInit_ex(md, &pctx, mdname, NULL, NULL, op->key->pkey, NULL);
+    if (ok <= 0 || (op->params && !EVP_PKEY_CTX_set_params(pctx, op->params))) {
+        EVP_MD_CTX_free(md);
+        return NULL;
+    }
+    return md;
+}
+
+// 한 번에 서명(siglen 갱신) 또는 검증, 1: 성공
+static int op_run(const signer_op_t *op, unsigned char *sig, size_t *siglen, size_t sigsize,
+                  const unsigned char *tbs, size_t tbslen) {
+    EVP_MD_CTX *md = op_begin(op);
+    int ret = 0;
+    if (md) {
+        if (op->verify) {
+            ret = EVP_DigestVerify(md, sig, *siglen, tbs, tbslen) == 1;
+        } else {
+            *siglen = sigsize;
+            ret = EVP_DigestSign(md, sig, siglen, tbs, tbslen) == 1;
+        }
+        EVP_MD_CTX_free(md);
+    }
+    return ret;
+}
+
+// ---------------------------------------------------------------------------
+// 워커 풀
+// ---------------------------------------------------------------------------
+
+static void* worker_main(void *arg) {
+    (void)arg;
+    for (;;) {
+        pthread_mutex_lock(&pool.lock);
+        while (!pool.head && !pool.stop) {
+            pthread_cond_wait(&pool.cond, &pool.lock);
+        }
+        signer_job_t *job = pool.head;
+        if (!job) {
+            pthread_mutex_unlock(&pool.lock);
+            break;
+        }
+        pool.head = job->next;
+        if (!pool.head) {
+            pool.tail = NULL;
+        }
+        pool.depth--;
+        pthread_mutex_unlock(&pool.lock);
+
+        job->start_ns = now_ns();
+        job->ret = op_run(job->op, job->sig, &job->siglen, job->sigsize, job->tbs, job->tbslen);
+        job->end_ns = now_ns();
+        ERR_clear_error();
+
+        pthread_mutex_lock(&pool.lock);
+        pool.stats.jobs++;
+        hist_record(&pool.stats.queue_ms, (job->start_ns - job->submit_ns) / 1e6);
+        hist_record(job->op->verify ? &pool.stats.verify_ms : &pool.stats.sign_ms,
+                    (job->end_ns - job->start_ns) / 1e6);
+        pthread_mutex_unlock(&pool.lock);
+
+        // 알림을 먼저 보내고 done을 마지막에 설정 (done 이후 작업은 해제될 수 있음)
+        uint64_t one = 1;
+        if (write(job->efd, &one, sizeof(one)) != sizeof(one)) {
+            perror("eventfd write");
+        }
+        atomic_store(&job->done, true);
+    }
+    return NULL;
+}
+
+// ASYNC_JOB 안이면 풀에 넘기고 완료까지 작업을 멈춤, 밖이면 바로 처리
+static int op_offload(const signer_op_t *op, unsigned char *sig, size_t *siglen, size_t sigsize,
+                      const unsigned char *tbs, size_t tbslen) {
+    ASYNC_JOB *async = ASYNC_get_current_job();
+    ASYNC_WAIT_CTX *waitctx = async ? ASYNC_get_wait_ctx(async) : NULL;
+    int efd = waitctx && atomic_load(&pool.running) ? eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC) : -1;
+    if (efd < 0 || !ASYNC_WAIT_CTX_set_wait_fd(waitctx, &pool, efd, NULL, NULL)) {
+        if (efd >= 0) {
+            close(efd);
+        }
+        pthread_mutex_lock(&pool.lock);
+        pool.stats.inline_jobs++;
+        pthread_mutex_unlock(&pool.lock);
+        return op_run(op, sig, siglen, sigsize, tbs, tbslen);
+    }
+
+    signer_job_t job = {
+        .op = op,
+        .sig = sig,
+        .siglen = *siglen,
+        .sigsize = sigsize,
+        .tbs = tbs,
+        .tbslen = tbslen,
+        .efd = efd,
+        .submit_ns = now_ns()
+    };
+    atomic_init(&job.done, false);
+
+    pthread_mutex_lock(&pool.lock);
+    if (pool.tail) {
+        pool.tail->next = &job;
+    } else {
+        pool.head = &job;
+    }
+    pool.tail = &job;
+    if (++pool.depth > pool.stats.queue_peak) {
+        pool.stats.queue_peak = pool.depth;
+    }
+    pthread_cond_signal(&pool.cond);
+    pthread_mutex_unlock(&pool.lock);
+
+    // I/O 스레드는 SSL_ERROR_WANT_ASYNC를 받고 다른 연결을 처리, fd가 읽기 가능해지면 재개
+    while (!atomic_load(&job.done)) {
+        ASYNC_pause_job();
+    }
+    ASYNC_WAIT_CTX_clear_fd(waitctx, &pool);
+    close(efd);
+
+    if (current) {
+        current->queue_ns += job.start_ns - job.submit_ns;
+        if (op->verify) {
+            current->verify_jobs++;
+            current->verify_ns += job.end_ns - job.start_ns;
+        } else {
+            current->sign_jobs++;
+            current->sign_ns += job.end_ns - job.start_ns;
+        }
+    }
+    *siglen = job.siglen;
+    return job.ret;
+}
+
+// ---------------------------------------------------------------------------
+// 키 관리: 가져오기 전용 (원래 키를 기본 컨텍스트에 다시 만듦)
+// ---------------------------------------------------------------------------
+
+static void keymgmt_free(void *keydata) {
+    signer_key_t *key = keydata;
+    if (key) {
+        EVP_PKEY_free(key->pkey);
+        free(key);
+    }
+}
+
+static int keymgmt_has(const void *keydata, int selection) {
+    (void)selection;
+    const signer_key_t *key = keydata;
+    return key && key->pkey;
+}
+
+static int keymgmt_import(void *keydata, int selection, const OSSL_PARAM params[]) {
+    (void)selection;
+    signer_key_t *key = keydata;
+    bool private = OSSL_PARAM_locate_const(params, OSSL_PKEY_PARAM_PRIV_KEY) ||
+                   OSSL_PARAM_locate_const(params, OSSL_PKEY_PARAM_RSA_D);
+    EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new_from_name(NULL, key->type, NULL);
+    int ok = ctx && EVP_PKEY_fromdata_init(ctx) == 1 &&
+             EVP_PKEY_fromdata(ctx, &key->pkey, private ? EVP_PKEY_KEYPAIR : EVP_PKEY_PUBLIC_KEY,
+                               (OSSL_PARAM*)params) == 1;
+    EVP_PKEY_CTX_free(ctx);
+    return ok;
+}
+
+static const OSSL_PARAM* keymgmt_import_types(int selection) {
+    (void)selection;
+    static const OSSL_PARAM types[] = {
+        OSSL_PARAM_utf8_string(OSSL_PKEY_PARAM_GROUP_NAME, NULL, 0),
+        OSSL_PARAM_octet_string(OSSL_PKEY_PARAM_PUB_KEY, NULL, 0),
+        OSSL_PARAM_octet_string(OSSL_PKEY_PARAM_PRIV_KEY, NULL, 0),
+        OSSL_PARAM_BN(OSSL_PKEY_PARAM_RSA_N, NULL, 0),
+        OSSL_PARAM_BN(OSSL_PKEY_PARAM_RSA_E, NULL, 0),
+        OSSL_PARAM_BN(OSSL_PKEY_PARAM_RSA_D, NULL, 0),
+        OSSL_PARAM_END
+    };
+    return types;
+}
+
+#define SIGNER_KEYMGMT(id, keytype, opname) \
+    static void* keymgmt_new_##id(void *provctx) { \
+        (void)provctx; \
+        signer_key_t *key = calloc(1, sizeof(signer_key_t)); \
+        if (key) key->type = keytype; \
+        return key; \
+    } \
+    static const char* keymgmt_opname_##id(int operation_id) { \
+        return operation_id == OSSL_OP_SIGNATURE ? opname : NULL; \
+    } \
+    static const OSSL_DISPATCH keymgmt_##id[] = { \
+        { OSSL_FUNC_KEYMGMT_NEW, (void (*)(void))keymgmt_new_##id }, \
+        { OSSL_FUNC_KEYMGMT_FREE, (void (*)(void))keymgmt_free }, \
+        { OSSL_FUNC_KEYMGMT_HAS, (void (*)(void))keymgmt_has }, \
+        { OSSL_FUNC_KEYMGMT_IMPORT, (void (*)(void))keymgmt_import }, \
+        { OSSL_FUNC_KEYMGMT_IMPORT_TYPES, (void (*)(void))keymgmt_import_types }, \
+        { OSSL_FUNC_KEYMGMT_QUERY_OPERATION_NAME, (void (*)(void))keymgmt_opname_##id }, \
+        { 0, NULL } \
+    };
+SIGNER_KEY_TYPES(SIGNER_KEYMGMT)
+
+// ---------------------------------------------------------------------------
+// 서명: 한 번에 하는 서명/검증만 풀로 넘김 (TLS CertificateVerify 경로)
+// ---------------------------------------------------------------------------
+
+static void* sig_newctx(void *provctx, const char *propq) {
+    (void)provctx;
+    (void)propq;
+    return calloc(1, sizeof(signer_op_t));
+}
+
+static void sig_reset(signer_op_t *op) {
+    OSSL_PARAM_free(op->params);
+    op->params = NULL;
+    EVP_MD_CTX_free(op->stream);
+    op->stream = NULL;
+}
+
+static void sig_freectx(void *ctx) {
+    signer_op_t *op = ctx;
+    if (op) {
+        sig_reset(op);
+        free(op);
+    }
+}
+
+static int sig_set_ctx_params(void *ctx, const OSSL_PARAM params[]) {
+    signer_op_t *op = ctx;
+    if (!params || !params[0].key) {
+        return 1;
+    }
+    OSSL_PARAM *merged = OSSL_PARAM_merge(op->params, params);
+    OSSL_PARAM *copy = merged ? OSSL_PARAM_dup(merged) : NULL;
+    OSSL_PARAM_free(merged);
+    if (!copy) {
+        return 0;
+    }
+    OSSL_PARAM_free(op->params);
+    op->params = copy;
+    return 1;
+}
+
+static const OSSL_PARAM* sig_settable_ctx_params(void *ctx, void *provctx) {
+    (void)ctx;
+    (void)provctx;
+    static const OSSL_PARAM settable[] = {
+        OSSL_PARAM_utf8_string(OSSL_SIGNATURE_PARAM_DIGEST, NULL, 0),
+        OSSL_PARAM_utf8_string(OSSL_SIGNATURE_PARAM_PAD_MODE, NULL, 0),
+        OSSL_PARAM_utf8_string(OSSL_SIGNATURE_PARAM_PSS_SALTLEN, NULL, 0),
+        OSSL_PARAM_utf8_string(OSSL_SIGNATURE_PARAM_MGF1_DIGEST, NULL, 0),
+        OSSL_PARAM_END
+    };
+    return settable;
+}
+
+static int sig_init(signer_op_t *op, const char *mdname, void *provkey, const OSSL_PARAM params[],
+                    bool verify) {
+    signer_key_t *key = provkey;
+    if (!key || !key->pkey) {
+        return 0;
+    }
+    sig_reset(op);
+    op->key = key;
+    op->verify = verify;
+    snprintf(op->mdname, sizeof(op->mdname), "%s", mdname ? mdname : "");
+    return sig_set_ctx_params(op, params);
+}
+
+static int sig_digest_sign_init(void *ctx, const char *mdname, void *provkey, const OSSL_PARAM params[]) {
+    return sig_init(ctx, mdname, provkey, params, false);
+}
+
+static int sig_digest_verify_init(void *ctx, const char *mdname, void *provkey, const OSSL_PARAM params[]) {
+    return sig_init(ctx, mdname, provkey, params, true);
+}
+
+static int sig_stream_update(void *ctx, const unsigned char *data, size_t len) {
+    signer_op_t *op = ctx;
+    if (!op->stream && !(op->stream = op_begin(op))) {
+        return 0;
+    }
+    return op->verify ? EVP_DigestVerifyUpdate(op->stream, data, len) == 1
+                      : EVP_DigestSignUpdate(op->stream, data, len) == 1;
+}
+
+static int sig_digest_sign_final(void *ctx, unsigned char *sig, size_t *siglen, size_t sigsize) {
+    signer_op_t *op = ctx;
+    if (!sig) {
+        *siglen = (size_t)EVP_PKEY_get_size(op->key->pkey);
+        return 1;
+    }
+    if (!op->stream && !(op->stream = op_begin(op))) {
+        return 0;
+    }
+    *siglen = sigsize;
+    return EVP_DigestSignFinal(op->stream, sig, siglen) == 1;
+}
+
+static int sig_digest_verify_final(void *ctx, const unsigned char *sig, size_t siglen) {
+    signer_op_t *op = ctx;
+    if (!op->stream && !(op->stream = op_begin(op))) {
+        return 0;
+    }
+    return EVP_DigestVerifyFinal(op->stream, sig, siglen) == 1;
+}
+
+static int sig_digest_sign(void *ctx, unsigned char *sig, size_t *siglen, size_t sigsize,
+                           const unsigned char *tbs, size_t tbslen) {
+    signer_op_t *op = ctx;
+    if (!sig) {
+        *siglen = (size_t)EVP_PKEY_get_size(op->key->pkey);
+        return 1;
+    }
+    return op_offload(op, sig, siglen, sigsize, tbs, tbslen);
+}
+
+static int sig_digest_verify(void *ctx, const unsigned char *sig, size_t siglen,
+                             const unsigned char *tbs, size_t tbslen) {
+    return op_offload(ctx, (unsigned char*)sig, &siglen, siglen, tbs, tbslen);
+}
+
+static const OSSL_DISPATCH signature_functions[] = {
+    { OSSL_FUNC_SIGNATURE_NEWCTX, (void (*)(void))sig_newctx },
+    { OSSL_FUNC_SIGNATURE_FREECTX, (void (*)(void))sig_freectx },
+    { OSSL_FUNC_SIGNATURE_DIGEST_SIGN_INIT, (void (*)(void))sig_digest_sign_init },
+    { OSSL_FUNC_SIGNATURE_DIGEST_SIGN_UPDATE, (void (*)(void))sig_stream_update },
+    { OSSL_FUNC_SIGNATURE_DIGEST_SIGN_FINAL, (void (*)(void))sig_digest_sign_final },
+    { OSSL_FUNC_SIGNATURE_DIGEST_SIGN, (void (*)(void))sig_digest_sign },
+    { OSSL_FUNC_SIGNATURE_DIGEST_VERIFY_INIT, (void (*)(void))sig_digest_verify_init },
+    { OSSL_FUNC_SIGNATURE_DIGEST_VERIFY_UPDATE, (void (*)(void))sig_stream_update },
+    { OSSL_FUNC_SIGNATURE_DIGEST_VERIFY_FINAL, (void (*)(void))sig_digest_verify_final },
+    { OSSL_FUNC_SIGNATURE_DIGEST_VERIFY, (void (*)(void))sig_digest_verify },
+    { OSSL_FUNC_SIGNATURE_SET_CTX_PARAMS, (void (*)(void))sig_set_ctx_params },
+    { OSSL_FUNC_SIGNATURE_SETTABLE_CTX_PARAMS, (void (*)(void))sig_settable_ctx_params },
+    { 0, NULL }
+};
+
+// ---------------------------------------------------------------------------
+// 프로바이더
+//  - 서명만 provider=signer_offload 속성을 가져 SIGNER_PROPQ에서 우선 선택됨
+//  - 키 관리는 그 속성이 없어 일반 조회(ECDHE 키 생성 등)는 기본 프로바이더로 감,
+//    서명 초기화 시 서명과 같은 프로바이더에서 이름으로 찾아 키를 내보낼 때만 사용
+// ---------------------------------------------------------------------------
+
+#define SIGNER_KEYMGMT_ALG(id, keytype, opname) \
+    { keytype, "signer_offload.import=yes", keymgmt_##id, NULL },
+#define SIGNER_SIGNATURE_ALG(id, keytype, opname) \
+    { opname, "provider=" SIGNER_PROVIDER_NAME, signature_functions, NULL },
+
+static const OSSL_ALGORITHM keymgmt_algs[] = {
+    SIGNER_KEY_TYPES(SIGNER_KEYMGMT_ALG)
+    { NULL, NULL, NULL, NULL }
+};
+
+static const OSSL_ALGORITHM signature_algs[] = {
+    SIGNER_KEY_TYPES(SIGNER_SIGNATURE_ALG)
+    { NULL, NULL, NULL, NULL }
+};
+
+static const OSSL_ALGORITHM* provider_query(void *provctx, int operation_id, int *no_cache) {
+    (void)provctx;
+    *no_cache = 0;
+    switch (operation_id) {
+    case OSSL_OP_KEYMGMT:
+        return keymgmt_algs;
+    case OSSL_OP_SIGNATURE:
+        return signature_algs;
+    default:
+        return NULL;
+    }
+}
+
+static const OSSL_DISPATCH provider_functions[] = {
+    { OSSL_FUNC_PROVIDER_QUERY_OPERATION, (void (*)(void))provider_query },
+    { 0, NULL }
+};
+
+static int provider_init(const OSSL_CORE_HANDLE *handle, const OSSL_DISPATCH *in,
+                         const OSSL_DISPATCH **out, void **provctx) {
+    (void)in;
+    *out = provider_functions;
+    *provctx = (void*)handle;
+    return 1;
+}
+
+// ---------------------------------------------------------------------------
+
+int signer_pool_start(int threads) {
+    if (threads <= 0) {
+        fprintf(stderr, "Invalid signer thread count: %d\n", threads);
+        return -1;
+    }
+
+    // 기본 컨텍스트와 같은 설정 파일(oqsprovider 등)을 읽고 기본 프로바이더를 보장한 뒤 오프로드 프로바이더 추가
+    pool.libctx = OSSL_LIB_CTX_new();
+    char *conf = CONF_get1_default_config_file();
+    if (pool.libctx && conf && access(conf, R_OK) == 0 && !OSSL_LIB_CTX_load_config(pool.libctx, conf)) {
+        fprintf(stderr, "Warning: Failed to load %s into the signer context\n", conf);
+    }
+    OPENSSL_free(conf);
+    if (!pool.libctx ||
+        !(pool.base = OSSL_PROVIDER_try_load(pool.libctx, "default", 1)) ||
+        !OSSL_PROVIDER_add_builtin(pool.libctx, SIGNER_PROVIDER_NAME, provider_init) ||
+        !(pool.provider = OSSL_PROVIDER_load(pool.libctx, SIGNER_PROVIDER_NAME))) {
+        print_ssl_error("Failed to load the signer offload provider");
+        signer_pool_stop(NULL);
+        return -1;
+    }
+
+    pool.threads = calloc(threads, sizeof(pthread_t));
+    if (!pool.threads) {
+        signer_pool_stop(NULL);
+        return -1;
+    }
+    hist_reset(&pool.stats.queue_ms);
+    hist_reset(&pool.stats.sign_ms);
+    hist_reset(&pool.stats.verify_ms);
+    pool.stop = false;
+    for (int i = 0; i < threads; i++) {
+        if (pthread_create(&pool.threads[i], NULL, worker_main, NULL) != 0) {
+            perror("pthread_create");
+            signer_pool_stop(NULL);
+            return -1;
+        }
+        pool.count++;
+    }
+    pool.stats.threads = threads;
+    atomic_store(&pool.running, true);
+    return 0;
+}
+
+OSSL_LIB_CTX* signer_libctx(void) {
+    return pool.libctx;
+}
+
+signer_account_t* signer_switch(signer_account_t *account) {
+    signer_account_t *prev = current;
+    current = account;
+    return prev;
+}
+
+bool signer_wait(SSL *ssl) {
+    OSSL_ASYNC_FD fds[4];
+    size_t n = 0;
+    if (!SSL_get_all_async_fds(ssl, NULL, &n) || n == 0 || n > 4 ||
+        !SSL_get_all_async_fds(ssl, fds, &n)) {
+        return false;
+    }
+    struct pollfd pfds[4];
+    for (size_t i = 0; i < n; i++) {
+        pfds[i].fd = fds[i];
+        pfds[i].events = POLLIN;
+    }
+    while (poll(pfds, n, -1) < 0) {
+        if (errno != EINTR) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void signer_pool_stop(signer_stats_t *stats) {
+    atomic_store(&pool.running, false);
+
+    // 남은 작업은 워커가 모두 처리한 뒤 종료
+    pthread_mutex_lock(&pool.lock);
+    pool.stop = true;
+    pthread_cond_broadcast(&pool.cond);
+    pthread_mutex_unlock(&pool.lock);
+    for (int i = 0; i < pool.count; i++) {
+        pthread_join(pool.threads[i], NULL);
+    }
+    free(pool.threads);
+    pool.threads = NULL;
+    pool.count = 0;
+
+    if (stats) {
+        *stats = pool.stats;
+    }
+    if (pool.provider) {
+        OSSL_PROVIDER_unload(pool.provider);
+    }
+    if (pool.base) {
+        OSSL_PROVIDER_unload(pool.base);
+    }
+    OSSL_LIB_CTX_free(pool.libctx);
+    pool.provider = NULL;
+    pool.base = NULL;
+    pool.libctx = NULL;
+}
+
+void print_signer_stats(const signer_stats_t *stats) {
+    stats_t queue, sign, verify;
+    hist_stats(&stats->queue_ms, &queue);
+    hist_stats(&stats->sign_ms, &sign);
+    hist_stats(&stats->verify_ms, &verify);
+    printf("Signer pool: %d thread(s), %lu offloaded, %lu inline, queue peak %lu\n",
+           stats->threads, stats->jobs, stats->inline_jobs, stats->queue_peak);
+    if (stats->jobs > 0) {
+        printf("  Queue wait: mean %.3f ms, p50 %.3f, p99 %.3f, max %.3f\n",
+               queue.mean, queue.p50, queue.p99, queue.max);
+    }
+    if (sign.count > 0) {
+        printf("  Sign:   %lu job(s), mean %.3f ms, p50 %.3f, p99 %.3f, max %.3f\n",
+               sign.count, sign.mean, sign.p50, sign.p99, sign.max);
+    }
+    if (verify.count > 0) {
+        printf("  Verify: %lu job(s), mean %.3f ms, p50 %.3f, p99 %.3f, max %.3f\n",
+               verify.count, verify.mean, verify.p50, verify.p99, verify.max);
+    }
+}
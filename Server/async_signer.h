@@ -0,0 +1,53 @@
+#ifndef ASYNC_SIGNER_H
+#define ASYNC_SIGNER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <openssl/ssl.h>
+#include "../Common/histogram.h"
+
+// 서명 오프로드 프로바이더 이름과 서버 SSL_CTX 속성 질의 (이 프로바이더 구현을 우선 선택)
+#define SIGNER_PROVIDER_NAME "signer_offload"
+#define SIGNER_PROPQ "?provider=" SIGNER_PROVIDER_NAME
+
+// 연결별 서명 시간 (I/O 스레드에서 signer_switch로 지정)
+typedef struct {
+    uint64_t sign_jobs;     // CertificateVerify 서명
+    uint64_t verify_jobs;   // 클라이언트 체인/CertificateVerify 서명 검증
+    uint64_t queue_ns;      // 제출 → 워커 시작 (서명 + 검증)
+    uint64_t sign_ns;       // 워커에서 실제 서명
+    uint64_t verify_ns;     // 워커에서 실제 검증
+} signer_account_t;
+
+// 풀 전체 통계 (ms 단위 히스토그램)
+typedef struct {
+    int threads;
+    uint64_t jobs;          // 워커에서 처리한 작업
+    uint64_t inline_jobs;   // 비동기 작업 밖에서 호출되어 호출 스레드에서 바로 처리
+    uint64_t queue_peak;    // 최대 대기 작업 수
+    histogram_t queue_ms;
+    histogram_t sign_ms;    // 서명만
+    histogram_t verify_ms;  // 검증만
+} signer_stats_t;
+
+// 서명 워커 N개 시작, 프로바이더를 등록한 전용 라이브러리 컨텍스트 준비 (실패 시 -1)
+//  - 서버 SSL_CTX를 signer_libctx() + SIGNER_PROPQ로 만들고 SSL_MODE_ASYNC를 켜면
+//    CertificateVerify 서명(과 클라이언트 서명 검증)이 ASYNC_JOB 안에서 풀로 넘어가고
+//    SSL_accept는 SSL_ERROR_WANT_ASYNC로 돌아옴 (SSL_get_all_async_fds가 완료 시 읽기 가능)
+int signer_pool_start(int threads);
+
+// 프로바이더를 로드한 라이브러리 컨텍스트 (시작 전이면 NULL)
+OSSL_LIB_CTX* signer_libctx(void);
+
+// 현재 스레드의 연결 계정 교체, 이전 계정 반환 (NULL: 풀 통계만)
+signer_account_t* signer_switch(signer_account_t *account);
+
+// 블로킹 모드: SSL_ERROR_WANT_ASYNC 후 대기 fd가 읽기 가능해질 때까지 대기 (실패 시 false)
+bool signer_wait(SSL *ssl);
+
+// 워커 정지 및 통계 수집 (stats NULL 가능)
+void signer_pool_stop(signer_stats_t *stats);
+
+void print_signer_stats(const signer_stats_t *stats);
+
+#endif // ASYNC_SIGNER_H
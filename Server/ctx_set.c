@@ -0,0 +1,194 @@
+#include "ctx_set.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <openssl/err.h>
+
+// 조합 인증서 경로 (<OpenSSL 그룹>_<OpenSSL 서명>_server.{crt,key})
+static void combo_paths(const char *certs_dir, const algo_combo_t *combo,
+                        char *cert, char *key, size_t len) {
+    snprintf(cert, len, "%s/%s_%s_server.crt", certs_dir, combo->ossl_group, combo->ossl_sigalg);
+    snprintf(key, len, "%s/%s_%s_server.key", certs_dir, combo->ossl_group, combo->ossl_sigalg);
+}
+
+// 목록에 없는 그룹만 ':'로 이어 붙임
+static void add_group(char *list, size_t len, const char *group) {
+    size_t n = strlen(group);
+    for (const char *p = list; *p; ) {
+        const char *end = strchr(p, ':');
+        size_t item = end ? (size_t)(end - p) : strlen(p);
+        if (item == n && strncmp(p, group, n) == 0) {
+            return;
+        }
+        p += item + (end ? 1 : 0);
+    }
+    size_t used = strlen(list);
+    snprintf(list + used, len - used, "%s%s", used ? ":" : "", group);
+}
+
+// 수락한 소켓의 로컬 포트 (실패 시 0)
+static int local_port(const SSL *ssl) {
+    struct sockaddr_in addr;
+    socklen_t len = sizeof(addr);
+    int fd = SSL_get_fd(ssl);
+    if (fd < 0 || getsockname(fd, (struct sockaddr*)&addr, &len) < 0 || addr.sin_family != AF_INET) {
+        return 0;
+    }
+    return ntohs(addr.sin_port);
+}
+
+// servername 콜백: SNI → 수락 포트 → 첫 조합 순으로 컨텍스트 선택
+static int select_ctx(SSL *ssl, int *alert, void *arg) {
+    (void)alert;
+    ctx_set_t *set = arg;
+    ctx_entry_t *entry = NULL;
+
+    const char *sni = SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name);
+    for (int i = 0; sni && i < set->count; i++) {
+        if (strcasecmp(set->entries[i].name, sni) == 0) {
+            entry = &set->entries[i];
+            break;
+        }
+    }
+    if (!entry && set->entries[0].port > 0) {
+        int port = local_port(ssl);
+        for (int i = 0; i < set->count; i++) {
+            if (set->entries[i].port == port) {
+                entry = &set->entries[i];
+                break;
+            }
+        }
+    }
+    if (!entry) {
+        entry = &set->entries[0];
+        atomic_fetch_add(&set->unmatched, 1);
+    }
+
+    if (SSL_set_SSL_CTX(ssl, entry->ctx) != entry->ctx) {
+        return SSL_TLSEXT_ERR_ALERT_FATAL;
+    }
+    atomic_fetch_add(&entry->selected, 1);
+    return SSL_TLSEXT_ERR_OK;
+}
+
+ctx_set_t* ctx_set_load(const char *certs_dir, const tls_ctx_config_t *base) {
+    ctx_set_t *set = calloc(1, sizeof(ctx_set_t));
+    if (!set) {
+        return NULL;
+    }
+    if (algo_matrix_load(NULL, &set->matrix) != 0) {
+        free(set);
+        return NULL;
+    }
+
+    char cert[600], key[600], ca[600];
+    snprintf(ca, sizeof(ca), "%s/ca.crt", certs_dir);
+
+    for (int i = 0; i < set->matrix.combo_count; i++) {
+        const algo_combo_t *combo = &set->matrix.combos[i];
+        const char *reason = NULL;
+        if (!algo_combo_probe(combo, &reason)) {
+            printf("  skip %s:%s (%s)\n", combo->group, combo->sigalg, reason);
+            continue;
+        }
+
+        combo_paths(certs_dir, combo, cert, key, sizeof(cert));
+        tls_ctx_config_t config = *base;
+        config.cert_file = cert;
+        config.key_file = key;
+        config.ca_file = ca;
+        config.groups = combo->ossl_group;
+        config.sigalgs = combo->ossl_sigalg;
+
+        SSL_CTX *ctx = create_server_context(&config);
+        if (!ctx) {
+            ERR_clear_error();
+            printf("  skip %s:%s (certificate or context setup failed)\n", combo->group, combo->sigalg);
+            continue;
+        }
+
+        ctx_entry_t *entry = &set->entries[set->count++];
+        snprintf(entry->name, sizeof(entry->name), "%s.%s", combo->group, combo->sigalg);
+        entry->combo = combo;
+        entry->ctx = ctx;
+        atomic_init(&entry->selected, 0);
+        add_group(set->groups, sizeof(set->groups), combo->ossl_group);
+    }
+
+    if (set->count == 0) {
+        fprintf(stderr, "No usable combo in %s\n", certs_dir);
+        free(set);
+        return NULL;
+    }
+
+    // front: 첫 조합 인증서 + 모든 그룹, 실제 인증서/서명은 콜백에서 전환
+    combo_paths(certs_dir, set->entries[0].combo, cert, key, sizeof(cert));
+    tls_ctx_config_t config = *base;
+    config.cert_file = cert;
+    config.key_file = key;
+    config.ca_file = ca;
+    config.groups = set->groups;
+    config.sigalgs = NULL;
+    set->front = create_server_context(&config);
+    if (!set->front) {
+        ctx_set_free(set);
+        return NULL;
+    }
+    SSL_CTX_set_tlsext_servername_callback(set->front, select_ctx);
+    SSL_CTX_set_tlsext_servername_arg(set->front, set);
+    atomic_init(&set->unmatched, 0);
+    return set;
+}
+
+void ctx_set_assign_ports(ctx_set_t *set, int first_port) {
+    for (int i = 0; i < set->count; i++) {
+        set->entries[i].port = first_port + i;
+    }
+}
+
+const char* ctx_set_selected(const ctx_set_t *set, const SSL *ssl) {
+    SSL_CTX *ctx = SSL_get_SSL_CTX(ssl);
+    for (int i = 0; i < set->count; i++) {
+        if (set->entries[i].ctx == ctx) {
+            return set->entries[i].name;
+        }
+    }
+    return NULL;
+}
+
+void ctx_set_print(const ctx_set_t *set) {
+    printf("Combos: %d loaded (groups %s)\n", set->count, set->groups);
+    for (int i = 0; i < set->count; i++) {
+        const ctx_entry_t *e = &set->entries[i];
+        if (e->port > 0) {
+            printf("  SNI %-42s port %d%s\n", e->name, e->port, i == 0 ? " (default)" : "");
+        } else {
+            printf("  SNI %s%s\n", e->name, i == 0 ? " (default)" : "");
+        }
+    }
+}
+
+void ctx_set_print_stats(const ctx_set_t *set) {
+    printf("Connections per combo:\n");
+    for (int i = 0; i < set->count; i++) {
+        uint64_t n = atomic_load(&set->entries[i].selected);
+        if (n > 0) {
+            printf("  %-42s %lu\n", set->entries[i].name, (unsigned long)n);
+        }
+    }
+    printf("  unmatched SNI/port (default): %lu\n", (unsigned long)atomic_load(&set->unmatched));
+}
+
+void ctx_set_free(ctx_set_t *set) {
+    if (!set) {
+        return;
+    }
+    for (int i = 0; i < set->count; i++) {
+        SSL_CTX_free(set->entries[i].ctx);
+    }
+    SSL_CTX_free(set->front);
+    free(set);
+}
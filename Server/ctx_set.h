@@ -0,0 +1,50 @@
+#ifndef CTX_SET_H
+#define CTX_SET_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <openssl/ssl.h>
+#include "../Common/algo_config.h"
+#include "../Common/tls_context.h"
+
+#define CTX_SET_GROUPS_MAX (ALGO_MAX_GROUPS * ALGO_NAME_MAX)
+
+// 조합 하나의 서버 컨텍스트 (시작 시 만들어 종료까지 유지)
+typedef struct {
+    char name[2 * ALGO_NAME_MAX + 1];   // SNI 이름 "<group>.<sigalg>" (매트릭스 이름)
+    const algo_combo_t *combo;
+    SSL_CTX *ctx;
+    int port;                           // 조합 전용 리스닝 포트 (0: SNI로만 선택)
+    atomic_uint_fast64_t selected;      // 이 조합으로 처리한 연결 수
+} ctx_entry_t;
+
+// 한 프로세스가 모든 조합을 서비스하는 컨텍스트 묶음
+//  - SSL_new는 front로 하고 servername 콜백에서 SNI → 포트 → 첫 조합 순으로 골라 SSL_set_SSL_CTX
+//  - key_share는 콜백 전에 처리되므로 front는 모든 조합 그룹의 합집합을 허용 (인증서/서명만 전환)
+typedef struct {
+    algo_matrix_t matrix;
+    ctx_entry_t entries[ALGO_MAX_COMBOS];
+    int count;
+    SSL_CTX *front;
+    char groups[CTX_SET_GROUPS_MAX];    // front 그룹 목록 (조합 순서대로 중복 제거)
+    atomic_uint_fast64_t unmatched;     // SNI/포트가 맞지 않아 첫 조합으로 처리한 연결 수
+} ctx_set_t;
+
+// 매트릭스의 모든 조합을 certs_dir에서 로드 (base: 인증서/그룹/서명 외 공통 설정)
+// 설정할 수 없거나 인증서가 없는 조합은 건너뜀, 하나도 없으면 NULL
+ctx_set_t* ctx_set_load(const char *certs_dir, const tls_ctx_config_t *base);
+
+// 조합 i에 first_port + i 포트를 배정 (SNI가 없을 때 수락한 포트로 선택)
+void ctx_set_assign_ports(ctx_set_t *set, int first_port);
+
+// 연결이 선택된 조합 이름 (핸드셰이크 전이면 NULL)
+const char* ctx_set_selected(const ctx_set_t *set, const SSL *ssl);
+
+// 조합/SNI/포트 대응표, 종료 시 조합별 연결 수 출력
+void ctx_set_print(const ctx_set_t *set);
+void ctx_set_print_stats(const ctx_set_t *set);
+
+void ctx_set_free(ctx_set_t *set);
+
+#endif // CTX_SET_H
@@ -0,0 +1,1260 @@
+#define _GNU_SOURCE
+#include "server_engine.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <linux/filter.h>
+#include <openssl/err.h>
+#include "../Common/metrics.h"
+#include "../Common/handshake_trace.h"
+#include "../Common/count_bio.h"
+#include "../Common/perf_counters.h"
+#include "../Common/mem_track.h"
+#include "../Common/tcp_stats.h"
+#include "../Common/io_ring.h"
+
+#define MAX_EVENTS 256
+#define ACCEPT_BATCH 32
+#define EPOLL_TIMEOUT_MS 100
+#define CONN_BUFFER_SIZE 4096
+
+// io_uring 백엔드
+#define URING_ENTRIES 1024
+#define URING_RECV_BUFS 256             // 수신 버퍼 링 (2의 거듭제곱)
+#define URING_RECV_BUF_SIZE 16384
+#define URING_SEND_SLOTS 256            // 등록 송신 슬롯 (모자라면 BIO pair 버퍼에서 바로 IORING_OP_SEND)
+#define URING_SEND_SLOT_SIZE 16384
+#define URING_BIO_BUF (17 * 1024)       // BIO pair 방향별 버퍼 (레코드 1개 + 여유, 더 큰 비행은 송신 완료 후 이어서)
+
+// io_uring user_data: 연결 포인터(8바이트 정렬) | 요청 종류, accept는 리스너 번호 << URING_OP_BITS
+#define URING_OP_BITS 3
+#define URING_OP_MASK ((1u << URING_OP_BITS) - 1)
+enum { URING_ACCEPT, URING_RECV, URING_SEND, URING_ASYNC, URING_SHUTDOWN, URING_CLOSE };
+
+// 연결 상태 (SSL_accept 상태 머신)
+typedef enum {
+    CONN_EARLY_DATA,
+    CONN_HANDSHAKE,
+    CONN_READ,
+    CONN_WRITE,
+    CONN_CLOSED
+} conn_state_t;
+
+typedef struct conn {
+    int fd;
+    SSL *ssl;
+    conn_state_t state;
+    uint32_t events;            // 현재 epoll 관심 이벤트
+    bool early_request;         // 요청을 0-RTT early data로 받음
+    bench_timer_t timer;
+    handshake_metrics_t metrics;
+    hs_trace_t trace;
+    wire_count_t wire;
+    perf_values_t perf;         // 이 연결의 SSL 호출 구간만 누적
+    mem_account_t heap;         // 이 연결을 구동하는 동안의 OpenSSL 할당
+    tcp_sample_t tcp_start;     // 수락 직후 TCP_INFO
+    bool pooled;                // 워커 슬롯 (닫으면 SSL 객체를 보관한 채 링으로 반환)
+    // io_uring 경로: SSL은 BIO pair에 쓰고, 워커가 네트워크 쪽(net)과 소켓 사이를 링으로 옮김
+    BIO *net;
+    int slot;                   // 등록 송신 슬롯 (-1: BIO pair 버퍼에서 바로 전송)
+    uint32_t send_len;          // 진행 중인 송신 (0: 없음)
+    uint32_t send_off;
+    int inflight;               // 완료를 기다리는 요청 수 (0이 되어야 해제)
+    bool recv_armed;            // 멀티샷 recv 진행 중
+    bool eof;                   // 피어 송신 종료 또는 수신 오류
+    bool send_failed;
+    bool shut;                  // recv를 끝내려고 shutdown 제출함
+    bool closing;               // 상태 머신 종료, 송신이 끝나면 닫음
+    bool send_queued;           // 등록 슬롯의 남은 송신이 제출 엔트리를 기다림
+    bool need_recv;             // 멀티샷 recv 제출이 제출 엔트리를 기다림
+    bool stalled;               // 워커의 재시도 목록에 있음 (제출 큐가 가득 차 요청을 못 넣음)
+    struct conn *stall_next;
+    struct conn *prev;
+    struct conn *next;
+} conn_t;
+
+typedef struct {
+    struct server_engine *engine;
+    pthread_t thread;
+    int id;
+    int epfd;
+    int listen_fd;              // 이 워커가 수락하는 리스너 (공유 또는 SO_REUSEPORT 전용)
+    conn_t *conns;              // 활성 연결 목록 (정지 시 정리용)
+    struct epoll_event *batch;  // 처리 중인 epoll_wait 결과 (소켓과 비동기 fd가 같은 연결을 가리킬 수 있음)
+    int batch_len;
+    conn_t *slots;              // 미리 할당한 연결 슬롯 (ssl_pool개)
+    conn_t **ring;              // 빈 슬롯 링 (먼저 반환된 슬롯부터 재사용)
+    int ring_head;
+    int ring_count;
+    io_ring_t *uring;           // io_uring 백엔드 (NULL: epoll)
+    char *send_region;          // 등록 송신 영역 (URING_SEND_SLOTS × URING_SEND_SLOT_SIZE)
+    int free_slots[URING_SEND_SLOTS];
+    int free_slot_count;
+    conn_t *stalled;            // 제출 엔트리를 못 받은 연결 (다음 io_uring_enter 후 재시도)
+    bool *accept_pending;       // 리스너별 멀티샷 accept 재제출 대기 (1 + extra_listen_count개)
+    engine_stats_t stats;
+} worker_t;
+
+struct server_engine {
+    engine_config_t config;
+    worker_t *workers;
+    atomic_int stop;
+    bench_timer_t uptime;
+};
+
+// 소켓 논블로킹 설정
+static int set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0) {
+        return -1;
+    }
+    return fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+// 비동기 작업 대기 fd (SSL_MODE_ASYNC, 최대 개수)
+#define CONN_ASYNC_FDS 4
+
+// 배치 안에서 이미 닫은 연결 표시
+static char conn_gone;
+
+static SSL* ssl_create(const engine_config_t *config) {
+    SSL *ssl = SSL_new(config->ctx);
+    if (ssl && config->release_buffers) {
+        SSL_set_mode(ssl, SSL_MODE_RELEASE_BUFFERS);
+    }
+    return ssl;
+}
+
+bool ssl_recycle(SSL *ssl, SSL_CTX *ctx) {
+    // 멈춘 비동기 작업은 객체와 함께 버림
+    if (SSL_waiting_for_async(ssl)) {
+        return false;
+    }
+    if (SSL_get_SSL_CTX(ssl) != ctx && SSL_set_SSL_CTX(ssl, ctx) != ctx) {
+        return false;
+    }
+    return SSL_clear(ssl) == 1;
+}
+
+// 워커 스레드에서 슬롯과 SSL 객체를 미리 할당 (실패하면 슬롯 없이 힙 경로)
+static void pool_init(worker_t *w) {
+    const engine_config_t *config = &w->engine->config;
+    if (config->ssl_pool <= 0) {
+        return;
+    }
+    w->slots = calloc(config->ssl_pool, sizeof(conn_t));
+    w->ring = calloc(config->ssl_pool, sizeof(conn_t*));
+    if (!w->slots || !w->ring) {
+        fprintf(stderr, "[worker %d] SSL pool allocation failed, using per-connection SSL_new\n", w->id);
+        free(w->slots);
+        free(w->ring);
+        w->slots = NULL;
+        w->ring = NULL;
+        return;
+    }
+    for (int i = 0; i < config->ssl_pool; i++) {
+        // SSL_new 실패한 슬롯은 수락 시 다시 만듦
+        w->slots[i].ssl = ssl_create(config);
+        w->slots[i].pooled = true;
+        w->ring[i] = &w->slots[i];
+    }
+    w->ring_count = config->ssl_pool;
+}
+
+static void pool_free(worker_t *w) {
+    for (int i = 0; w->slots && i < w->engine->config.ssl_pool; i++) {
+        SSL_free(w->slots[i].ssl);
+    }
+    free(w->slots);
+    free(w->ring);
+}
+
+// 연결 상태 할당: 빈 슬롯(보관한 SSL 포함) 우선, 없으면 힙
+static conn_t* conn_alloc(worker_t *w) {
+    if (w->ring_count == 0) {
+        w->stats.conn_allocs++;
+        return calloc(1, sizeof(conn_t));
+    }
+    conn_t *c = w->ring[w->ring_head];
+    w->ring_head = (w->ring_head + 1) % w->engine->config.ssl_pool;
+    w->ring_count--;
+    SSL *ssl = c->ssl;
+    memset(c, 0, sizeof(conn_t));
+    c->ssl = ssl;
+    c->pooled = true;
+    return c;
+}
+
+// 연결 상태 반환: 슬롯은 SSL을 초기화해 보관하고 링 끝에 넣음
+static void conn_release(worker_t *w, conn_t *c) {
+    if (!c->pooled) {
+        SSL_free(c->ssl);
+        free(c);
+        return;
+    }
+    if (c->ssl && !ssl_recycle(c->ssl, w->engine->config.ctx)) {
+        SSL_free(c->ssl);
+        c->ssl = NULL;
+        w->stats.ssl_dropped++;
+    }
+    int size = w->engine->config.ssl_pool;
+    w->ring[(w->ring_head + w->ring_count) % size] = c;
+    w->ring_count++;
+}
+
+static void conn_close(worker_t *w, conn_t *c) {
+    if (w->uring) {
+        // 남은 송신과 진행 중인 요청이 끝난 뒤 uring_finish가 해제
+        c->closing = true;
+        return;
+    }
+    epoll_ctl(w->epfd, EPOLL_CTL_DEL, c->fd, NULL);
+    // 연결별 시스템 콜: epoll_ctl DEL, close, 소켓 BIO의 read/write (ADD는 수락 시)
+    w->stats.syscalls += 2 + c->wire.read_calls + c->wire.write_calls;
+    w->stats.io_ops += 1 + c->wire.read_calls + c->wire.write_calls;
+
+    // 멈춘 비동기 작업의 대기 fd가 남아 있으면 해제된 연결을 가리키지 않도록 제거
+    OSSL_ASYNC_FD fds[CONN_ASYNC_FDS];
+    size_t nfds = 0;
+    if (SSL_get_all_async_fds(c->ssl, NULL, &nfds) && nfds > 0 && nfds <= CONN_ASYNC_FDS &&
+        SSL_get_all_async_fds(c->ssl, fds, &nfds)) {
+        for (size_t i = 0; i < nfds; i++) {
+            epoll_ctl(w->epfd, EPOLL_CTL_DEL, fds[i], NULL);
+            w->stats.syscalls++;
+        }
+    }
+
+    if (c->prev) c->prev->next = c->next;
+    else w->conns = c->next;
+    if (c->next) c->next->prev = c->prev;
+
+    // 같은 배치에 남은 이 연결의 이벤트는 건너뜀
+    for (int i = 0; i < w->batch_len; i++) {
+        if (w->batch[i].data.ptr == c) {
+            w->batch[i].data.ptr = &conn_gone;
+        }
+    }
+
+    pcap_flow_free(c->wire.capture);
+    close(c->fd);
+    conn_release(w, c);
+}
+
+// epoll 관심 이벤트 갱신 (변경된 경우만)
+static void conn_want(worker_t *w, conn_t *c, uint32_t events) {
+    if (c->events == events) {
+        return;
+    }
+    struct epoll_event ev = { .events = events, .data.ptr = c };
+    epoll_ctl(w->epfd, EPOLL_CTL_MOD, c->fd, &ev);
+    w->stats.syscalls++;
+    c->events = events;
+}
+
+// SSL_ERROR_WANT_* 를 epoll 이벤트로 변환 (0이면 치명적 오류)
+static uint32_t want_events(SSL *ssl, int ret) {
+    switch (SSL_get_error(ssl, ret)) {
+    case SSL_ERROR_WANT_READ:
+        return EPOLLIN;
+    case SSL_ERROR_WANT_WRITE:
+        return EPOLLOUT;
+    default:
+        return 0;
+    }
+}
+
+// 비동기 작업(서명 오프로드 등)이 멈춘 연결: 대기 fd를 같은 연결로 등록, 완료되면 다시 구동
+// 작업이 끝나면 fd가 닫혀 epoll에서 자동으로 빠짐
+static bool conn_watch_async(worker_t *w, conn_t *c) {
+    OSSL_ASYNC_FD fds[CONN_ASYNC_FDS];
+    size_t nfds = 0;
+    if (!SSL_get_all_async_fds(c->ssl, NULL, &nfds) || nfds > CONN_ASYNC_FDS ||
+        !SSL_get_all_async_fds(c->ssl, fds, &nfds)) {
+        return false;
+    }
+    for (size_t i = 0; i < nfds; i++) {
+        struct epoll_event ev = { .events = EPOLLIN, .data.ptr = c };
+        w->stats.syscalls++;
+        if (epoll_ctl(w->epfd, EPOLL_CTL_ADD, fds[i], &ev) < 0 && errno != EEXIST) {
+            perror("epoll_ctl(async)");
+            return false;
+        }
+    }
+    return true;
+}
+
+// io_uring: 비동기 작업 대기 fd마다 1회성 POLL_ADD
+static bool uring_watch_async(worker_t *w, conn_t *c) {
+    OSSL_ASYNC_FD fds[CONN_ASYNC_FDS];
+    size_t nfds = 0;
+    if (!SSL_get_all_async_fds(c->ssl, NULL, &nfds) || nfds > CONN_ASYNC_FDS ||
+        !SSL_get_all_async_fds(c->ssl, fds, &nfds)) {
+        return false;
+    }
+    for (size_t i = 0; i < nfds; i++) {
+        struct io_uring_sqe *sqe = io_ring_sqe(w->uring);
+        if (!sqe) {
+            return false;
+        }
+        sqe->opcode = IORING_OP_POLL_ADD;
+        sqe->fd = fds[i];
+        sqe->poll32_events = POLLIN;
+        sqe->user_data = (uint64_t)(uintptr_t)c | URING_ASYNC;
+        c->inflight++;
+    }
+    return true;
+}
+
+// SSL 호출이 멈춘 이유에 맞춰 대기 등록 (false: 치명적 오류)
+static bool conn_wait(worker_t *w, conn_t *c, int ret) {
+    if (SSL_get_error(c->ssl, ret) == SSL_ERROR_WANT_ASYNC) {
+        return w->uring ? uring_watch_async(w, c) : conn_watch_async(w, c);
+    }
+    if (w->uring) {
+        // BIO pair: 읽기는 다음 recv 완료, 쓰기는 송신 완료가 다시 구동
+        return want_events(c->ssl, ret) != 0;
+    }
+    uint32_t want = want_events(c->ssl, ret);
+    if (want == 0) {
+        return false;
+    }
+    conn_want(w, c, want);
+    return true;
+}
+
+static void handshake_done(worker_t *w, conn_t *c, bool success) {
+    c->metrics.success = success;
+    if (success) {
+        c->metrics.t_handshake_total_ms = end_timer(&c->timer);
+        hs_trace_fill_metrics(&c->trace, true, &c->metrics);
+        count_bio_fill_traffic(&c->wire, &c->metrics.traffic);
+        tcp_sample_t tcp_end;
+        tcp_sample(c->fd, &tcp_end);
+        w->stats.syscalls++;
+        tcp_fill_traffic(&c->tcp_start, &tcp_end, true, &c->metrics.traffic);
+        w->stats.handshakes_ok++;
+        w->stats.handshake_ms_sum += c->metrics.t_handshake_total_ms;
+        c->metrics.reliability.session_resumption_ok = SSL_session_reused(c->ssl);
+        c->metrics.reliability.zero_rtt_ok = c->early_request;
+        w->stats.resumed += c->metrics.reliability.session_resumption_ok;
+        perf_fill_resources(&c->perf, &c->metrics.resources);
+        mem_fill_resources(&c->heap, &c->metrics.resources);
+        if (!c->metrics.reliability.session_resumption_ok) {
+            w->stats.heap_peak_sum += c->metrics.resources.peak_heap_bytes;
+            w->stats.heap_retained_sum += c->metrics.resources.heap_retained_bytes;
+            w->stats.heap_allocs_sum += c->metrics.resources.heap_allocs;
+            w->stats.cpu_cycles_sum += c->perf.counters[PERF_CYCLES];
+            w->stats.instructions_sum += c->perf.counters[PERF_INSTRUCTIONS];
+            w->stats.cpu_ns_sum += c->perf.cpu_ns;
+            w->stats.segs_out_sum += c->metrics.traffic.segs_out;
+            w->stats.retransmits_sum += c->metrics.traffic.retransmits;
+            w->stats.flight_rounds_sum += c->metrics.traffic.server_flight_rounds;
+        }
+        w->stats.early_data += c->early_request;
+        w->stats.hello_retries += c->metrics.crypto.hello_retry;
+    } else {
+        w->stats.handshakes_failed++;
+        snprintf(c->metrics.error_msg, sizeof(c->metrics.error_msg), "SSL_accept failed");
+    }
+
+    if (w->engine->config.verbose) {
+        if (success) {
+            printf("[worker %d] ✅ Handshake successful (%.2f ms)%s%s\n",
+                   w->id, c->metrics.t_handshake_total_ms,
+                   c->metrics.reliability.session_resumption_ok ? " [resumed]" : "",
+                   c->early_request ? " [0-RTT]" : "");
+        } else {
+            printf("[worker %d] ❌ Handshake failed: %s\n", w->id, c->metrics.error_msg);
+        }
+    }
+}
+
+// 연결 상태 머신 구동
+static void conn_run(worker_t *w, conn_t *c) {
+    char buf[CONN_BUFFER_SIZE];
+    int ret;
+    perf_values_t perf_start;
+
+    for (;;) {
+        switch (c->state) {
+        case CONN_EARLY_DATA: {
+            // 0-RTT 요청을 핸드셰이크 완료 전에 수신
+            size_t n = 0;
+            perf_begin(&perf_start);
+            ret = SSL_read_early_data(c->ssl, buf, sizeof(buf), &n);
+            perf_end(&perf_start, &c->perf);
+            if (n > 0) {
+                c->early_request = true;
+            }
+            if (ret == SSL_READ_EARLY_DATA_FINISH) {
+                c->state = CONN_HANDSHAKE;
+                continue;
+            }
+            if (ret == SSL_READ_EARLY_DATA_SUCCESS) {
+                continue;
+            }
+            if (!conn_wait(w, c, -1)) {
+                handshake_done(w, c, false);
+                ERR_clear_error();
+                c->state = CONN_CLOSED;
+                continue;
+            }
+            return;
+        }
+
+        case CONN_HANDSHAKE:
+            perf_begin(&perf_start);
+            ret = SSL_accept(c->ssl);
+            perf_end(&perf_start, &c->perf);
+            if (ret == 1) {
+                handshake_done(w, c, true);
+                c->state = c->early_request ? CONN_WRITE : CONN_READ;
+                continue;
+            }
+            if (!conn_wait(w, c, ret)) {
+                handshake_done(w, c, false);
+                ERR_clear_error();
+                c->state = CONN_CLOSED;
+                continue;
+            }
+            return;
+
+        case CONN_READ:
+            // 핸드셰이크 후 클라이언트 메시지 1건 수신
+            ret = SSL_read(c->ssl, buf, sizeof(buf));
+            if (ret > 0) {
+                c->state = CONN_WRITE;
+                continue;
+            }
+            if (!conn_wait(w, c, ret)) {
+                // 클라이언트가 데이터 없이 종료 (부하 생성기 등)
+                ERR_clear_error();
+                c->state = CONN_CLOSED;
+                continue;
+            }
+            return;
+
+        case CONN_WRITE:
+            ret = SSL_write(c->ssl, "OK", 2);
+            if (ret > 0) {
+                SSL_shutdown(c->ssl);
+                c->state = CONN_CLOSED;
+                continue;
+            }
+            if (!conn_wait(w, c, ret)) {
+                ERR_clear_error();
+                c->state = CONN_CLOSED;
+                continue;
+            }
+            return;
+
+        case CONN_CLOSED:
+            conn_close(w, c);
+            return;
+        }
+    }
+}
+
+// 구동 중 OpenSSL 할당을 연결 계정에 기록 (conn_run이 c를 해제해도 이후 할당 없음)
+static void conn_drive(worker_t *w, conn_t *c) {
+    mem_account_t *prev = mem_track_switch(&c->heap);
+    conn_run(w, c);
+    mem_track_switch(prev);
+}
+
+// 수락한 소켓의 연결 상태 준비 (io_uring이면 BIO pair, 아니면 소켓 BIO), 실패 시 fd를 닫고 NULL
+static conn_t* conn_open(worker_t *w, int fd) {
+    const engine_config_t *config = &w->engine->config;
+    conn_t *c = conn_alloc(w);
+    if (!c) {
+        fprintf(stderr, "Failed to allocate connection\n");
+        close(fd);
+        return NULL;
+    }
+    mem_track_switch(&c->heap);
+    if (c->ssl) {
+        w->stats.ssl_reused++;
+    } else {
+        c->ssl = ssl_create(config);
+        w->stats.ssl_new++;
+    }
+    SSL *ssl = c->ssl;
+    bool attached = ssl && (w->uring ? count_bio_attach_pair(ssl, URING_BIO_BUF, &c->wire, &c->net)
+                                     : count_bio_attach(ssl, fd, &c->wire));
+    mem_track_switch(NULL);
+    if (!attached) {
+        fprintf(stderr, "Failed to allocate connection\n");
+        conn_release(w, c);
+        close(fd);
+        return NULL;
+    }
+
+    if (config->nodelay) {
+        tcp_set_nodelay(fd, true);
+        w->stats.syscalls++;
+    }
+    tcp_sample(fd, &c->tcp_start);
+    w->stats.syscalls++;
+    c->wire.capture = pcap_flow_new(config->pcap, fd, true);
+    c->fd = fd;
+    c->state = SSL_get_max_early_data(ssl) > 0 ? CONN_EARLY_DATA : CONN_HANDSHAKE;
+    c->events = EPOLLIN;
+    c->slot = -1;
+    init_handshake_metrics(&c->metrics);
+    hs_trace_attach(ssl, &c->trace);
+    start_timer(&c->timer);
+    return c;
+}
+
+static void conn_link(worker_t *w, conn_t *c) {
+    c->next = w->conns;
+    if (w->conns) w->conns->prev = c;
+    w->conns = c;
+    w->stats.accepted++;
+}
+
+static void conn_unlink(worker_t *w, conn_t *c) {
+    if (c->prev) c->prev->next = c->next;
+    else w->conns = c->next;
+    if (c->next) c->next->prev = c->prev;
+}
+
+// 대기 중인 연결 수락 (공유 리스너, 배치 단위)
+static void accept_connections(worker_t *w, int listen_fd) {
+    for (int i = 0; i < ACCEPT_BATCH; i++) {
+        int fd = accept4(listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        w->stats.syscalls++;
+        w->stats.io_ops++;
+        if (fd < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                perror("accept4");
+            }
+            return;
+        }
+
+        conn_t *c = conn_open(w, fd);
+        if (!c) {
+            continue;
+        }
+
+        struct epoll_event ev = { .events = EPOLLIN, .data.ptr = c };
+        w->stats.syscalls++;
+        if (epoll_ctl(w->epfd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+            perror("epoll_ctl");
+            pcap_flow_free(c->wire.capture);
+            close(fd);
+            w->stats.syscalls++;
+            w->stats.io_ops++;
+            conn_release(w, c);
+            continue;
+        }
+
+        conn_link(w, c);
+
+        // ClientHello가 이미 도착했을 수 있으므로 즉시 구동
+        conn_drive(w, c);
+    }
+}
+
+// ---- io_uring 백엔드 ----
+
+static int uring_listener(worker_t *w, int index) {
+    return index == 0 ? w->listen_fd : w->engine->config.extra_listen_fds[index - 1];
+}
+
+// 제출 큐가 가득 차(CQ overflow 중 -EBUSY 등) 요청을 넣지 못한 연결: 버리지 않고 다음 enter 후 재시도
+static void uring_stall(worker_t *w, conn_t *c) {
+    if (c->stalled) {
+        return;
+    }
+    c->stalled = true;
+    c->stall_next = w->stalled;
+    w->stalled = c;
+}
+
+// 멀티샷 accept: 한 번 제출로 연결마다 완료, IORING_CQE_F_MORE가 빠지면 다시 제출
+static void uring_arm_accept(worker_t *w, int index) {
+    struct io_uring_sqe *sqe = io_ring_sqe(w->uring);
+    if (!sqe) {
+        w->accept_pending[index] = true;
+        return;
+    }
+    w->accept_pending[index] = false;
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = uring_listener(w, index);
+    sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+    sqe->accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+    sqe->user_data = ((uint64_t)index << URING_OP_BITS) | URING_ACCEPT;
+}
+
+// 멀티샷 recv: 커널이 버퍼 링(그룹 0)에서 버퍼를 골라 채움
+static void uring_arm_recv(worker_t *w, conn_t *c) {
+    struct io_uring_sqe *sqe = io_ring_sqe(w->uring);
+    if (!sqe) {
+        c->need_recv = true;
+        uring_stall(w, c);
+        return;
+    }
+    c->need_recv = false;
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = c->fd;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = 0;
+    sqe->user_data = (uint64_t)(uintptr_t)c | URING_RECV;
+    c->recv_armed = true;
+    c->inflight++;
+}
+
+// 등록 슬롯의 send_off..send_len을 WRITE_FIXED (페이지 고정/해제 없이 전송)
+static void uring_send_slot(worker_t *w, conn_t *c) {
+    struct io_uring_sqe *sqe = io_ring_sqe(w->uring);
+    if (!sqe) {
+        c->send_queued = true;
+        uring_stall(w, c);
+        return;
+    }
+    c->send_queued = false;
+    sqe->opcode = IORING_OP_WRITE_FIXED;
+    sqe->fd = c->fd;
+    sqe->addr = (uint64_t)(uintptr_t)(w->send_region + (size_t)c->slot * URING_SEND_SLOT_SIZE + c->send_off);
+    sqe->len = c->send_len - c->send_off;
+    sqe->buf_index = 0;
+    sqe->user_data = (uint64_t)(uintptr_t)c | URING_SEND;
+    c->inflight++;
+}
+
+// BIO pair에 쌓인 송신 데이터를 소켓으로 (연결당 송신 1개씩 진행)
+static void uring_flush(worker_t *w, conn_t *c) {
+    if (c->send_failed) {
+        return;
+    }
+    if (c->send_len > 0) {
+        if (c->send_queued) {
+            uring_send_slot(w, c);
+        }
+        return;
+    }
+    char *data;
+    int n = BIO_nread0(c->net, &data);
+    if (n <= 0) {
+        return;
+    }
+    if (c->slot >= 0) {
+        // 등록 버퍼로 복사한 만큼 BIO pair에서 소비
+        if (n > URING_SEND_SLOT_SIZE) {
+            n = URING_SEND_SLOT_SIZE;
+        }
+        memcpy(w->send_region + (size_t)c->slot * URING_SEND_SLOT_SIZE, data, n);
+        BIO_nread(c->net, &data, n);
+        c->send_len = n;
+        c->send_off = 0;
+        uring_send_slot(w, c);
+        return;
+    }
+    // BIO pair 버퍼에서 바로 전송, 완료된 만큼만 소비
+    struct io_uring_sqe *sqe = io_ring_sqe(w->uring);
+    if (!sqe) {
+        uring_stall(w, c);
+        return;
+    }
+    sqe->opcode = IORING_OP_SEND;
+    sqe->fd = c->fd;
+    sqe->addr = (uint64_t)(uintptr_t)data;
+    sqe->len = n;
+    sqe->msg_flags = MSG_NOSIGNAL;
+    sqe->user_data = (uint64_t)(uintptr_t)c | URING_SEND;
+    c->send_len = n;
+    c->send_off = 0;
+    c->inflight++;
+}
+
+// 상태 머신 구동 후 만들어진 레코드 송신 (c를 해제하지 않음)
+static void uring_run(worker_t *w, conn_t *c) {
+    if (!c->closing) {
+        mem_account_t *prev = mem_track_switch(&c->heap);
+        conn_run(w, c);
+        mem_track_switch(prev);
+    }
+    uring_flush(w, c);
+}
+
+// 닫는 중인 연결: 송신이 끝나면 recv를 멈추고, 진행 중인 요청이 없으면 해제
+// 재시도 목록에 있는 동안(남은 송신/shutdown 미제출)은 해제하지 않음
+static void uring_finish(worker_t *w, conn_t *c) {
+    if (!c->closing || c->send_len > 0 || c->stalled) {
+        return;
+    }
+    if (c->recv_armed && !c->shut) {
+        struct io_uring_sqe *sqe = io_ring_sqe(w->uring);
+        if (!sqe) {
+            uring_stall(w, c);
+            return;
+        }
+        sqe->opcode = IORING_OP_SHUTDOWN;
+        sqe->fd = c->fd;
+        sqe->len = SHUT_RDWR;
+        sqe->user_data = URING_SHUTDOWN;
+        c->shut = true;
+    }
+    if (c->inflight > 0) {
+        return;
+    }
+
+    struct io_uring_sqe *sqe = io_ring_sqe(w->uring);
+    if (sqe) {
+        sqe->opcode = IORING_OP_CLOSE;
+        sqe->fd = c->fd;
+        sqe->user_data = URING_CLOSE;
+    } else {
+        close(c->fd);
+        w->stats.syscalls++;
+        w->stats.io_ops++;
+    }
+    conn_unlink(w, c);
+    pcap_flow_free(c->wire.capture);
+    BIO_free(c->net);
+    if (c->slot >= 0) {
+        w->free_slots[w->free_slot_count++] = c->slot;
+    }
+    conn_release(w, c);
+}
+
+// 완료 처리 끝에 한 번: 구동, 송신, 정리 (이후 c 접근 금지)
+static void uring_step(worker_t *w, conn_t *c) {
+    uring_run(w, c);
+    uring_finish(w, c);
+}
+
+// io_uring_enter로 제출 큐가 비워진 뒤: 못 넣은 accept 재제출과 멈춘 연결의 recv/송신/정리 재시도
+static void uring_retry(worker_t *w) {
+    for (int index = 0; index <= w->engine->config.extra_listen_count; index++) {
+        if (w->accept_pending[index]) {
+            uring_arm_accept(w, index);
+        }
+    }
+    conn_t *c = w->stalled;
+    w->stalled = NULL;
+    while (c) {
+        conn_t *next = c->stall_next;
+        c->stalled = false;
+        if (c->need_recv && !c->eof && !c->closing) {
+            uring_arm_recv(w, c);
+        }
+        uring_step(w, c);
+        c = next;
+    }
+}
+
+static void uring_accept(worker_t *w, int fd) {
+    conn_t *c = conn_open(w, fd);
+    if (!c) {
+        return;
+    }
+    if (w->free_slot_count > 0) {
+        c->slot = w->free_slots[--w->free_slot_count];
+    }
+    conn_link(w, c);
+    uring_arm_recv(w, c);
+    // ClientHello는 첫 recv 완료로 도착
+}
+
+// 소켓 쪽이 먼저 실패: 핸드셰이크 중이었으면 실패로 집계하고 닫기로 전환
+static void uring_abort(worker_t *w, conn_t *c) {
+    if (c->closing) {
+        return;
+    }
+    if (c->state == CONN_EARLY_DATA || c->state == CONN_HANDSHAKE) {
+        handshake_done(w, c, false);
+    }
+    c->state = CONN_CLOSED;
+}
+
+// 받은 바이트를 BIO pair에 넣음 (SSL 쪽이 가득 차면 구동해 소비시킨 뒤 계속)
+static void uring_feed(worker_t *w, conn_t *c, const char *data, int len) {
+    while (len > 0 && !c->closing) {
+        int n = BIO_write(c->net, data, len);
+        if (n > 0) {
+            data += n;
+            len -= n;
+            continue;
+        }
+        uring_run(w, c);
+        if (BIO_ctrl_get_write_guarantee(c->net) == 0) {
+            uring_abort(w, c);
+            uring_run(w, c);
+            return;
+        }
+    }
+}
+
+static void uring_complete(worker_t *w, uint64_t data, int res, uint32_t flags) {
+    unsigned op = data & URING_OP_MASK;
+    conn_t *c = (conn_t*)(uintptr_t)(data & ~(uint64_t)URING_OP_MASK);
+
+    switch (op) {
+    case URING_ACCEPT:
+        if (!(flags & IORING_CQE_F_MORE) && !atomic_load(&w->engine->stop)) {
+            uring_arm_accept(w, (int)(data >> URING_OP_BITS));
+        }
+        if (res >= 0) {
+            uring_accept(w, res);
+        } else if (res != -EAGAIN && res != -EINTR && res != -ECANCELED) {
+            fprintf(stderr, "[worker %d] io_uring accept: %s\n", w->id, strerror(-res));
+        }
+        return;
+
+    case URING_RECV:
+        if (!(flags & IORING_CQE_F_MORE)) {
+            c->recv_armed = false;
+            c->inflight--;
+        }
+        if (res > 0) {
+            unsigned bid = flags >> IORING_CQE_BUFFER_SHIFT;
+            uring_feed(w, c, io_ring_buf(w->uring, bid), res);
+            io_ring_buf_recycle(w->uring, bid);
+        } else if (res != -ENOBUFS) {
+            // 피어 종료(0) 또는 오류: SSL 쪽에 EOF 전달
+            c->eof = true;
+            BIO_shutdown_wr(c->net);
+        }
+        // 버퍼 링이 비었거나(-ENOBUFS) 커널이 멀티샷을 끝낸 경우 다시 제출
+        if (!c->recv_armed && !c->eof && !c->closing) {
+            uring_arm_recv(w, c);
+        }
+        uring_step(w, c);
+        return;
+
+    case URING_SEND:
+        c->inflight--;
+        if (res <= 0) {
+            c->send_failed = true;
+            c->send_len = 0;
+            uring_abort(w, c);
+        } else if (c->slot >= 0) {
+            // 부분 전송이면 등록 슬롯의 나머지를 이어서 전송
+            c->send_off += res;
+            if (c->send_off < c->send_len) {
+                uring_send_slot(w, c);
+                return;
+            }
+            c->send_len = 0;
+        } else {
+            char *sent;
+            BIO_nread(c->net, &sent, res);
+            c->send_len = 0;
+        }
+        uring_step(w, c);
+        return;
+
+    case URING_ASYNC:
+        c->inflight--;
+        uring_step(w, c);
+        return;
+
+    default:
+        // shutdown/close 완료는 기다리지 않음
+        return;
+    }
+}
+
+// io_uring 초기화 (실패하면 epoll 경로로 동작)
+static bool uring_init(worker_t *w) {
+    w->accept_pending = calloc(1 + w->engine->config.extra_listen_count, sizeof(bool));
+    w->uring = w->accept_pending ? io_ring_new(URING_ENTRIES) : NULL;
+    if (!w->uring || !io_ring_setup_bufs(w->uring, URING_RECV_BUFS, URING_RECV_BUF_SIZE)) {
+        io_ring_free(w->uring);
+        w->uring = NULL;
+        free(w->accept_pending);
+        w->accept_pending = NULL;
+        return false;
+    }
+    // 등록 송신 영역이 없으면 모든 연결이 BIO pair 버퍼에서 IORING_OP_SEND
+    w->send_region = io_ring_register_region(w->uring, (size_t)URING_SEND_SLOTS * URING_SEND_SLOT_SIZE);
+    for (int i = 0; w->send_region && i < URING_SEND_SLOTS; i++) {
+        w->free_slots[w->free_slot_count++] = URING_SEND_SLOTS - 1 - i;
+    }
+    return true;
+}
+
+static void uring_loop(worker_t *w) {
+    const engine_config_t *config = &w->engine->config;
+    for (int index = 0; index <= config->extra_listen_count; index++) {
+        uring_arm_accept(w, index);
+    }
+
+    while (!atomic_load(&w->engine->stop)) {
+        int ret = io_ring_enter(w->uring, 1, EPOLL_TIMEOUT_MS);
+        if (ret < 0) {
+            fprintf(stderr, "[worker %d] io_uring_enter: %s\n", w->id, strerror(-ret));
+            break;
+        }
+        struct io_uring_cqe *cqe;
+        while ((cqe = io_ring_cqe(w->uring)) != NULL) {
+            uint64_t data = cqe->user_data;
+            int res = cqe->res;
+            uint32_t flags = cqe->flags;
+            io_ring_cqe_seen(w->uring);
+            // 비동기 작업 대기(POLL_ADD)는 epoll 경로의 epoll_ctl처럼 소켓 요청이 아님
+            if ((data & URING_OP_MASK) != URING_ASYNC) {
+                w->stats.io_ops++;
+            }
+            uring_complete(w, data, res, flags);
+        }
+        uring_retry(w);
+    }
+
+    // 링을 먼저 닫아 남은 요청을 취소한 뒤 연결 해제
+    w->stats.ring_enters = io_ring_enters(w->uring);
+    w->stats.syscalls += w->stats.ring_enters;
+    io_ring_free(w->uring);
+    while (w->conns) {
+        conn_t *c = w->conns;
+        conn_unlink(w, c);
+        pcap_flow_free(c->wire.capture);
+        close(c->fd);
+        w->stats.syscalls++;
+        w->stats.io_ops++;
+        BIO_free(c->net);
+        conn_release(w, c);
+    }
+    free(w->accept_pending);
+}
+
+static void* worker_main(void *arg) {
+    worker_t *w = arg;
+    struct epoll_event events[MAX_EVENTS];
+
+    pool_init(w);
+
+    if (w->engine->config.io_uring) {
+        if (uring_init(w)) {
+            uring_loop(w);
+            pool_free(w);
+            return NULL;
+        }
+        fprintf(stderr, "[worker %d] io_uring unavailable, using epoll\n", w->id);
+    }
+
+    while (!atomic_load(&w->engine->stop)) {
+        int n = epoll_wait(w->epfd, events, MAX_EVENTS, EPOLL_TIMEOUT_MS);
+        w->stats.syscalls++;
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            perror("epoll_wait");
+            break;
+        }
+
+        w->batch = events;
+        w->batch_len = n;
+        for (int i = 0; i < n; i++) {
+            conn_t *c = events[i].data.ptr;
+            if ((void*)c == &conn_gone) {
+                continue;
+            }
+            if (c == NULL) {
+                // 리스너 이벤트는 구분하지 않으므로 모든 리스너에서 수락 (없으면 EAGAIN)
+                const engine_config_t *config = &w->engine->config;
+                accept_connections(w, w->listen_fd);
+                for (int l = 0; l < config->extra_listen_count; l++) {
+                    accept_connections(w, config->extra_listen_fds[l]);
+                }
+            } else {
+                conn_drive(w, c);
+            }
+        }
+        w->batch_len = 0;
+    }
+
+    while (w->conns) {
+        conn_close(w, w->conns);
+    }
+    pool_free(w);
+    return NULL;
+}
+
+// 이 프로세스가 쓸 수 있는 CPU 번호를 오름차순으로 (sched_getaffinity, 실패 시 0개)
+static int allowed_cpus(int cpus[CPU_SETSIZE]) {
+    cpu_set_t set;
+    if (sched_getaffinity(0, sizeof(set), &set) < 0) {
+        perror("sched_getaffinity");
+        return 0;
+    }
+    int n = 0;
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, &set)) {
+            cpus[n++] = cpu;
+        }
+    }
+    return n;
+}
+
+server_engine_t* engine_start(const engine_config_t *config) {
+    if (config->num_workers <= 0) {
+        fprintf(stderr, "Invalid worker count: %d\n", config->num_workers);
+        return NULL;
+    }
+    if (set_nonblocking(config->listen_fd) < 0) {
+        perror("fcntl");
+        return NULL;
+    }
+    for (int i = 0; config->worker_listen_fds && i < config->num_workers; i++) {
+        if (set_nonblocking(config->worker_listen_fds[i]) < 0) {
+            perror("fcntl");
+            return NULL;
+        }
+    }
+    for (int l = 0; l < config->extra_listen_count; l++) {
+        if (set_nonblocking(config->extra_listen_fds[l]) < 0) {
+            perror("fcntl");
+            return NULL;
+        }
+    }
+
+    server_engine_t *engine = calloc(1, sizeof(server_engine_t));
+    if (!engine) {
+        return NULL;
+    }
+    engine->config = *config;
+    atomic_init(&engine->stop, 0);
+    engine->workers = calloc(config->num_workers, sizeof(worker_t));
+    if (!engine->workers) {
+        free(engine);
+        return NULL;
+    }
+
+    start_timer(&engine->uptime);
+
+    // cpuset/taskset이 허용한 CPU 중 i번째 (CBPF 조향과 같은 순서)
+    int cpus[CPU_SETSIZE];
+    int ncpu = config->pin_cpus ? allowed_cpus(cpus) : 0;
+    int started = 0;
+    for (int i = 0; i < config->num_workers; i++) {
+        worker_t *w = &engine->workers[i];
+        w->engine = engine;
+        w->id = i;
+        w->epfd = epoll_create1(EPOLL_CLOEXEC);
+        if (w->epfd < 0) {
+            perror("epoll_create1");
+            break;
+        }
+
+        // 공유 리스너는 EPOLLEXCLUSIVE로 thundering herd 방지, SO_REUSEPORT 리스너는 커널이 워커별로 분배
+        struct epoll_event ev = { .events = EPOLLIN | EPOLLEXCLUSIVE, .data.ptr = NULL };
+        w->listen_fd = config->worker_listen_fds ? config->worker_listen_fds[i] : config->listen_fd;
+        struct epoll_event own = { .events = EPOLLIN, .data.ptr = NULL };
+        bool listening = epoll_ctl(w->epfd, EPOLL_CTL_ADD, w->listen_fd,
+                                   config->worker_listen_fds ? &own : &ev) == 0;
+        for (int l = 0; listening && l < config->extra_listen_count; l++) {
+            listening = epoll_ctl(w->epfd, EPOLL_CTL_ADD, config->extra_listen_fds[l], &ev) == 0;
+        }
+        if (!listening) {
+            perror("epoll_ctl(listen)");
+            close(w->epfd);
+            break;
+        }
+
+        // 생성 전에 고정해야 풀/링 메모리가 처음부터 그 CPU(NUMA 노드)에서 할당됨
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        if (ncpu > 0) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpus[i % ncpu], &set);
+            int rc = pthread_attr_setaffinity_np(&attr, sizeof(set), &set);
+            if (rc != 0) {
+                fprintf(stderr, "[worker %d] CPU pinning failed: %s\n", i, strerror(rc));
+            }
+        }
+        int rc = pthread_create(&w->thread, &attr, worker_main, w);
+        pthread_attr_destroy(&attr);
+        if (rc != 0) {
+            fprintf(stderr, "pthread_create: %s\n", strerror(rc));
+            close(w->epfd);
+            break;
+        }
+        started++;
+    }
+
+    if (started < config->num_workers) {
+        engine->config.num_workers = started;
+        engine_stop(engine, NULL);
+        return NULL;
+    }
+
+    return engine;
+}
+
+void engine_stop(server_engine_t *engine, engine_stats_t *stats) {
+    if (!engine) {
+        return;
+    }
+
+    atomic_store(&engine->stop, 1);
+
+    engine_stats_t total;
+    memset(&total, 0, sizeof(total));
+    total.accepted_min = UINT64_MAX;
+
+    for (int i = 0; i < engine->config.num_workers; i++) {
+        worker_t *w = &engine->workers[i];
+        pthread_join(w->thread, NULL);
+        close(w->epfd);
+
+        total.accepted += w->stats.accepted;
+        if (w->stats.accepted < total.accepted_min) total.accepted_min = w->stats.accepted;
+        if (w->stats.accepted > total.accepted_max) total.accepted_max = w->stats.accepted;
+        total.handshakes_ok += w->stats.handshakes_ok;
+        total.handshakes_failed += w->stats.handshakes_failed;
+        total.resumed += w->stats.resumed;
+        total.early_data += w->stats.early_data;
+        total.hello_retries += w->stats.hello_retries;
+        total.handshake_ms_sum += w->stats.handshake_ms_sum;
+        total.cpu_cycles_sum += w->stats.cpu_cycles_sum;
+        total.instructions_sum += w->stats.instructions_sum;
+        total.cpu_ns_sum += w->stats.cpu_ns_sum;
+        total.heap_peak_sum += w->stats.heap_peak_sum;
+        total.heap_retained_sum += w->stats.heap_retained_sum;
+        total.heap_allocs_sum += w->stats.heap_allocs_sum;
+        total.ssl_new += w->stats.ssl_new;
+        total.ssl_reused += w->stats.ssl_reused;
+        total.ssl_dropped += w->stats.ssl_dropped;
+        total.conn_allocs += w->stats.conn_allocs;
+        total.syscalls += w->stats.syscalls;
+        total.io_ops += w->stats.io_ops;
+        total.ring_enters += w->stats.ring_enters;
+        total.segs_out_sum += w->stats.segs_out_sum;
+        total.retransmits_sum += w->stats.retransmits_sum;
+        total.flight_rounds_sum += w->stats.flight_rounds_sum;
+    }
+    if (engine->config.num_workers == 0) {
+        total.accepted_min = 0;
+    }
+    total.elapsed_s = end_timer(&engine->uptime) / 1000.0;
+
+    mem_global_t heap;
+    mem_track_global(&heap);
+    total.process_heap_peak = heap.peak;
+
+    if (stats) {
+        *stats = total;
+    }
+
+    free(engine->workers);
+    free(engine);
+}
+
+void print_engine_stats(const engine_stats_t *stats) {
+    printf("\n========================================\n");
+    printf("Server engine summary\n");
+    printf("========================================\n");
+    printf("  Accepted:        %lu (per worker min %lu, max %lu)\n", stats->accepted,
+           stats->accepted_min, stats->accepted_max);
+    printf("  Handshakes OK:   %lu\n", stats->handshakes_ok);
+    printf("  Handshakes fail: %lu\n", stats->handshakes_failed);
+    if (stats->resumed > 0) {
+        printf("  Resumed:         %lu (0-RTT %lu)\n", stats->resumed, stats->early_data);
+    }
+    if (stats->hello_retries > 0) {
+        printf("  HelloRetry:      %lu\n", stats->hello_retries);
+    }
+    printf("  Elapsed:         %.2f s\n", stats->elapsed_s);
+    if (stats->elapsed_s > 0) {
+        printf("  Throughput:      %.1f handshakes/s\n", stats->handshakes_ok / stats->elapsed_s);
+    }
+    if (stats->handshakes_ok > 0) {
+        printf("  Mean handshake:  %.3f ms\n", stats->handshake_ms_sum / stats->handshakes_ok);
+    }
+    uint64_t full = stats->handshakes_ok - stats->resumed;
+    if (full > 0) {
+        printf("  Per full handshake (worker thread): CPU %.3f ms, cycles %lu, instructions %lu\n",
+               stats->cpu_ns_sum / 1e6 / full, stats->cpu_cycles_sum / full,
+               stats->instructions_sum / full);
+        printf("  Per full handshake TCP: segments out %.1f, retransmits %.2f, server flight rounds %.2f\n",
+               (double)stats->segs_out_sum / full, (double)stats->retransmits_sum / full,
+               (double)stats->flight_rounds_sum / full);
+        if (mem_track_enabled()) {
+            printf("  Per full handshake heap: peak %lu B, retained %lu B, %.1f allocations\n",
+                   stats->heap_peak_sum / full, stats->heap_retained_sum / full,
+                   (double)stats->heap_allocs_sum / full);
+        }
+    }
+    printf("  SSL objects:     new %lu, reused %lu (SSL_clear), dropped %lu, connection state from heap %lu\n",
+           stats->ssl_new, stats->ssl_reused, stats->ssl_dropped, stats->conn_allocs);
+    if (stats->accepted > 0) {
+        printf("  Syscalls:        %lu (%.1f per connection), socket ops %lu (%.1f per connection)",
+               stats->syscalls, (double)stats->syscalls / stats->accepted,
+               stats->io_ops, (double)stats->io_ops / stats->accepted);
+        if (stats->ring_enters > 0) {
+            printf(", io_uring_enter %lu", stats->ring_enters);
+        }
+        printf("\n");
+    }
+    if (mem_track_enabled()) {
+        printf("  Process heap peak (OpenSSL): %ld B\n", stats->process_heap_peak);
+    }
+}
+
+int engine_reuseport_listeners(struct sockaddr_in *addr, int count, int backlog, bool steer_cpu, int *fds) {
+    int opened = 0;
+    for (; opened < count; opened++) {
+        int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        int one = 1;
+        socklen_t len = sizeof(*addr);
+        if (fd < 0 ||
+            setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) < 0 ||
+            setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &one, sizeof(one)) < 0 ||
+            bind(fd, (struct sockaddr*)addr, sizeof(*addr)) < 0 ||
+            listen(fd, backlog) < 0 ||
+            (opened == 0 && getsockname(fd, (struct sockaddr*)addr, &len) < 0)) {
+            perror("SO_REUSEPORT listener");
+            if (fd >= 0) {
+                close(fd);
+            }
+            break;
+        }
+        fds[opened] = fd;
+    }
+
+    // 그룹 안 인덱스 = 수신 CPU가 허용 CPU 목록에서 몇 번째인지 mod 리스너 수 (pin_cpus 워커 배치와 같음)
+    //  - 목록 밖 CPU는 CPU 번호 mod 리스너 수, 범위를 벗어나면 커널이 해시로 대체
+    bool ok = opened == count;
+    if (ok && steer_cpu) {
+        int cpus[CPU_SETSIZE];
+        int ncpu = allowed_cpus(cpus);
+        struct sock_filter *code = calloc(2 * ncpu + 3, sizeof(struct sock_filter));
+        int len = 0;
+        if (code) {
+            code[len++] = (struct sock_filter){ BPF_LD | BPF_W | BPF_ABS, 0, 0, (uint32_t)(SKF_AD_OFF + SKF_AD_CPU) };
+            for (int p = 0; p < ncpu; p++) {
+                code[len++] = (struct sock_filter){ BPF_JMP | BPF_JEQ | BPF_K, 0, 1, (uint32_t)cpus[p] };
+                code[len++] = (struct sock_filter){ BPF_RET | BPF_K, 0, 0, (uint32_t)(p % count) };
+            }
+            code[len++] = (struct sock_filter){ BPF_ALU | BPF_MOD | BPF_K, 0, 0, (uint32_t)count };
+            code[len++] = (struct sock_filter){ BPF_RET | BPF_A, 0, 0, 0 };
+        }
+        struct sock_fprog prog = { .len = (unsigned short)len, .filter = code };
+        if (!code || setsockopt(fds[0], SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &prog, sizeof(prog)) < 0) {
+            perror("SO_ATTACH_REUSEPORT_CBPF");
+            ok = false;
+        }
+        free(code);
+    }
+    if (!ok) {
+        for (int i = 0; i < opened; i++) {
+            close(fds[i]);
+        }
+        return -1;
+    }
+    return 0;
+}
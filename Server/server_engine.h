@@ -0,0 +1,81 @@
+#ifndef SERVER_ENGINE_H
+#define SERVER_ENGINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <netinet/in.h>
+#include <openssl/ssl.h>
+#include "../Common/pcap_writer.h"
+
+// 이벤트 엔진 설정
+typedef struct {
+    SSL_CTX *ctx;        // 모든 워커가 공유하는 SSL 컨텍스트
+    int listen_fd;       // 공유 리스닝 소켓
+    const int *worker_listen_fds; // 워커별 SO_REUSEPORT 리스너 (num_workers개, NULL: listen_fd 공유)
+    bool pin_cpus;       // 워커 i를 허용 CPU(sched_getaffinity) 중 (i mod 개수)번째에 고정
+    const int *extra_listen_fds;  // 추가 리스너 (조합별 포트, NULL: 없음), 같은 ctx로 수락
+    int extra_listen_count;
+    int num_workers;     // 워커 스레드 수 (스레드마다 epoll 루프 1개)
+    bool verbose;        // 연결별 결과 출력
+    bool nodelay;        // 수락한 소켓에 TCP_NODELAY
+    pcap_file_t *pcap;   // 연결마다 TLS 레코드 기록 (NULL: 안 함, 워커가 공유)
+    int ssl_pool;        // 워커별 미리 만든 연결 슬롯(SSL 객체 + 메트릭) 수, 닫으면 SSL_clear로 재사용 (0: 연결마다 SSL_new/SSL_free)
+    bool release_buffers;   // SSL_MODE_RELEASE_BUFFERS (비어 있는 레코드 버퍼를 바로 해제)
+    bool io_uring;       // epoll 대신 워커별 io_uring (멀티샷 accept/recv, 버퍼 링, 등록 송신 버퍼, BIO pair)
+} engine_config_t;
+
+// 엔진 통계 (워커별 집계 후 합산)
+typedef struct {
+    uint64_t accepted;
+    uint64_t accepted_min;      // 워커별 수락 수 최소/최대 (리스너 분산 편차)
+    uint64_t accepted_max;
+    uint64_t handshakes_ok;
+    uint64_t handshakes_failed;
+    uint64_t resumed;           // PSK 세션 재개
+    uint64_t early_data;        // 0-RTT 요청 수락
+    uint64_t hello_retries;     // HelloRetryRequest를 보낸 핸드셰이크
+    double handshake_ms_sum;
+    uint64_t cpu_cycles_sum;    // 전체(재개 아닌) 핸드셰이크의 워커 스레드 카운터 합
+    uint64_t instructions_sum;
+    uint64_t cpu_ns_sum;
+    uint64_t heap_peak_sum;     // 전체 핸드셰이크의 연결별 OpenSSL 힙 최대값 합 (mem_track)
+    uint64_t heap_retained_sum;
+    uint64_t heap_allocs_sum;   // 전체 핸드셰이크의 OpenSSL 할당 횟수 합 (수락 시 SSL_new 포함)
+    uint64_t segs_out_sum;      // 전체 핸드셰이크 구간 TCP 송신 세그먼트 합 (TCP_INFO)
+    uint64_t retransmits_sum;
+    uint64_t flight_rounds_sum; // 서버 첫 비행이 필요로 한 왕복 수 합 (슬로 스타트 추정)
+    uint64_t ssl_new;           // 수락 경로의 SSL_new
+    uint64_t ssl_reused;        // 슬롯에 보관했다가 재사용한 SSL 객체
+    uint64_t ssl_dropped;       // 재사용할 수 없어 해제 (멈춘 비동기 작업, SSL_clear 실패)
+    uint64_t conn_allocs;       // 빈 슬롯이 없어 힙에서 할당한 연결 상태
+    // 워커 스레드가 커널에 들어간 횟수 (두 경로 모두 연결 종료/정지 시 close와 소켓 옵션 포함)
+    //  epoll: epoll_wait/ctl, accept4, read/write, close / io_uring: io_uring_enter, 동기 close
+    uint64_t syscalls;
+    // 커널이 처리한 소켓 요청 (epoll: accept4/read/write/close 호출, io_uring: 완료 엔트리와 동기 close)
+    uint64_t io_ops;
+    uint64_t ring_enters;       // io_uring: syscalls 중 io_uring_enter
+    int64_t process_heap_peak;  // 프로세스 전체 OpenSSL 힙 최대값 (동시 연결 포함)
+    double elapsed_s;
+} engine_stats_t;
+
+typedef struct server_engine server_engine_t;
+
+// 워커 스레드 시작 (실패 시 NULL)
+server_engine_t* engine_start(const engine_config_t *config);
+
+// 워커마다 SO_REUSEPORT 리스너 count개를 같은 주소에 생성 (실패 시 -1, 만든 소켓은 닫음)
+//  - 바인드/listen 순서 = 그룹 인덱스 = 워커 번호, addr 포트가 0이면 첫 소켓이 받은 포트로 채움
+//  - steer_cpu: SYN을 처리한 CPU가 허용 CPU 중 몇 번째인지(mod count)로 리스너를 고르는 CBPF 연결 (pin_cpus와 함께 사용)
+int engine_reuseport_listeners(struct sockaddr_in *addr, int count, int backlog, bool steer_cpu, int *fds);
+
+// 워커 정지 및 통계 수집 후 해제
+void engine_stop(server_engine_t *engine, engine_stats_t *stats);
+
+// 통계 요약 출력
+void print_engine_stats(const engine_stats_t *stats);
+
+// 닫은 연결의 SSL 객체를 ctx의 다음 연결용으로 초기화 (SSL_clear, 실패 시 false: SSL_free 필요)
+//  - 다중 조합 모드에서 servername 콜백이 바꾼 컨텍스트는 ctx로 되돌림
+bool ssl_recycle(SSL *ssl, SSL_CTX *ctx);
+
+#endif // SERVER_ENGINE_H
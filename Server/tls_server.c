@@ -2,12 +2,26 @@
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <getopt.h>
+#include <signal.h>
+#include <poll.h>
 #include <arpa/inet.h>
 #include <sys/socket.h>
 #include <openssl/ssl.h>
 #include <openssl/err.h>
 #include <openssl/bio.h>
 #include "../Common/metrics.h"
+#include "../Common/tls_context.h"
+#include "../Common/handshake_trace.h"
+#include "../Common/count_bio.h"
+#include "../Common/perf_counters.h"
+#include "../Common/mem_track.h"
+#include "../Common/tcp_stats.h"
+#include "../Common/pcap_writer.h"
+#include "server_engine.h"
+#include "ctx_set.h"
+#include "async_signer.h"
+#include "verify_cache.h"
 
 #define DEFAULT_PORT 4433
 #define BUFFER_SIZE 4096
@@ -19,76 +33,151 @@ typedef struct {
     const char *groups;
     const char *sigalgs;
     int port;
+    int threads;        // 0: 기존 블로킹 루프, N: epoll 워커 N개
+    bool verbose;
+    bool early_data;    // 0-RTT early data 수락
+    bool psk_ke;        // 재개 시 psk_ke(키 교환 없음) 우선
+    bool alloc_pool;    // OpenSSL 할당을 크기 클래스 풀로 처리
+    const char *cert_comp;  // 인증서 압축 선호 목록 (RFC 8879)
+    bool precompress;   // 체인을 시작 시 미리 압축
+    bool nodelay;       // 수락한 소켓에 TCP_NODELAY
+    const char *pcap_dir;   // 연결마다 TLS 레코드를 pcap으로 기록
+    const char *certs_dir;  // 모든 조합을 한 프로세스에서 서비스 (SNI/포트로 선택)
+    bool combo_ports;       // 조합마다 port+1+i 리스너 추가 (SNI 없는 클라이언트용)
+    int async_sign;         // 서명 워커 N개로 CertificateVerify 서명 오프로드 (0: 핸드셰이크 스레드에서 서명)
+    int verify_cache;       // 검증된 클라이언트 체인 캐시 크기 (0: 매번 전체 검증)
+    int verify_cache_ttl;   // 캐시 항목 최대 유지 시간(초)
+    int ssl_pool;           // 워커별 SSL 객체/연결 슬롯 재사용 수 (블로킹 모드는 >0이면 객체 1개 재사용)
+    bool release_buffers;   // SSL_MODE_RELEASE_BUFFERS
+    bool reuseport;         // 워커마다 SO_REUSEPORT 리스너 (공유 리스너 대신)
+    bool cbpf;              // SO_REUSEPORT 그룹에 수신 CPU 조향 CBPF 연결
+    bool pin_cpus;          // 워커 i를 허용 CPU(sched_getaffinity) 중 i번째에 고정
+    bool io_uring;          // 워커 I/O를 epoll 대신 io_uring으로
 } server_config_t;
 
-// OpenSSL 오류 출력
-static void print_ssl_error(const char *msg) {
-    fprintf(stderr, "%s\n", msg);
-    ERR_print_errors_fp(stderr);
-}
+static volatile sig_atomic_t stop_requested = 0;
+static volatile sig_atomic_t invalidate_requested = 0;
 
-// SSL 컨텍스트 생성
-static SSL_CTX* create_context(server_config_t *config) {
-    const SSL_METHOD *method;
-    SSL_CTX *ctx;
+// 체인 캐시와 컨텍스트(조합)별 통계 (단일 조합 모드는 0번만 사용)
+static verify_cache_t *verify_cache = NULL;
+static verify_stats_t verify_stats[ALGO_MAX_COMBOS];
+static int verify_count = 0;
 
-    method = TLS_server_method();
-    ctx = SSL_CTX_new(method);
-    if (!ctx) {
-        print_ssl_error("Unable to create SSL context");
-        return NULL;
-    }
+static void handle_signal(int sig) {
+    (void)sig;
+    stop_requested = 1;
+}
 
-    // TLS 1.3만 사용
-    SSL_CTX_set_min_proto_version(ctx, TLS1_3_VERSION);
-    SSL_CTX_set_max_proto_version(ctx, TLS1_3_VERSION);
+// SIGHUP: CRL/트러스트 변경 시 캐시 무효화
+static void handle_hup(int sig) {
+    (void)sig;
+    invalidate_requested = 1;
+}
 
-    // Cipher suite 고정: TLS_AES_128_GCM_SHA256
-    if (SSL_CTX_set_ciphersuites(ctx, "TLS_AES_128_GCM_SHA256") != 1) {
-        print_ssl_error("Failed to set cipher suite");
-        SSL_CTX_free(ctx);
-        return NULL;
+static void check_invalidate(void) {
+    if (invalidate_requested && verify_cache) {
+        invalidate_requested = 0;
+        verify_cache_invalidate(verify_cache);
+        printf("Verify cache invalidated\n");
+        fflush(stdout);
     }
+}
 
-    // 그룹 설정 (KEM)
-    if (config->groups && SSL_CTX_set1_groups_list(ctx, config->groups) != 1) {
-        fprintf(stderr, "Warning: Failed to set groups: %s\n", config->groups);
+// 모든 서버 컨텍스트에 체인 캐시 연결 (조합마다 통계 분리)
+static bool setup_verify_cache(const server_config_t *config, SSL_CTX *ctx, const ctx_set_t *set) {
+    verify_cache = verify_cache_new(config->verify_cache, config->verify_cache_ttl);
+    if (!verify_cache) {
+        return false;
     }
-
-    // 서명 알고리즘 설정
-    if (config->sigalgs && SSL_CTX_set1_sigalgs_list(ctx, config->sigalgs) != 1) {
-        fprintf(stderr, "Warning: Failed to set sigalgs: %s\n", config->sigalgs);
+    if (set) {
+        for (int i = 0; i < set->count; i++) {
+            verify_cache_attach(set->entries[i].ctx, verify_cache, &verify_stats[i], set->entries[i].name);
+        }
+        verify_count = set->count;
+    } else {
+        char name[128];
+        snprintf(name, sizeof(name), "%s.%s", config->groups, config->sigalgs ? config->sigalgs : "default");
+        verify_cache_attach(ctx, verify_cache, &verify_stats[0], name);
+        verify_count = 1;
     }
 
-    // 서버 인증서 로드
-    if (SSL_CTX_use_certificate_file(ctx, config->cert_file, SSL_FILETYPE_PEM) <= 0) {
-        print_ssl_error("Failed to load certificate");
-        SSL_CTX_free(ctx);
-        return NULL;
-    }
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = handle_hup;
+    sa.sa_flags = SA_RESTART;
+    sigaction(SIGHUP, &sa, NULL);
+    return true;
+}
 
-    // 서버 개인키 로드
-    if (SSL_CTX_use_PrivateKey_file(ctx, config->key_file, SSL_FILETYPE_PEM) <= 0) {
-        print_ssl_error("Failed to load private key");
-        SSL_CTX_free(ctx);
-        return NULL;
+// 연결에 쓰인 컨텍스트의 캐시 통계
+static const verify_stats_t* verify_stats_for(const ctx_set_t *set, const SSL *ssl) {
+    if (!set) {
+        return &verify_stats[0];
+    }
+    SSL_CTX *ctx = SSL_get_SSL_CTX(ssl);
+    for (int i = 0; i < set->count; i++) {
+        if (set->entries[i].ctx == ctx) {
+            return &verify_stats[i];
+        }
     }
+    return NULL;
+}
 
-    // mTLS 설정: 클라이언트 인증서 요구
-    SSL_CTX_set_verify(ctx, SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT, NULL);
-    
-    // CA 인증서 로드
-    if (SSL_CTX_load_verify_locations(ctx, config->ca_file, NULL) != 1) {
-        print_ssl_error("Failed to load CA certificate");
-        SSL_CTX_free(ctx);
-        return NULL;
+static void print_verify_cache(void) {
+    printf("Verify cache (per combo):\n");
+    for (int i = 0; i < verify_count; i++) {
+        if (atomic_load(&verify_stats[i].hits) + atomic_load(&verify_stats[i].misses) +
+            atomic_load(&verify_stats[i].failures) > 0) {
+            verify_stats_print(&verify_stats[i]);
+        }
     }
+    verify_cache_print(verify_cache);
+}
 
-    return ctx;
+// SSL 컨텍스트 설정 (설정은 Common/tls_context.c에서 공유, 다중 조합 모드는 조합별로 인증서/그룹/서명을 바꿔 사용)
+static tls_ctx_config_t context_config(server_config_t *config) {
+    tls_ctx_config_t ctx_config = {
+        .cert_file = config->cert_file,
+        .key_file = config->key_file,
+        .ca_file = config->ca_file,
+        .groups = config->groups,
+        .sigalgs = config->sigalgs,
+        .early_data = config->early_data,
+        .psk_ke = config->psk_ke,
+        .cert_comp = config->cert_comp,
+        .cert_precompress = config->precompress,
+        .libctx = config->async_sign > 0 ? signer_libctx() : NULL,
+        .propq = config->async_sign > 0 ? SIGNER_PROPQ : NULL,
+        .async = config->async_sign > 0
+    };
+    return ctx_config;
+}
+
+// 리스너 중 하나에서 연결 수락 (블로킹, 리스너가 여러 개면 poll)
+static int accept_any(int sock, const int *extra, int extra_count, struct sockaddr_in *addr) {
+    int fd = sock;
+    if (extra_count > 0) {
+        struct pollfd pfds[ALGO_MAX_COMBOS + 1];
+        pfds[0] = (struct pollfd){ .fd = sock, .events = POLLIN };
+        for (int i = 0; i < extra_count; i++) {
+            pfds[i + 1] = (struct pollfd){ .fd = extra[i], .events = POLLIN };
+        }
+        if (poll(pfds, extra_count + 1, -1) < 0) {
+            return -1;
+        }
+        for (int i = 0; i <= extra_count; i++) {
+            if (pfds[i].revents & POLLIN) {
+                fd = pfds[i].fd;
+                break;
+            }
+        }
+    }
+    socklen_t len = sizeof(*addr);
+    return accept(fd, (struct sockaddr*)addr, &len);
 }
 
 // 소켓 생성 및 바인딩
-static int create_socket(int port) {
+static int create_socket(int port, int backlog) {
     int sock;
     struct sockaddr_in addr;
 
@@ -113,7 +202,7 @@ static int create_socket(int port) {
         return -1;
     }
 
-    if (listen(sock, 1) < 0) {
+    if (listen(sock, backlog) < 0) {
         perror("Unable to listen");
         close(sock);
         return -1;
@@ -122,15 +211,76 @@ static int create_socket(int port) {
     return sock;
 }
 
-// 클라이언트 처리
-static void handle_client(SSL *ssl, handshake_metrics_t *metrics) {
-    timer_t handshake_timer;
+// --reuseport: 워커마다 같은 포트의 SO_REUSEPORT 리스너 (0번을 대표 소켓으로 반환), 아니면 공유 소켓 1개
+static int create_listeners(const server_config_t *config, int backlog, int *worker_fds) {
+    if (!config->reuseport) {
+        return create_socket(config->port, backlog);
+    }
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(config->port);
+    addr.sin_addr.s_addr = INADDR_ANY;
+    if (engine_reuseport_listeners(&addr, config->threads, backlog, config->cbpf, worker_fds) < 0) {
+        return -1;
+    }
+    return worker_fds[0];
+}
+
+// 대표 소켓 외 워커별 리스너 닫기
+static void close_worker_listeners(const int *worker_fds, int count) {
+    for (int i = 1; worker_fds && i < count; i++) {
+        close(worker_fds[i]);
+    }
+}
+
+// 클라이언트 처리 (heap: 이 연결의 할당 계정, 핸드셰이크 직후 값을 기록)
+static void handle_client(SSL *ssl, const wire_count_t *wire, const mem_account_t *heap,
+                          handshake_metrics_t *metrics) {
+    bench_timer_t handshake_timer;
+    hs_trace_t trace;
+    char buf[BUFFER_SIZE];
+    size_t early_len = 0;
+    int ret = 1;
+    perf_values_t perf_start, perf = {0};
+    tcp_sample_t tcp_start, tcp_end;
     
     init_handshake_metrics(metrics);
+    hs_trace_attach(ssl, &trace);
+    tcp_sample(SSL_get_fd(ssl), &tcp_start);
     start_timer(&handshake_timer);
+    perf_begin(&perf_start);
     
-    // SSL 핸드셰이크
-    if (SSL_accept(ssl) <= 0) {
+    // 0-RTT: 핸드셰이크 완료 전에 early data(클라이언트 요청)를 먼저 수신
+    if (SSL_get_max_early_data(ssl) > 0) {
+        for (;;) {
+            size_t n = 0;
+            int status = SSL_read_early_data(ssl, buf + early_len, sizeof(buf) - 1 - early_len, &n);
+            early_len += n;
+            if (status == SSL_READ_EARLY_DATA_FINISH) {
+                break;
+            }
+            if (status == SSL_READ_EARLY_DATA_ERROR &&
+                SSL_get_error(ssl, -1) == SSL_ERROR_WANT_ASYNC && signer_wait(ssl)) {
+                continue;
+            }
+            if (status == SSL_READ_EARLY_DATA_ERROR) {
+                ret = 0;
+                break;
+            }
+        }
+    }
+    
+    // SSL 핸드셰이크 (서명 오프로드 시 워커가 서명을 마칠 때까지 대기 후 재개)
+    if (ret == 1) {
+        do {
+            ret = SSL_accept(ssl);
+        } while (ret <= 0 && SSL_get_error(ssl, ret) == SSL_ERROR_WANT_ASYNC && signer_wait(ssl));
+    }
+    perf_end(&perf_start, &perf);
+    tcp_sample(SSL_get_fd(ssl), &tcp_end);
+    hs_trace_detach(ssl);
+    if (ret <= 0) {
         print_ssl_error("SSL_accept failed");
         metrics->success = false;
         snprintf(metrics->error_msg, sizeof(metrics->error_msg), "SSL_accept failed");
@@ -139,71 +289,417 @@ static void handle_client(SSL *ssl, handshake_metrics_t *metrics) {
     
     metrics->t_handshake_total_ms = end_timer(&handshake_timer);
     metrics->success = true;
+    hs_trace_fill_metrics(&trace, true, metrics);
+    count_bio_fill_traffic(wire, &metrics->traffic);
+    tcp_fill_traffic(&tcp_start, &tcp_end, true, &metrics->traffic);
+    perf_fill_resources(&perf, &metrics->resources);
+    mem_fill_resources(heap, &metrics->resources);
     
-    // 핸드셰이크 완료 후 클라이언트로부터 메시지 수신
-    char buf[BUFFER_SIZE];
-    int bytes = SSL_read(ssl, buf, sizeof(buf) - 1);
+    metrics->reliability.session_resumption_ok = SSL_session_reused(ssl);
+    metrics->reliability.zero_rtt_ok = early_len > 0;
+    
+    // 핸드셰이크 완료 후 클라이언트로부터 메시지 수신 (0-RTT로 이미 받았으면 생략)
+    int bytes = early_len > 0 ? (int)early_len : SSL_read(ssl, buf, sizeof(buf) - 1);
     if (bytes > 0) {
         buf[bytes] = '\0';
-        printf("Received from client: %s\n", buf);
+        printf("Received from client%s: %s\n", early_len > 0 ? " (early data)" : "", buf);
         
         // 응답 전송
         const char *reply = "OK";
         SSL_write(ssl, reply, strlen(reply));
     }
-    
-    // 메트릭 수집
-    // TODO: BIO를 사용해 실제 트래픽 측정
-    metrics->traffic.bytes_tx_handshake = 0;  // 임시
-    metrics->traffic.bytes_rx_handshake = 0;  // 임시
 }
 
-int main(int argc, char **argv) {
-    if (argc < 5) {
-        fprintf(stderr, "Usage: %s <cert> <key> <ca> <groups> [sigalgs] [port]\n", argv[0]);
-        fprintf(stderr, "Example: %s server.crt server.key ca.crt x25519 ecdsa_secp256r1_sha256 4433\n", argv[0]);
+static void print_usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [options] <cert> <key> <ca> <groups> [sigalgs] [port]\n", prog);
+    fprintf(stderr, "       %s [options] --certs-dir DIR [port]\n", prog);
+    fprintf(stderr, "Example: %s server.crt server.key ca.crt x25519 ecdsa_secp256r1_sha256 4433\n", prog);
+    fprintf(stderr, "\nOptions:\n");
+    fprintf(stderr, "  -t, --threads N   epoll 워커 스레드 N개로 동시 처리 (기본: 단일 블로킹 루프)\n");
+    fprintf(stderr, "  -v, --verbose     워커 모드에서 연결별 결과 출력\n");
+    fprintf(stderr, "  -e, --early-data  세션 재개 시 0-RTT early data 수락\n");
+    fprintf(stderr, "      --psk-ke      클라이언트가 제시하면 psk_ke(키 교환 없는 재개) 선택 (OpenSSL 3.3+)\n");
+    fprintf(stderr, "      --alloc-pool  OpenSSL 할당을 스레드별 크기 클래스 풀로 처리 (할당기 churn 비교)\n");
+    fprintf(stderr, "      --cert-comp LIST  인증서 압축 zlib,brotli,zstd 선호 순서 (RFC 8879, OpenSSL 3.2+)\n");
+    fprintf(stderr, "      --precompress     인증서 체인을 시작 시 한 번 압축 (핸드셰이크마다 압축하지 않음)\n");
+    fprintf(stderr, "      --nodelay     수락한 소켓에 TCP_NODELAY (Nagle 끔)\n");
+    fprintf(stderr, "      --pcap-dir DIR  모든 연결을 DIR/<groups>_<sigalgs>_server.pcap에 이어 기록\n");
+    fprintf(stderr, "      --async-sign N  CertificateVerify 서명/클라이언트 서명 검증을 워커 N개로 오프로드 (SSL_MODE_ASYNC)\n");
+    fprintf(stderr, "      --verify-cache N  검증된 클라이언트 인증서 체인 N개 캐시 (SIGHUP: 무효화)\n");
+    fprintf(stderr, "      --verify-cache-ttl S  캐시 항목 최대 유지 시간 (기본 %d초, 체인 만료가 더 이르면 그때까지)\n",
+            VERIFY_CACHE_DEFAULT_TTL);
+    fprintf(stderr, "      --ssl-pool N      워커마다 SSL 객체 + 연결 슬롯 N개를 미리 만들고 SSL_clear로 재사용\n");
+    fprintf(stderr, "      --release-buffers SSL_MODE_RELEASE_BUFFERS (비어 있는 레코드 버퍼 즉시 해제)\n");
+    fprintf(stderr, "      --reuseport       워커마다 SO_REUSEPORT 리스너 (커널이 연결을 워커별 수락 큐로 분배, -t 필요)\n");
+    fprintf(stderr, "      --cbpf            --reuseport 그룹에 SYN 수신 CPU로 리스너를 고르는 CBPF 연결\n");
+    fprintf(stderr, "      --pin-cpus        워커 i를 허용 CPU 중 i번째에 고정 (pthread_attr_setaffinity_np)\n");
+    fprintf(stderr, "      --io-uring        워커 I/O를 io_uring으로 (멀티샷 accept/recv, 버퍼 링, 등록 송신 버퍼, -t 필요)\n");
+    fprintf(stderr, "\nMulti-combo options:\n");
+    fprintf(stderr, "      --certs-dir DIR   algorithms.conf의 모든 조합을 DIR 인증서로 로드, SNI \"<group>.<sigalg>\"로 선택\n");
+    fprintf(stderr, "      --combo-ports     조합 i를 port+1+i에서도 수락 (SNI 없는 클라이언트는 포트로 선택)\n");
+}
+
+// 이벤트 엔진 모드: SIGINT/SIGTERM까지 실행 후 통계 출력
+static int run_engine_mode(SSL_CTX *ctx, int sock, const int *worker_fds, const int *extra, int extra_count,
+                           server_config_t *config, pcap_file_t *pcap) {
+    engine_config_t engine_config = {
+        .ctx = ctx,
+        .listen_fd = sock,
+        .worker_listen_fds = worker_fds,
+        .pin_cpus = config->pin_cpus,
+        .extra_listen_fds = extra,
+        .extra_listen_count = extra_count,
+        .num_workers = config->threads,
+        .verbose = config->verbose,
+        .nodelay = config->nodelay,
+        .pcap = pcap,
+        .ssl_pool = config->ssl_pool,
+        .release_buffers = config->release_buffers,
+        .io_uring = config->io_uring
+    };
+
+    server_engine_t *engine = engine_start(&engine_config);
+    if (!engine) {
         return 1;
     }
 
+    printf("Event engine running with %d worker(s)\n", config->threads);
+    fflush(stdout);
+
+    while (!stop_requested) {
+        pause();
+        check_invalidate();
+    }
+
+    engine_stats_t stats;
+    engine_stop(engine, &stats);
+    print_engine_stats(&stats);
+    if (config->async_sign > 0) {
+        signer_stats_t signer;
+        signer_pool_stop(&signer);
+        print_signer_stats(&signer);
+    }
+    if (verify_cache) {
+        print_verify_cache();
+    }
+    return 0;
+}
+
+int main(int argc, char **argv) {
     server_config_t config = {
-        .cert_file = argv[1],
-        .key_file = argv[2],
-        .ca_file = argv[3],
-        .groups = argv[4],
-        .sigalgs = argc > 5 ? argv[5] : NULL,
-        .port = argc > 6 ? atoi(argv[6]) : DEFAULT_PORT
+        .port = DEFAULT_PORT,
+        .threads = 0,
+        .verbose = false,
+        .early_data = false,
+        .psk_ke = false,
+        .alloc_pool = false,
+        .cert_comp = NULL,
+        .precompress = false,
+        .nodelay = false,
+        .pcap_dir = NULL,
+        .certs_dir = NULL,
+        .combo_ports = false,
+        .async_sign = 0,
+        .verify_cache = 0,
+        .verify_cache_ttl = VERIFY_CACHE_DEFAULT_TTL,
+        .ssl_pool = 0,
+        .release_buffers = false,
+        .reuseport = false,
+        .cbpf = false,
+        .pin_cpus = false,
+        .io_uring = false
+    };
+
+    static const struct option long_options[] = {
+        {"threads", required_argument, NULL, 't'},
+        {"verbose", no_argument, NULL, 'v'},
+        {"early-data", no_argument, NULL, 'e'},
+        {"psk-ke", no_argument, NULL, 'K'},
+        {"alloc-pool", no_argument, NULL, 'H'},
+        {"cert-comp", required_argument, NULL, 'Z'},
+        {"precompress", no_argument, NULL, 'X'},
+        {"nodelay", no_argument, NULL, 'N'},
+        {"pcap-dir", required_argument, NULL, 'C'},
+        {"certs-dir", required_argument, NULL, 'D'},
+        {"combo-ports", no_argument, NULL, 'P'},
+        {"async-sign", required_argument, NULL, 'A'},
+        {"verify-cache", required_argument, NULL, 'V'},
+        {"verify-cache-ttl", required_argument, NULL, 'T'},
+        {"ssl-pool", required_argument, NULL, 'S'},
+        {"release-buffers", no_argument, NULL, 'B'},
+        {"reuseport", no_argument, NULL, 'R'},
+        {"cbpf", no_argument, NULL, 'F'},
+        {"pin-cpus", no_argument, NULL, 'U'},
+        {"io-uring", no_argument, NULL, 'I'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0}
     };
 
+    int opt;
+    while ((opt = getopt_long(argc, argv, "t:veh", long_options, NULL)) != -1) {
+        switch (opt) {
+        case 't':
+            config.threads = atoi(optarg);
+            break;
+        case 'v':
+            config.verbose = true;
+            break;
+        case 'e':
+            config.early_data = true;
+            break;
+        case 'K':
+            config.psk_ke = true;
+            break;
+        case 'H':
+            config.alloc_pool = true;
+            break;
+        case 'Z':
+            config.cert_comp = optarg;
+            break;
+        case 'X':
+            config.precompress = true;
+            break;
+        case 'N':
+            config.nodelay = true;
+            break;
+        case 'C':
+            config.pcap_dir = optarg;
+            break;
+        case 'D':
+            config.certs_dir = optarg;
+            break;
+        case 'P':
+            config.combo_ports = true;
+            break;
+        case 'A':
+            config.async_sign = atoi(optarg);
+            if (config.async_sign <= 0) {
+                print_usage(argv[0]);
+                return 1;
+            }
+            break;
+        case 'V':
+            config.verify_cache = atoi(optarg);
+            break;
+        case 'T':
+            config.verify_cache_ttl = atoi(optarg);
+            break;
+        case 'S':
+            config.ssl_pool = atoi(optarg);
+            if (config.ssl_pool < 0) {
+                print_usage(argv[0]);
+                return 1;
+            }
+            break;
+        case 'B':
+            config.release_buffers = true;
+            break;
+        case 'R':
+            config.reuseport = true;
+            break;
+        case 'F':
+            config.cbpf = true;
+            break;
+        case 'U':
+            config.pin_cpus = true;
+            break;
+        case 'I':
+            config.io_uring = true;
+            break;
+        default:
+            print_usage(argv[0]);
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    // 워커별 리스너/고정/io_uring은 이벤트 엔진 전용, CBPF는 SO_REUSEPORT 그룹에만 연결 가능
+    if ((config.reuseport || config.pin_cpus || config.io_uring) && config.threads <= 0) {
+        fprintf(stderr, "--reuseport/--pin-cpus/--io-uring require -t N\n");
+        return 1;
+    }
+    if (config.cbpf && !config.reuseport) {
+        fprintf(stderr, "--cbpf requires --reuseport\n");
+        return 1;
+    }
+
+    int nargs = argc - optind;
+    char **args = argv + optind;
+    if (config.certs_dir) {
+        if (nargs > 1) {
+            print_usage(argv[0]);
+            return 1;
+        }
+        if (nargs == 1) {
+            config.port = atoi(args[0]);
+        }
+    } else if (nargs < 4 || config.combo_ports) {
+        print_usage(argv[0]);
+        return 1;
+    } else {
+        config.cert_file = args[0];
+        config.key_file = args[1];
+        config.ca_file = args[2];
+        config.groups = args[3];
+        config.sigalgs = nargs > 4 ? args[4] : NULL;
+        if (nargs > 5) {
+            config.port = atoi(args[5]);
+        }
+    }
+
+    // OpenSSL이 처음 할당하기 전에 메모리 훅 설치
+    mem_track_install(config.alloc_pool);
+
     printf("Starting TLS 1.3 Server (mTLS enabled)...\n");
     printf("Port: %d\n", config.port);
-    printf("Groups: %s\n", config.groups);
-    printf("Sigalgs: %s\n", config.sigalgs ? config.sigalgs : "(default)");
+    if (config.certs_dir) {
+        printf("Certs: %s (all combos)\n", config.certs_dir);
+    } else {
+        printf("Groups: %s\n", config.groups);
+        printf("Sigalgs: %s\n", config.sigalgs ? config.sigalgs : "(default)");
+    }
     printf("Cipher: TLS_AES_128_GCM_SHA256\n");
+    if (config.cert_comp) {
+        printf("Certificate compression: %s%s\n", config.cert_comp,
+               config.precompress ? " (precompressed)" : "");
+    }
+    if (config.threads > 0) {
+        printf("Workers: %d (%s, %s%s%s)\n", config.threads, config.io_uring ? "io_uring" : "epoll",
+               config.reuseport ? "SO_REUSEPORT listener per worker" : "shared listener",
+               config.cbpf ? " + CPU steering CBPF" : "", config.pin_cpus ? ", pinned" : "");
+    }
+    if (config.async_sign > 0) {
+        printf("Signing: offloaded to %d signer thread(s)\n", config.async_sign);
+    }
+    if (config.verify_cache > 0) {
+        printf("Verify cache: %d chains, TTL %d s\n", config.verify_cache, config.verify_cache_ttl);
+    }
+    if (config.ssl_pool > 0 || config.release_buffers) {
+        printf("SSL objects: %s%s\n", config.ssl_pool > 0 ? "recycled with SSL_clear" : "SSL_new per connection",
+               config.release_buffers ? ", SSL_MODE_RELEASE_BUFFERS" : "");
+    }
+
+    // 끊긴 연결에 쓰기 시 종료 방지
+    signal(SIGPIPE, SIG_IGN);
 
     // OpenSSL 초기화
     SSL_load_error_strings();
     OpenSSL_add_ssl_algorithms();
 
-    // SSL 컨텍스트 생성
-    SSL_CTX *ctx = create_context(&config);
-    if (!ctx) {
+    // 서명 오프로드: 서버 컨텍스트를 오프로드 프로바이더가 있는 라이브러리 컨텍스트에서 생성
+    if (config.async_sign > 0 && signer_pool_start(config.async_sign) != 0) {
         return 1;
     }
 
-    // 소켓 생성
-    int sock = create_socket(config.port);
-    if (sock < 0) {
-        SSL_CTX_free(ctx);
+    // SSL 컨텍스트 생성 (모든 워커가 공유, 다중 조합 모드는 조합별 컨텍스트를 시작 시 모두 생성)
+    tls_ctx_config_t ctx_config = context_config(&config);
+    ctx_set_t *set = NULL;
+    SSL_CTX *ctx = NULL;
+    if (config.certs_dir) {
+        set = ctx_set_load(config.certs_dir, &ctx_config);
+        if (!set) {
+            return 1;
+        }
+        if (config.combo_ports) {
+            ctx_set_assign_ports(set, config.port + 1);
+        }
+        ctx_set_print(set);
+        ctx = set->front;
+    } else {
+        ctx = create_server_context(&ctx_config);
+        if (!ctx) {
+            return 1;
+        }
+    }
+    if (config.verify_cache > 0 && !setup_verify_cache(&config, ctx, set)) {
+        if (set) {
+            ctx_set_free(set);
+        } else {
+            SSL_CTX_free(ctx);
+        }
         return 1;
     }
 
-    printf("Server listening on port %d...\n", config.port);
+    // 소켓 생성 (조합별 포트는 추가 리스너)
+    int backlog = config.threads > 0 ? SOMAXCONN : 1;
+    int *worker_fds = config.reuseport ? calloc(config.threads, sizeof(int)) : NULL;
+    int sock = config.reuseport && !worker_fds ? -1 : create_listeners(&config, backlog, worker_fds);
+    int extra[ALGO_MAX_COMBOS];
+    int extra_count = 0;
+    for (int i = 0; sock >= 0 && config.combo_ports && i < set->count; i++) {
+        extra[extra_count] = create_socket(set->entries[i].port, backlog);
+        if (extra[extra_count] < 0) {
+            break;
+        }
+        extra_count++;
+    }
+    if (sock < 0 || (config.combo_ports && extra_count < set->count)) {
+        for (int i = 0; i < extra_count; i++) {
+            close(extra[i]);
+        }
+        if (sock >= 0) {
+            close(sock);
+            close_worker_listeners(worker_fds, config.threads);
+        }
+        free(worker_fds);
+        if (set) {
+            ctx_set_free(set);
+        } else {
+            SSL_CTX_free(ctx);
+        }
+        return 1;
+    }
+
+    if (extra_count > 0) {
+        printf("Server listening on port %d (SNI) and %d..%d (per combo)...\n", config.port,
+               set->entries[0].port, set->entries[extra_count - 1].port);
+    } else if (config.reuseport) {
+        printf("Server listening on port %d (%d SO_REUSEPORT sockets)...\n", config.port, config.threads);
+    } else {
+        printf("Server listening on port %d...\n", config.port);
+    }
+
+    pcap_file_t *pcap = NULL;
+    if (config.pcap_dir) {
+        char path[512];
+        if (set) {
+            pcap_combo_path(path, sizeof(path), config.pcap_dir, "multi", "sni", "server");
+        } else {
+            pcap_combo_path(path, sizeof(path), config.pcap_dir, config.groups, config.sigalgs, "server");
+        }
+        pcap = pcap_open(path, true);
+        printf("Capturing TLS records to %s\n", path);
+    }
 
-    // 클라이언트 연결 대기
+    if (config.threads > 0) {
+        struct sigaction sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sa_handler = handle_signal;
+        sigaction(SIGINT, &sa, NULL);
+        sigaction(SIGTERM, &sa, NULL);
+
+        int rc = run_engine_mode(ctx, sock, worker_fds, extra, extra_count, &config, pcap);
+        pcap_close(pcap);
+        close(sock);
+        close_worker_listeners(worker_fds, config.threads);
+        free(worker_fds);
+        for (int i = 0; i < extra_count; i++) {
+            close(extra[i]);
+        }
+        if (set) {
+            ctx_set_print_stats(set);
+            ctx_set_free(set);
+        } else {
+            SSL_CTX_free(ctx);
+        }
+        return rc;
+    }
+
+    // 클라이언트 연결 대기 (--ssl-pool: 이전 연결의 SSL 객체를 SSL_clear 후 재사용)
+    SSL *spare = NULL;
     while (1) {
         struct sockaddr_in addr;
-        socklen_t len = sizeof(addr);
-        int client = accept(sock, (struct sockaddr*)&addr, &len);
+        int client = accept_any(sock, extra, extra_count, &addr);
+        check_invalidate();
         if (client < 0) {
             perror("Unable to accept");
             continue;
@@ -211,21 +707,87 @@ int main(int argc, char **argv) {
 
         printf("Connection from %s:%d\n", 
                inet_ntoa(addr.sin_addr), ntohs(addr.sin_port));
+        if (config.nodelay) {
+            tcp_set_nodelay(client, true);
+        }
 
-        SSL *ssl = SSL_new(ctx);
-        SSL_set_fd(ssl, client);
+        wire_count_t wire;
+        mem_account_t heap = {0};
+        mem_track_switch(&heap);
+        SSL *ssl = spare ? spare : SSL_new(ctx);
+        spare = NULL;
+        if (ssl && config.release_buffers) {
+            SSL_set_mode(ssl, SSL_MODE_RELEASE_BUFFERS);
+        }
+        if (!ssl || !count_bio_attach(ssl, client, &wire)) {
+            print_ssl_error("Failed to create SSL");
+            SSL_free(ssl);
+            mem_track_switch(NULL);
+            close(client);
+            continue;
+        }
+
+        wire.capture = pcap_flow_new(pcap, client, true);
 
         handshake_metrics_t metrics;
-        handle_client(ssl, &metrics);
+        signer_account_t sign = {0};
+        signer_switch(&sign);
+        handle_client(ssl, &wire, &heap, &metrics);
+        signer_switch(NULL);
 
         if (metrics.success) {
-            printf("✅ Handshake successful (%.2f ms)\n", metrics.t_handshake_total_ms);
+            printf("✅ Handshake successful (%.2f ms)%s\n", metrics.t_handshake_total_ms,
+                   metrics.reliability.session_resumption_ok ? " [resumed]" : "");
+            if (set) {
+                printf("  Combo: %s\n", ctx_set_selected(set, ssl));
+            }
+            printf("  ClientHello->ServerHello: %.2f ms, server flight: %.2f ms, client cert verify: %.2f ms\n",
+                   metrics.t_clienthello_to_serverhello_ms, metrics.t_finished_flight_ms,
+                   metrics.t_cert_verify_ms);
+            if (metrics.crypto.hello_retry) {
+                printf("  HelloRetryRequest %u B, client retried after %.2f ms (first ClientHello %u B)\n",
+                       metrics.traffic.msg_bytes.hello_retry_request, metrics.t_hello_retry_ms,
+                       metrics.traffic.msg_bytes.client_hello_initial);
+            }
+            printf("  Wire bytes: tx %lu, rx %lu (%u records), Certificate %u, CertificateVerify %u\n",
+                   metrics.traffic.bytes_tx_handshake, metrics.traffic.bytes_rx_handshake,
+                   metrics.traffic.records_count, metrics.traffic.msg_bytes.server_certificate,
+                   metrics.traffic.msg_bytes.server_certificate_verify);
+            printf("  TCP: segments out %u / in %u, retransmits %u, cwnd %u x %u B, rtt %u us, "
+                   "first flight %u B in %u round(s)\n",
+                   metrics.traffic.segs_out, metrics.traffic.segs_in, metrics.traffic.retransmits,
+                   metrics.traffic.snd_cwnd, metrics.traffic.snd_mss, metrics.traffic.tcp_rtt_us,
+                   metrics.traffic.server_flight_bytes, metrics.traffic.server_flight_rounds);
+            printf("  CPU: %.3f ms, cycles %lu, instructions %lu\n",
+                   metrics.resources.cpu_time_ns / 1e6, metrics.resources.cpu_cycles,
+                   metrics.resources.instructions);
+            if (sign.sign_jobs + sign.verify_jobs > 0) {
+                printf("  Signer: queue %.3f ms, sign %lu x %.3f ms, verify %lu x %.3f ms (off the handshake thread)\n",
+                       sign.queue_ns / 1e6, sign.sign_jobs, sign.sign_ns / 1e6, sign.verify_jobs,
+                       sign.verify_ns / 1e6);
+            }
+            const verify_stats_t *verify = verify_cache ? verify_stats_for(set, ssl) : NULL;
+            if (verify) {
+                printf("  Verify cache: hits %lu, misses %lu (this combo)\n",
+                       (unsigned long)atomic_load(&verify->hits), (unsigned long)atomic_load(&verify->misses));
+            }
+            if (mem_track_enabled()) {
+                printf("  Heap: peak %lu B, retained %lu B, %lu allocations\n",
+                       metrics.resources.peak_heap_bytes, metrics.resources.heap_retained_bytes,
+                       metrics.resources.heap_allocs);
+            }
         } else {
             printf("❌ Handshake failed: %s\n", metrics.error_msg);
         }
 
         SSL_shutdown(ssl);
-        SSL_free(ssl);
+        if (config.ssl_pool > 0 && ssl_recycle(ssl, ctx)) {
+            spare = ssl;
+        } else {
+            SSL_free(ssl);
+        }
+        mem_track_switch(NULL);
+        pcap_flow_free(wire.capture);
         close(client);
     }
 
@@ -0,0 +1,244 @@
+#include "verify_cache.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <pthread.h>
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+
+typedef struct {
+    unsigned char hash[32];
+    time_t expires;
+    uint64_t generation;
+    uint64_t stamp;             // 저장 순서 (세트 안 축출 기준)
+    bool used;
+} cache_slot_t;
+
+typedef struct {
+    pthread_mutex_t lock;
+    cache_slot_t *slots;
+    uint64_t clock;
+} cache_shard_t;
+
+struct verify_cache {
+    cache_shard_t shards[VERIFY_CACHE_SHARDS];
+    int sets;                   // 샤드당 세트 수 (세트마다 VERIFY_CACHE_WAYS 슬롯)
+    int ttl_s;
+    atomic_uint_fast64_t generation;
+    atomic_uint_fast64_t inserts;
+    atomic_uint_fast64_t evictions;
+    atomic_uint_fast64_t expired;
+    atomic_uint_fast64_t invalidated;
+};
+
+static uint64_t thread_cpu_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// 피어 체인 해시: 리프와 중간 인증서 각각의 SHA-256을 이어서 다시 SHA-256
+static bool chain_hash(X509_STORE_CTX *store, unsigned char out[32]) {
+    X509 *leaf = X509_STORE_CTX_get0_cert(store);
+    STACK_OF(X509) *untrusted = X509_STORE_CTX_get0_untrusted(store);
+    EVP_MD_CTX *md = EVP_MD_CTX_new();
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    unsigned int len = 0;
+    bool ok = leaf && md && EVP_DigestInit_ex(md, EVP_sha256(), NULL) == 1;
+
+    for (int i = -1; ok && i < sk_X509_num(untrusted); i++) {
+        X509 *cert = i < 0 ? leaf : sk_X509_value(untrusted, i);
+        // 피어가 리프를 체인에 다시 넣어 보내면 건너뜀
+        if (i >= 0 && cert == leaf) {
+            continue;
+        }
+        ok = X509_digest(cert, EVP_sha256(), digest, &len) == 1 &&
+             EVP_DigestUpdate(md, digest, len) == 1;
+    }
+    ok = ok && EVP_DigestFinal_ex(md, out, &len) == 1 && len == 32;
+    EVP_MD_CTX_free(md);
+    return ok;
+}
+
+// 검증된 체인의 가장 이른 만료 시각까지 남은 초 (TTL로 제한)
+static time_t chain_expires(X509_STORE_CTX *store, time_t now, int ttl_s) {
+    STACK_OF(X509) *chain = X509_STORE_CTX_get0_chain(store);
+    time_t expires = now + ttl_s;
+    for (int i = 0; i < sk_X509_num(chain); i++) {
+        int days = 0, secs = 0;
+        if (!ASN1_TIME_diff(&days, &secs, NULL, X509_get0_notAfter(sk_X509_value(chain, i)))) {
+            return now;
+        }
+        time_t left = now + (time_t)days * 86400 + secs;
+        if (left < expires) {
+            expires = left;
+        }
+    }
+    return expires;
+}
+
+static cache_slot_t* set_of(verify_cache_t *cache, const unsigned char hash[32], cache_shard_t **shard) {
+    *shard = &cache->shards[hash[0] % VERIFY_CACHE_SHARDS];
+    uint32_t index = ((uint32_t)hash[1] << 24 | (uint32_t)hash[2] << 16 | (uint32_t)hash[3] << 8 | hash[4]);
+    return &(*shard)->slots[(index % (uint32_t)cache->sets) * VERIFY_CACHE_WAYS];
+}
+
+static bool cache_lookup(verify_cache_t *cache, const unsigned char hash[32], time_t now) {
+    cache_shard_t *shard;
+    cache_slot_t *set = set_of(cache, hash, &shard);
+    uint64_t generation = atomic_load(&cache->generation);
+    bool hit = false;
+
+    pthread_mutex_lock(&shard->lock);
+    for (int i = 0; i < VERIFY_CACHE_WAYS; i++) {
+        cache_slot_t *slot = &set[i];
+        if (!slot->used || memcmp(slot->hash, hash, 32) != 0) {
+            continue;
+        }
+        if (slot->generation != generation) {
+            slot->used = false;
+            atomic_fetch_add(&cache->invalidated, 1);
+        } else if (slot->expires <= now) {
+            slot->used = false;
+            atomic_fetch_add(&cache->expired, 1);
+        } else {
+            hit = true;
+        }
+        break;
+    }
+    pthread_mutex_unlock(&shard->lock);
+    return hit;
+}
+
+static void cache_insert(verify_cache_t *cache, const unsigned char hash[32], time_t expires) {
+    cache_shard_t *shard;
+    cache_slot_t *set = set_of(cache, hash, &shard);
+
+    pthread_mutex_lock(&shard->lock);
+    cache_slot_t *victim = &set[0];
+    for (int i = 0; i < VERIFY_CACHE_WAYS; i++) {
+        cache_slot_t *slot = &set[i];
+        if (slot->used && memcmp(slot->hash, hash, 32) == 0) {
+            victim = slot;
+            break;
+        }
+        if (!slot->used) {
+            if (victim->used) {
+                victim = slot;
+            }
+        } else if (victim->used && slot->stamp < victim->stamp) {
+            victim = slot;
+        }
+    }
+    if (victim->used && memcmp(victim->hash, hash, 32) != 0) {
+        atomic_fetch_add(&cache->evictions, 1);
+    }
+    memcpy(victim->hash, hash, 32);
+    victim->expires = expires;
+    victim->generation = atomic_load(&cache->generation);
+    victim->stamp = ++shard->clock;
+    victim->used = true;
+    pthread_mutex_unlock(&shard->lock);
+    atomic_fetch_add(&cache->inserts, 1);
+}
+
+// SSL_CTX_set_cert_verify_callback: 적중이면 X509_verify_cert 없이 성공
+static int verify_callback(X509_STORE_CTX *store, void *arg) {
+    verify_stats_t *stats = arg;
+    uint64_t start = thread_cpu_ns();
+    time_t now = time(NULL);
+    unsigned char hash[32];
+    bool hashed = chain_hash(store, hash);
+
+    if (hashed && cache_lookup(stats->cache, hash, now)) {
+        X509_STORE_CTX_set_error(store, X509_V_OK);
+        atomic_fetch_add(&stats->hits, 1);
+        atomic_fetch_add(&stats->hit_cpu_ns, thread_cpu_ns() - start);
+        return 1;
+    }
+
+    int ok = X509_verify_cert(store) > 0;
+    if (!ok) {
+        atomic_fetch_add(&stats->failures, 1);
+        return 0;
+    }
+    if (hashed) {
+        time_t expires = chain_expires(store, now, stats->cache->ttl_s);
+        if (expires > now) {
+            cache_insert(stats->cache, hash, expires);
+        }
+    }
+    atomic_fetch_add(&stats->misses, 1);
+    atomic_fetch_add(&stats->miss_cpu_ns, thread_cpu_ns() - start);
+    return 1;
+}
+
+verify_cache_t* verify_cache_new(int capacity, int ttl_s) {
+    if (capacity <= 0 || ttl_s <= 0) {
+        fprintf(stderr, "Invalid verify cache size/TTL: %d entries, %d s\n", capacity, ttl_s);
+        return NULL;
+    }
+    verify_cache_t *cache = calloc(1, sizeof(verify_cache_t));
+    if (!cache) {
+        return NULL;
+    }
+    int per_shard = (capacity + VERIFY_CACHE_SHARDS - 1) / VERIFY_CACHE_SHARDS;
+    cache->sets = (per_shard + VERIFY_CACHE_WAYS - 1) / VERIFY_CACHE_WAYS;
+    cache->ttl_s = ttl_s;
+    for (int i = 0; i < VERIFY_CACHE_SHARDS; i++) {
+        pthread_mutex_init(&cache->shards[i].lock, NULL);
+        cache->shards[i].slots = calloc((size_t)cache->sets * VERIFY_CACHE_WAYS, sizeof(cache_slot_t));
+        if (!cache->shards[i].slots) {
+            verify_cache_free(cache);
+            return NULL;
+        }
+    }
+    return cache;
+}
+
+void verify_cache_attach(SSL_CTX *ctx, verify_cache_t *cache, verify_stats_t *stats, const char *name) {
+    memset(stats, 0, sizeof(verify_stats_t));
+    stats->cache = cache;
+    snprintf(stats->name, sizeof(stats->name), "%s", name);
+    SSL_CTX_set_cert_verify_callback(ctx, verify_callback, stats);
+}
+
+void verify_cache_invalidate(verify_cache_t *cache) {
+    atomic_fetch_add(&cache->generation, 1);
+}
+
+void verify_stats_print(const verify_stats_t *stats) {
+    uint64_t hits = atomic_load(&stats->hits);
+    uint64_t misses = atomic_load(&stats->misses);
+    double hit_ms = hits ? atomic_load(&stats->hit_cpu_ns) / 1e6 / hits : 0;
+    double miss_ms = misses ? atomic_load(&stats->miss_cpu_ns) / 1e6 / misses : 0;
+    printf("  %-42s hits %lu, misses %lu, failed %lu", stats->name, (unsigned long)hits,
+           (unsigned long)misses, (unsigned long)atomic_load(&stats->failures));
+    if (hits > 0 && misses > 0) {
+        double saved = hits * (miss_ms - hit_ms);
+        printf(", verify CPU %.3f ms (miss) / %.3f ms (hit), saved %.1f ms (%.3f ms per handshake)",
+               miss_ms, hit_ms, saved, saved / (hits + misses));
+    }
+    printf("\n");
+}
+
+void verify_cache_print(const verify_cache_t *cache) {
+    printf("  capacity %d, stored %lu, evicted %lu, expired %lu, invalidated %lu (generation %lu)\n",
+           cache->sets * VERIFY_CACHE_WAYS * VERIFY_CACHE_SHARDS,
+           (unsigned long)atomic_load(&cache->inserts), (unsigned long)atomic_load(&cache->evictions),
+           (unsigned long)atomic_load(&cache->expired), (unsigned long)atomic_load(&cache->invalidated),
+           (unsigned long)atomic_load(&cache->generation));
+}
+
+void verify_cache_free(verify_cache_t *cache) {
+    if (!cache) {
+        return;
+    }
+    for (int i = 0; i < VERIFY_CACHE_SHARDS; i++) {
+        pthread_mutex_destroy(&cache->shards[i].lock);
+        free(cache->shards[i].slots);
+    }
+    free(cache);
+}
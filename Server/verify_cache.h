@@ -0,0 +1,47 @@
+#ifndef VERIFY_CACHE_H
+#define VERIFY_CACHE_H
+
+#include <stdint.h>
+#include <stdatomic.h>
+#include <openssl/ssl.h>
+
+// 검증된 클라이언트 인증서 체인 캐시 (SSL_CTX_set_cert_verify_callback)
+//  - 키: 피어가 보낸 체인(리프 + 중간 인증서) 각 SHA-256의 SHA-256
+//  - 체인 최소 notAfter 또는 TTL까지, verify_cache_invalidate(CRL/트러스트 변경) 전까지 X509_verify_cert 생략
+//  - 캐시는 트러스트 저장소와 검증 파라미터가 같은 컨텍스트끼리만 공유 (이 서버는 모든 조합이 같은 CA)
+//  - CertificateVerify(핸드셰이크 서명) 검증은 키 소유 증명이므로 캐시와 관계없이 매번 수행
+#define VERIFY_CACHE_SHARDS 16      // 샤드마다 잠금 1개
+#define VERIFY_CACHE_WAYS 8         // 세트 연관: 세트 안에서 가장 오래된 항목을 축출
+#define VERIFY_CACHE_DEFAULT_TTL 300
+
+typedef struct verify_cache verify_cache_t;
+
+// 컨텍스트(조합)별 통계, 콜백 인자 (verify_cache_attach가 초기화)
+typedef struct {
+    verify_cache_t *cache;
+    char name[128];
+    atomic_uint_fast64_t hits;
+    atomic_uint_fast64_t misses;        // 전체 검증 후 캐시에 저장
+    atomic_uint_fast64_t failures;      // 검증 실패 (저장하지 않음)
+    atomic_uint_fast64_t hit_cpu_ns;    // 콜백 안 스레드 CPU 시간 합 (해시 + 조회)
+    atomic_uint_fast64_t miss_cpu_ns;   // 해시 + X509_verify_cert + 저장
+} verify_stats_t;
+
+// 최대 capacity개 체인 (샤드/세트 단위로 올림), ttl_s: 항목 최대 유지 시간
+verify_cache_t* verify_cache_new(int capacity, int ttl_s);
+
+// ctx의 인증서 검증을 캐시 경유로 교체 (name: 출력용 조합 이름)
+void verify_cache_attach(SSL_CTX *ctx, verify_cache_t *cache, verify_stats_t *stats, const char *name);
+
+// 모든 항목 무효화 (세대 증가, CRL 재적재 등)
+void verify_cache_invalidate(verify_cache_t *cache);
+
+// 조합별 한 줄: 적중/미스, 검증 CPU, 절약한 핸드셰이크 CPU (= 적중 × (미스 평균 - 적중 평균))
+void verify_stats_print(const verify_stats_t *stats);
+
+// 캐시 전체: 용량, 저장/축출/만료/무효화 수
+void verify_cache_print(const verify_cache_t *cache);
+
+void verify_cache_free(verify_cache_t *cache);
+
+#endif // VERIFY_CACHE_H
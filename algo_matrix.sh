@@ -0,0 +1,46 @@
+#!/bin/bash
+
+# 알고리즘 매트릭스(algorithms.conf) 조회 스크립트
+# 셸 스크립트가 조합 목록을 하드코딩하지 않도록 C 도구와 같은 파일을 읽는다
+#
+# 사용법:
+#   ./algo_matrix.sh combos           "<group> <sigalg> <OpenSSL 그룹> <OpenSSL 서명> <인증서 키>" 한 줄씩
+#   ./algo_matrix.sh groups [KIND...] 그룹 이름 (classic, pqc, hybrid로 거름)
+
+set -e
+
+MATRIX="${ALGO_MATRIX:-$(dirname "$0")/algorithms.conf}"
+
+if [ ! -f "$MATRIX" ]; then
+    echo "알고리즘 매트릭스가 없습니다: $MATRIX" >&2
+    exit 1
+fi
+
+case "$1" in
+    combos)
+        awk '
+            { sub(/#.*/, "") }
+            $1 == "group"  { group_ossl[$2] = $3 }
+            $1 == "sigalg" { sig_ossl[$2] = $3; sig_key[$2] = $4 }
+            $1 == "combo"  {
+                if (!($2 in group_ossl) || !($3 in sig_ossl)) {
+                    printf "%s:%d: combo refers to an undeclared group or sigalg\n", FILENAME, NR > "/dev/stderr"
+                    exit 1
+                }
+                print $2, $3, group_ossl[$2], sig_ossl[$3], sig_key[$3]
+            }
+        ' "$MATRIX"
+        ;;
+    groups)
+        shift
+        awk -v kinds="$*" '
+            BEGIN { n = split(kinds, k, " "); for (i = 1; i <= n; i++) want[k[i]] = 1 }
+            { sub(/#.*/, "") }
+            $1 == "group" && (n == 0 || ($4 in want)) { print $2 }
+        ' "$MATRIX"
+        ;;
+    *)
+        echo "Usage: $0 combos | groups [classic|pqc|hybrid ...]" >&2
+        exit 1
+        ;;
+esac
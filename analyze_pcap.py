@@ -0,0 +1,280 @@
+#!/usr/bin/env python3
+"""
+pcap 핸드셰이크 비행(flight) 분석
+- tls_client/tls_server/bench_driver --pcap-dir 로 기록한 파일(또는 tcpdump 캡처)을 읽음
+- 연결별로 TLS 레코드를 재조립하고 같은 방향으로 연속된 레코드를 한 비행으로 묶음
+- 비행별 바이트, MSS 세그먼트 수, 초기 cwnd 슬로 스타트 왕복 수를 출력
+"""
+
+import argparse
+import json
+import struct
+import sys
+from pathlib import Path
+from typing import Dict, List, Optional, Tuple
+
+LINKTYPE_ETHERNET = 1
+LINKTYPE_RAW = 101
+TLS_RECORD_HEADER = 5
+# HelloRetryRequest: ServerHello random이 SHA-256("HelloRetryRequest") (레코드 헤더 + 메시지 헤더 + legacy_version 뒤)
+HRR_RANDOM = bytes.fromhex("cf21ad74e59a6111be1d8c021e65b891c2a211167abb8c5e079e09e2c8a8339c")
+HRR_RANDOM_OFFSET = TLS_RECORD_HEADER + 4 + 2
+HELLO_RETRY_REQUEST = 256
+
+# TLS 1.3에서는 핸드셰이크 메시지도 암호화되어 application_data(23)로 보이므로 "enc"로 표기
+CONTENT_TYPES = {20: "ccs", 21: "alert", 22: "handshake", 23: "enc"}
+HANDSHAKE_TYPES = {
+    1: "ClientHello", 2: "ServerHello", 4: "NewSessionTicket", 8: "EncryptedExtensions",
+    11: "Certificate", 13: "CertificateRequest", 15: "CertificateVerify", 20: "Finished",
+    25: "CompressedCertificate", HELLO_RETRY_REQUEST: "HelloRetryRequest",
+}
+
+
+class Record:
+    """TLS 레코드 1개 (마지막 바이트가 도착한 패킷 시각)"""
+    def __init__(self, ts: float, from_client: bool, content_type: int, length: int, hs_type: Optional[int]):
+        self.ts = ts
+        self.from_client = from_client
+        self.content_type = content_type
+        self.length = length          # 헤더 포함 와이어 바이트
+        self.hs_type = hs_type        # 평문 handshake 레코드의 첫 메시지 타입
+
+    def label(self) -> str:
+        if self.content_type == 22 and self.hs_type is not None:
+            return HANDSHAKE_TYPES.get(self.hs_type, f"hs{self.hs_type}")
+        return CONTENT_TYPES.get(self.content_type, f"type{self.content_type}")
+
+
+class Flight:
+    """같은 방향으로 연속된 레코드 묶음"""
+    def __init__(self, from_client: bool):
+        self.from_client = from_client
+        self.records: List[Record] = []
+
+    @property
+    def bytes(self) -> int:
+        return sum(r.length for r in self.records)
+
+    @property
+    def span_ms(self) -> float:
+        return (self.records[-1].ts - self.records[0].ts) * 1000 if self.records else 0.0
+
+    def summary(self) -> str:
+        labels: List[str] = []
+        for r in self.records:
+            name = r.label()
+            if labels and labels[-1].split("×")[0] == name:
+                count = int(labels[-1].split("×")[1]) + 1 if "×" in labels[-1] else 2
+                labels[-1] = f"{name}×{count}"
+            else:
+                labels.append(name)
+        return " ".join(labels)
+
+
+def flight_segments(nbytes: int, mss: int) -> int:
+    return (nbytes + mss - 1) // mss
+
+
+def flight_rounds(nbytes: int, mss: int, cwnd: int) -> int:
+    """cwnd 세그먼트로 시작해 왕복마다 2배가 되는 슬로 스타트로 보내는 데 필요한 왕복 수"""
+    segments = flight_segments(nbytes, mss)
+    rounds = 0
+    while segments > 0:
+        segments -= cwnd
+        cwnd *= 2
+        rounds += 1
+    return rounds
+
+
+def read_packets(path: Path):
+    """(timestamp, ip_packet) 순회 (pcap 마이크로/나노초, 양쪽 바이트 순서)"""
+    data = path.read_bytes()
+    if len(data) < 24:
+        return
+    magic = data[:4]
+    formats = {
+        b"\xd4\xc3\xb2\xa1": ("<", 1e-6), b"\xa1\xb2\xc3\xd4": (">", 1e-6),
+        b"\x4d\x3c\xb2\xa1": ("<", 1e-9), b"\xa1\xb2\x3c\x4d": (">", 1e-9),
+    }
+    if magic not in formats:
+        raise ValueError(f"{path}: not a pcap file (pcapng은 미지원)")
+    endian, unit = formats[magic]
+    linktype = struct.unpack(endian + "I", data[20:24])[0]
+    if linktype not in (LINKTYPE_RAW, LINKTYPE_ETHERNET):
+        raise ValueError(f"{path}: unsupported linktype {linktype}")
+
+    off = 24
+    while off + 16 <= len(data):
+        sec, frac, caplen, _ = struct.unpack(endian + "IIII", data[off:off + 16])
+        off += 16
+        packet = data[off:off + caplen]
+        off += caplen
+        if linktype == LINKTYPE_ETHERNET:
+            if len(packet) < 14 or packet[12:14] != b"\x08\x00":
+                continue
+            packet = packet[14:]
+        yield sec + frac * unit, packet
+
+
+def parse_tcp(packet: bytes) -> Optional[Tuple[Tuple[bytes, int], Tuple[bytes, int], int, int, bytes]]:
+    """IPv4/TCP → (src, dst, seq, flags, payload)"""
+    if len(packet) < 20 or packet[0] >> 4 != 4 or packet[9] != 6:
+        return None
+    ihl = (packet[0] & 0x0F) * 4
+    total = struct.unpack("!H", packet[2:4])[0]
+    tcp = packet[ihl:total]
+    if len(tcp) < 20:
+        return None
+    sport, dport, seq = struct.unpack("!HHI", tcp[:8])
+    doff = (tcp[12] >> 4) * 4
+    return (packet[12:16], sport), (packet[16:20], dport), seq, tcp[13], tcp[doff:]
+
+
+class Connection:
+    """TCP 연결 1개의 양방향 스트림과 TLS 레코드"""
+    def __init__(self, client: Tuple[bytes, int]):
+        self.client = client
+        self.buffers = {True: b"", False: b""}
+        self.records: List[Record] = []
+
+    def add(self, ts: float, from_client: bool, payload: bytes):
+        buf = self.buffers[from_client] + payload
+        while len(buf) >= TLS_RECORD_HEADER:
+            length = TLS_RECORD_HEADER + struct.unpack("!H", buf[3:5])[0]
+            if len(buf) < length:
+                break
+            hs_type = buf[5] if buf[0] == 22 and length > TLS_RECORD_HEADER else None
+            if hs_type == 2 and buf[HRR_RANDOM_OFFSET:HRR_RANDOM_OFFSET + 32] == HRR_RANDOM:
+                hs_type = HELLO_RETRY_REQUEST
+            self.records.append(Record(ts, from_client, buf[0], length, hs_type))
+            buf = buf[length:]
+        self.buffers[from_client] = buf
+
+    def flights(self) -> List[Flight]:
+        result: List[Flight] = []
+        for r in self.records:
+            if not result or result[-1].from_client != r.from_client:
+                result.append(Flight(r.from_client))
+            result[-1].records.append(r)
+        return result
+
+
+def load_connections(path: Path) -> List[Connection]:
+    conns: Dict[Tuple, Connection] = {}
+    order: List[Connection] = []
+    for ts, packet in read_packets(path):
+        parsed = parse_tcp(packet)
+        if not parsed:
+            continue
+        src, dst, _, flags, payload = parsed
+        key = tuple(sorted([src, dst]))
+        conn = conns.get(key)
+        syn_only = flags & 0x02 and not flags & 0x10
+        if conn is None or (syn_only and conn.records):
+            # SYN을 보낸 쪽(없으면 처음 데이터를 보낸 쪽)이 클라이언트, 같은 포트 재사용 시 새 연결
+            conn = Connection(src)
+            conns[key] = conn
+            order.append(conn)
+        if payload:
+            conn.add(ts, src == conn.client, payload)
+    return [c for c in order if c.records]
+
+
+def handshake_flights(conn: Connection) -> List[Flight]:
+    """클라이언트 Finished 비행까지 (암호화 레코드가 있는 서버 비행 다음 클라이언트 비행)
+    HelloRetryRequest 비행은 평문뿐이므로 계속 진행, 이후 티켓/응답/close_notify는 제외"""
+    result = []
+    server_encrypted = False
+    for f in conn.flights():
+        result.append(f)
+        if f.from_client and server_encrypted:
+            break
+        if not f.from_client and any(r.content_type == 23 for r in f.records):
+            server_encrypted = True
+    return result
+
+
+def analyze_file(path: Path, mss: int, initcwnd: int, per_conn: bool) -> Dict:
+    conns = load_connections(path)
+    per_index: Dict[int, List[Flight]] = {}
+    if per_conn:
+        print(f"{path}:")
+    for i, conn in enumerate(conns):
+        flights = handshake_flights(conn)
+        if per_conn:
+            print(f"  connection {i + 1}:")
+            for n, f in enumerate(flights, 1):
+                print(f"    {'C' if f.from_client else 'S'}{n}: {f.bytes:6d} B, "
+                      f"{flight_segments(f.bytes, mss):3d} seg, "
+                      f"{flight_rounds(f.bytes, mss, initcwnd)} rtt  {f.summary()}")
+        for n, f in enumerate(flights):
+            per_index.setdefault(n, []).append(f)
+
+    summary = []
+    for n in sorted(per_index):
+        flights = per_index[n]
+        avg_bytes = sum(f.bytes for f in flights) / len(flights)
+        avg_span = sum(f.span_ms for f in flights) / len(flights)
+        summary.append({
+            "flight": n + 1,
+            "direction": "client" if flights[0].from_client else "server",
+            "connections": len(flights),
+            "records": flights[0].summary(),
+            "bytes": round(avg_bytes, 1),
+            "segments": flight_segments(int(round(avg_bytes)), mss),
+            "rounds": flight_rounds(int(round(avg_bytes)), mss, initcwnd),
+            "span_ms": round(avg_span, 3),
+        })
+    return {"file": str(path), "connections": len(conns), "mss": mss, "initcwnd": initcwnd,
+            "flights": summary}
+
+
+def print_summary(result: Dict):
+    print(f"{result['file']}: {result['connections']} connection(s), "
+          f"MSS {result['mss']}, initcwnd {result['initcwnd']}")
+    print(f"  {'#':>2} {'dir':6} {'bytes':>9} {'seg':>4} {'rtt':>3} {'span ms':>8}  records")
+    extra = 0
+    for f in result["flights"]:
+        extra += max(f["rounds"] - 1, 0)
+        print(f"  {f['flight']:>2} {f['direction']:6} {f['bytes']:>9.1f} {f['segments']:>4} "
+              f"{f['rounds']:>3} {f['span_ms']:>8.3f}  {f['records']}")
+    if extra:
+        print(f"  → initcwnd {result['initcwnd']}에서 비행이 cwnd를 넘어 추가 왕복 {extra}회")
+    print()
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description="pcap의 TLS 핸드셰이크를 비행 단위로 분석")
+    parser.add_argument("pcaps", nargs="+", type=Path, help="pcap 파일 또는 디렉토리(*.pcap)")
+    parser.add_argument("--mss", type=int, default=1460, help="세그먼트 페이로드 크기 (기본 1460)")
+    parser.add_argument("--initcwnd", type=int, default=10, help="초기 혼잡 윈도 세그먼트 (기본 10)")
+    parser.add_argument("--per-conn", action="store_true", help="연결별 비행 출력")
+    parser.add_argument("--json", type=Path, help="요약을 JSON으로 저장")
+    args = parser.parse_args()
+
+    if args.mss <= 0 or args.initcwnd <= 0:
+        parser.error("--mss and --initcwnd must be positive")
+
+    files: List[Path] = []
+    for p in args.pcaps:
+        files.extend(sorted(p.glob("*.pcap")) if p.is_dir() else [p])
+
+    results = []
+    for path in files:
+        try:
+            result = analyze_file(path, args.mss, args.initcwnd, args.per_conn)
+        except (OSError, ValueError) as e:
+            print(f"❌ {e}", file=sys.stderr)
+            continue
+        print_summary(result)
+        results.append(result)
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(results, f, indent=2)
+        print(f"✅ JSON 저장: {args.json}")
+    return 0 if results else 1
+
+
+if __name__ == "__main__":
+    exit(main())
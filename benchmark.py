@@ -1,7 +1,7 @@
 #!/usr/bin/env python3
 """
 PQC Hybrid TLS 벤치마크 자동화 스크립트
-- 13가지 알고리즘 조합 자동 테스트
+- algorithms.conf의 알고리즘 조합 자동 테스트
 - 30회 반복 측정
 - JSON/CSV 결과 출력
 """
@@ -14,7 +14,7 @@ import os
 import signal
 from pathlib import Path
 from datetime import datetime
-from typing import Dict, List, Tuple
+from typing import Dict, List, NamedTuple, Tuple
 import statistics
 
 # 설정
@@ -26,27 +26,37 @@ PCAP_DIR = f"{RESULTS_DIR}/pcap"
 SERVER_BIN = "build/tls_server"
 CLIENT_BIN = "build/tls_client"
 
-# 13가지 알고리즘 조합
-ALGORITHM_COMBOS = [
-    # Baseline
-    ("x25519", "ecdsa_secp256r1_sha256"),
-    
-    # KEM + ECDSA
-    ("mlkem512", "ecdsa_secp256r1_sha256"),
-    ("mlkem768", "ecdsa_secp256r1_sha256"),
-    ("mlkem1024", "ecdsa_secp256r1_sha256"),
-    
-    # KEM + ML-DSA (Dilithium)
-    ("mlkem512", "dilithium2"),
-    ("mlkem512", "dilithium3"),
-    ("mlkem512", "dilithium5"),
-    ("mlkem768", "dilithium2"),
-    ("mlkem768", "dilithium3"),
-    ("mlkem768", "dilithium5"),
-    ("mlkem1024", "dilithium2"),
-    ("mlkem1024", "dilithium3"),
-    ("mlkem1024", "dilithium5"),
-]
+ALGO_MATRIX = os.environ.get("ALGO_MATRIX") or str(Path(__file__).parent / "algorithms.conf")
+
+class AlgoCombo(NamedTuple):
+    """알고리즘 조합 (결과에 쓰는 이름 + 인증서/바이너리에 넘기는 OpenSSL 이름)"""
+    group: str
+    sigalg: str
+    ossl_group: str
+    ossl_sigalg: str
+
+def load_algorithm_matrix(path: str) -> List[AlgoCombo]:
+    """algorithms.conf의 combo 목록 (형식은 파일 머리말 참고)"""
+    groups: Dict[str, str] = {}
+    sigalgs: Dict[str, str] = {}
+    combos: List[AlgoCombo] = []
+    with open(path) as f:
+        for line_no, line in enumerate(f, 1):
+            fields = line.split("#", 1)[0].split()
+            if not fields:
+                continue
+            kind = fields[0]
+            if kind == "group" and len(fields) == 4:
+                groups[fields[1]] = fields[2]
+            elif kind == "sigalg" and len(fields) == 4:
+                sigalgs[fields[1]] = fields[2]
+            elif kind == "combo" and len(fields) == 3 and fields[1] in groups and fields[2] in sigalgs:
+                combos.append(AlgoCombo(fields[1], fields[2], groups[fields[1]], sigalgs[fields[2]]))
+            else:
+                raise ValueError(f"{path}:{line_no}: invalid record")
+    return combos
+
+ALGORITHM_COMBOS = load_algorithm_matrix(ALGO_MATRIX)
 
 class Colors:
     """터미널 색상"""
@@ -164,7 +174,7 @@ def run_single_test(group: str, sigalg: str, run_num: int) -> BenchmarkResult:
         
         # 클라이언트 실행
         client_cmd = [
-            CLIENT_BIN, client_cert, client_key, ca_cert,
+            CLIENT_BIN, "--pcap-dir", PCAP_DIR, client_cert, client_key, ca_cert,
             group, sigalg, "127.0.0.1", str(SERVER_PORT)
         ]
         
@@ -200,13 +210,17 @@ def run_single_test(group: str, sigalg: str, run_num: int) -> BenchmarkResult:
     
     return result
 
-def run_benchmark_for_combo(group: str, sigalg: str, combo_num: int, total_combos: int) -> AggregatedResult:
+def run_benchmark_for_combo(combo: AlgoCombo, combo_num: int, total_combos: int) -> AggregatedResult:
     """알고리즘 조합에 대한 벤치마크 실행"""
     print(f"{Colors.BLUE}━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━{Colors.NC}")
-    print(f"{Colors.BLUE}[{combo_num}/{total_combos}] {group} + {sigalg}{Colors.NC}")
+    print(f"{Colors.BLUE}[{combo_num}/{total_combos}] {combo.group} + {combo.sigalg}{Colors.NC}")
     print(f"{Colors.BLUE}━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━{Colors.NC}")
     
-    agg_result = AggregatedResult(group, sigalg)
+    agg_result = AggregatedResult(combo.group, combo.sigalg)
+    group, sigalg = combo.ossl_group, combo.ossl_sigalg
+    
+    # 클라이언트가 실행마다 이어 기록하므로 이전 캡처 제거 (분석: ./analyze_pcap.py results/pcap)
+    Path(f"{PCAP_DIR}/{group}_{sigalg}_client.pcap").unlink(missing_ok=True)
     
     for run in range(1, RUNS_PER_COMBO + 1):
         result = run_single_test(group, sigalg, run)
@@ -310,8 +324,8 @@ def main():
     # 벤치마크 실행
     all_results = []
     
-    for i, (group, sigalg) in enumerate(ALGORITHM_COMBOS, 1):
-        result = run_benchmark_for_combo(group, sigalg, i, len(ALGORITHM_COMBOS))
+    for i, combo in enumerate(ALGORITHM_COMBOS, 1):
+        result = run_benchmark_for_combo(combo, i, len(ALGORITHM_COMBOS))
         all_results.append(result)
     
     # 결과 저장
@@ -1,7 +1,7 @@
 #!/bin/bash
 
 # PQC Hybrid TLS 인증서 생성 스크립트
-# 13가지 알고리즘 조합에 대한 인증서 생성
+# algorithms.conf의 알고리즘 조합별 인증서 생성
 
 set -e
 
@@ -22,26 +22,24 @@ echo ""
 echo "OpenSSL 버전:"
 $OPENSSL version
 
+# 알고리즘 조합 (cd 전에 읽음)
+mapfile -t COMBOS < <(./algo_matrix.sh combos)
+
 # 인증서 디렉토리 생성
 mkdir -p $CERTS_DIR
 cd $CERTS_DIR
 
-# 알고리즘 조합 배열
-declare -a COMBOS=(
-    "x25519:ecdsa_secp256r1_sha256"
-    "mlkem512:ecdsa_secp256r1_sha256"
-    "mlkem768:ecdsa_secp256r1_sha256"
-    "mlkem1024:ecdsa_secp256r1_sha256"
-    "mlkem512:dilithium2"
-    "mlkem512:dilithium3"
-    "mlkem512:dilithium5"
-    "mlkem768:dilithium2"
-    "mlkem768:dilithium3"
-    "mlkem768:dilithium5"
-    "mlkem1024:dilithium2"
-    "mlkem1024:dilithium3"
-    "mlkem1024:dilithium5"
-)
+# 인증서 키 생성 (algorithms.conf의 "알고리즘[:파라미터]", EC는 곡선, RSA는 비트 수)
+genkey() {
+    local spec="$1" out="$2"
+    local alg="${spec%%:*}" param=""
+    [[ "$spec" == *:* ]] && param="${spec#*:}"
+    case "$alg" in
+        EC)  $OPENSSL genpkey -algorithm EC -pkeyopt ec_paramgen_curve:$param -out "$out" ;;
+        RSA) $OPENSSL genpkey -algorithm RSA -pkeyopt rsa_keygen_bits:${param:-2048} -out "$out" ;;
+        *)   $OPENSSL genpkey -algorithm "$alg" -out "$out" ;;
+    esac
+}
 
 # CA 인증서 생성 (ECDSA - 모든 조합에서 공통 사용)
 echo ""
@@ -60,11 +58,11 @@ fi
 
 # 각 알고리즘 조합에 대해 인증서 생성
 for combo in "${COMBOS[@]}"; do
-    IFS=':' read -r group sigalg <<< "$combo"
+    read -r name_group name_sigalg group sigalg cert_key <<< "$combo"
     
     echo ""
     echo -e "${BLUE}━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━${NC}"
-    echo -e "${BLUE}생성 중: ${group} + ${sigalg}${NC}"
+    echo -e "${BLUE}생성 중: ${name_group} + ${name_sigalg}${NC}"
     echo -e "${BLUE}━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━${NC}"
     
     prefix="${group}_${sigalg}"
@@ -72,15 +70,11 @@ for combo in "${COMBOS[@]}"; do
     # 서버 키 및 인증서 생성
     echo "  🔐 서버 키 생성..."
     
-    if [[ "$sigalg" == "ecdsa_secp256r1_sha256" ]]; then
-        # ECDSA 키 생성
-        $OPENSSL ecparam -name prime256v1 -genkey -out ${prefix}_server.key
-    elif [[ "$sigalg" == "dilithium"* ]]; then
-        # Dilithium 키 생성
-        $OPENSSL genpkey -algorithm $sigalg -out ${prefix}_server.key 2>/dev/null || {
-            echo "  ⚠️  $sigalg 알고리즘을 사용할 수 없습니다. 건너뜁니다."
-            continue
-        }
+    # PQC 키는 프로바이더가 없으면 생성 불가
+    if ! genkey "$cert_key" ${prefix}_server.key 2>/dev/null; then
+        echo "  ⚠️  $cert_key 키를 생성할 수 없습니다. 건너뜁니다."
+        rm -f ${prefix}_server.key
+        continue
     fi
     
     # 서버 CSR 생성
@@ -96,11 +90,7 @@ for combo in "${COMBOS[@]}"; do
     # 클라이언트 키 및 인증서 생성
     echo "  🔐 클라이언트 키 생성..."
     
-    if [[ "$sigalg" == "ecdsa_secp256r1_sha256" ]]; then
-        $OPENSSL ecparam -name prime256v1 -genkey -out ${prefix}_client.key
-    elif [[ "$sigalg" == "dilithium"* ]]; then
-        $OPENSSL genpkey -algorithm $sigalg -out ${prefix}_client.key 2>/dev/null
-    fi
+    genkey "$cert_key" ${prefix}_client.key 2>/dev/null
     
     # 클라이언트 CSR 생성
     $OPENSSL req -new -key ${prefix}_client.key -out ${prefix}_client.csr \
@@ -12,6 +12,8 @@ RESULTS_DIR="results"
 PCAP_DIR="$RESULTS_DIR/pcap"
 SERVER_BIN="build/tls_server"
 CLIENT_BIN="build/tls_client"
+# multi: 모든 조합을 로드한 서버 1개를 유지하고 SNI로 조합 선택, restart: 실행마다 조합별 서버 재시작
+SERVER_MODE="${SERVER_MODE:-multi}"
 
 # 색상
 GREEN='\033[0;32m'
@@ -24,7 +26,7 @@ echo "========================================"
 echo "PQC Hybrid TLS 벤치마크"
 echo "========================================"
 echo "실행 횟수: $RUNS_PER_COMBO per combo"
-echo "포트: $SERVER_PORT"
+echo "포트: $SERVER_PORT, 서버: $SERVER_MODE"
 echo ""
 
 # 디렉토리 생성
@@ -43,22 +45,8 @@ if [ ! -d "$CERTS_DIR" ] || [ ! -f "$CERTS_DIR/ca.crt" ]; then
     exit 1
 fi
 
-# 알고리즘 조합
-declare -a COMBOS=(
-    "x25519:ecdsa_secp256r1_sha256"
-    "mlkem512:ecdsa_secp256r1_sha256"
-    "mlkem768:ecdsa_secp256r1_sha256"
-    "mlkem1024:ecdsa_secp256r1_sha256"
-    "mlkem512:dilithium2"
-    "mlkem512:dilithium3"
-    "mlkem512:dilithium5"
-    "mlkem768:dilithium2"
-    "mlkem768:dilithium3"
-    "mlkem768:dilithium5"
-    "mlkem1024:dilithium2"
-    "mlkem1024:dilithium3"
-    "mlkem1024:dilithium5"
-)
+# 알고리즘 조합 (algorithms.conf, 한 줄: 이름 그룹/서명 + OpenSSL 그룹/서명 + 인증서 키)
+mapfile -t COMBOS < <(./algo_matrix.sh combos)
 
 total_combos=${#COMBOS[@]}
 current=0
@@ -66,13 +54,26 @@ current=0
 echo "총 조합: $total_combos"
 echo ""
 
+# 다중 조합 서버: 스윕 동안 한 번만 기동 (모든 SSL_CTX를 시작 시 생성해 유지)
+MULTI_PID=""
+if [ "$SERVER_MODE" = "multi" ]; then
+    $SERVER_BIN --certs-dir "$CERTS_DIR" $SERVER_PORT > "$RESULTS_DIR/multi_server.log" 2>&1 &
+    MULTI_PID=$!
+    trap 'kill $MULTI_PID 2>/dev/null || true' EXIT
+    sleep 1
+    if ! kill -0 $MULTI_PID 2>/dev/null; then
+        echo -e "${RED}❌ 다중 조합 서버 시작 실패 (로그: $RESULTS_DIR/multi_server.log)${NC}"
+        exit 1
+    fi
+fi
+
 # 각 조합에 대해 벤치마크 실행
 for combo in "${COMBOS[@]}"; do
-    IFS=':' read -r group sigalg <<< "$combo"
+    read -r name_group name_sigalg group sigalg _ <<< "$combo"
     current=$((current + 1))
     
     echo -e "${BLUE}━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━${NC}"
-    echo -e "${BLUE}[$current/$total_combos] $group + $sigalg${NC}"
+    echo -e "${BLUE}[$current/$total_combos] $name_group + $name_sigalg${NC}"
     echo -e "${BLUE}━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━${NC}"
     
     prefix="${group}_${sigalg}"
@@ -90,31 +91,39 @@ for combo in "${COMBOS[@]}"; do
     
     success_count=0
     
+    # 클라이언트가 실행마다 이어 기록하므로 이전 캡처 제거 (분석: ./analyze_pcap.py results/pcap)
+    rm -f "$PCAP_DIR/${prefix}_client.pcap"
+    
     # N회 반복 실행
     for run in $(seq 1 $RUNS_PER_COMBO); do
         printf "  [%2d/%d] " $run $RUNS_PER_COMBO
         
-        # 서버 시작 (백그라운드)
-        $SERVER_BIN "$server_cert" "$server_key" "$ca_cert" "$group" "$sigalg" $SERVER_PORT > /dev/null 2>&1 &
-        SERVER_PID=$!
-        
-        # 서버 시작 대기
-        sleep 0.5
+        if [ -z "$MULTI_PID" ]; then
+            # 서버 시작 (백그라운드)
+            $SERVER_BIN "$server_cert" "$server_key" "$ca_cert" "$group" "$sigalg" $SERVER_PORT > /dev/null 2>&1 &
+            SERVER_PID=$!
+            
+            # 서버 시작 대기
+            sleep 0.5
+        fi
         
-        # 클라이언트 실행
-        if $CLIENT_BIN "$client_cert" "$client_key" "$ca_cert" "$group" "$sigalg" "127.0.0.1" $SERVER_PORT > /dev/null 2>&1; then
+        # 클라이언트 실행 (SNI "<group>.<sigalg>"로 다중 조합 서버의 컨텍스트 선택)
+        if $CLIENT_BIN --pcap-dir "$PCAP_DIR" --sni "$name_group.$name_sigalg" \
+                "$client_cert" "$client_key" "$ca_cert" "$group" "$sigalg" "127.0.0.1" $SERVER_PORT > /dev/null 2>&1; then
             echo -e "${GREEN}✅${NC}"
             success_count=$((success_count + 1))
         else
             echo -e "${RED}❌${NC}"
         fi
         
-        # 서버 종료
-        kill $SERVER_PID 2>/dev/null || true
-        wait $SERVER_PID 2>/dev/null || true
-        
-        # 포트 정리 대기
-        sleep 0.2
+        if [ -z "$MULTI_PID" ]; then
+            # 서버 종료
+            kill $SERVER_PID 2>/dev/null || true
+            wait $SERVER_PID 2>/dev/null || true
+            
+            # 포트 정리 대기
+            sleep 0.2
+        fi
     done
     
     echo -e "  ${GREEN}성공률: $success_count/$RUNS_PER_COMBO ($(awk "BEGIN {printf \"%.1f\", 100*$success_count/$RUNS_PER_COMBO}")%)${NC}"
@@ -128,7 +137,7 @@ echo "========================================"
 echo "결과 디렉토리: $RESULTS_DIR/"
 echo ""
 echo "다음 단계:"
-echo "  1. 결과 분석"
-echo "  2. JSON/CSV 생성 (구현 필요)"
+echo "  1. 결과 분석 (핸드셰이크 비행: ./analyze_pcap.py $PCAP_DIR)"
+echo "  2. JSON/CSV 생성: ./build/bench_driver (프로세스 재시작 없는 측정)"
 echo "========================================"
 
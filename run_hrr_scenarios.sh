@@ -0,0 +1,108 @@
+#!/bin/bash
+
+# PQC Hybrid TLS HelloRetryRequest / key_share 예측 비용 측정 스크립트
+# 클라이언트 제시 목록과 서버 선호 목록을 다르게 주고 추가 왕복, 바이트, CPU를 비교한다
+
+set -e
+
+# 설정
+RUNS="${RUNS:-30}"
+WARMUP="${WARMUP:-5}"
+DELAY_MS="${DELAY_MS:-10}"            # 방향별 지연 (RTT = 2 × DELAY_MS), 0이면 직접 연결
+SIGALG="${SIGALG:-ecdsa_secp256r1_sha256}"
+CERTS_DIR="certs"
+RESULTS_DIR="results"
+DRIVER_BIN="build/bench_driver"
+HRR_CSV="$RESULTS_DIR/hrr_scenarios.csv"
+
+# 색상
+GREEN='\033[0;32m'
+BLUE='\033[0;34m'
+RED='\033[0;31m'
+YELLOW='\033[1;33m'
+NC='\033[0m'
+
+echo "========================================"
+echo "PQC Hybrid TLS HRR / key_share 예측 측정"
+echo "========================================"
+echo "실행 횟수: $RUNS per scenario (warmup $WARMUP), RTT $((DELAY_MS * 2)) ms, 서명 $SIGALG"
+echo ""
+
+mkdir -p $RESULTS_DIR/hrr
+
+# 빌드 확인
+if [ ! -f "$DRIVER_BIN" ]; then
+    echo -e "${YELLOW}⚠️  빌드 파일이 없습니다. 먼저 'make bench'를 실행하세요.${NC}"
+    exit 1
+fi
+
+# 인증서 확인
+if [ ! -d "$CERTS_DIR" ] || [ ! -f "$CERTS_DIR/ca.crt" ]; then
+    echo -e "${YELLOW}⚠️  인증서가 없습니다. 먼저 './generate_certs.sh'를 실행하세요.${NC}"
+    exit 1
+fi
+
+NETEM_ARGS=""
+if [ "$DELAY_MS" != "0" ]; then
+    NETEM_ARGS="--delay $DELAY_MS"
+fi
+
+# 시나리오: 이름|클라이언트 목록|서버 목록 (G = 측정 그룹)
+#  match      : 예측 성공, key_share 1개
+#  hrr        : 클라이언트가 x25519 share만 보내고 서버는 G만 허용 → HRR 1왕복
+#  two_shares : x25519와 G share를 모두 보내 HRR 회피 (ClientHello 증가, OpenSSL 3.5+)
+#  fallback   : 클라이언트는 G share, 서버는 x25519만 허용 → 고전 그룹으로 HRR
+declare -a SCENARIOS=(
+    "match|G|G"
+    "hrr|x25519:G|G"
+    "two_shares|*x25519:*G|G"
+    "fallback|G:x25519|x25519"
+)
+
+# 기본: algorithms.conf의 PQC/하이브리드 그룹 전체
+read -r -a KEM_GROUPS <<< "${KEM_GROUPS:-$(./algo_matrix.sh groups pqc hybrid | tr '\n' ' ')}"
+
+echo "group,scenario,client_groups,server_groups,t_total_ms_mean,t_total_ms_p99,t_hello_retry_ms,hello_retry_rate,key_shares_offered,client_hello_initial,hello_retry_request,client_hello,bytes_tx,bytes_rx,client_cpu_ms,server_cpu_ms" > $HRR_CSV
+
+for group in "${KEM_GROUPS[@]}"; do
+    echo -e "${BLUE}━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━${NC}"
+    echo -e "${BLUE}$group + $SIGALG${NC}"
+    echo -e "${BLUE}━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━${NC}"
+
+    for scenario in "${SCENARIOS[@]}"; do
+        IFS='|' read -r name client_list server_list <<< "$scenario"
+        client_list="${client_list//G/$group}"
+        server_list="${server_list//G/$group}"
+        out_dir="$RESULTS_DIR/hrr/${group}_${name}"
+
+        echo -e "  ${YELLOW}$name${NC}: client $client_list / server $server_list"
+        if ! $DRIVER_BIN -n $RUNS -w $WARMUP -p 0 -c "$group:$SIGALG" $NETEM_ARGS \
+                --client-groups "$client_list" --server-groups "$server_list" \
+                -o "$out_dir" "$CERTS_DIR" > "$out_dir.log" 2>&1; then
+            echo -e "${RED}    ❌ 측정 실패 (로그: $out_dir.log)${NC}"
+            continue
+        fi
+        grep -E "^\s+(key_share|cpu):" "$out_dir.log" | sed 's/^ */    /'
+
+        python3 - "$out_dir/tls13_pqc_benchmark.json" "$group" "$name" "$client_list" "$server_list" >> $HRR_CSV <<'EOF'
+import json, sys
+path, group, name, client_list, server_list = sys.argv[1:]
+r = json.load(open(path))["results"][0]
+s, t, c, res = r["stats"], r["traffic"], r["crypto"], r["resources"]
+mb = t["message_bytes"]
+print(f"{group},{name},{client_list},{server_list},"
+      f"{s['t_handshake_total_ms']['mean']:.3f},{s['t_handshake_total_ms']['p99']:.3f},"
+      f"{s['t_hello_retry_ms']['mean']:.3f},{c['hello_retry']['rate']:.3f},{c['key_shares_offered']},"
+      f"{mb['client_hello_initial']},{mb['hello_retry_request']},{mb['client_hello']},"
+      f"{t['bytes_tx_handshake']},{t['bytes_rx_handshake']},"
+      f"{res['cpu_time_ns'] / 1e6:.3f},{res['server_cpu_time_ns'] / 1e6:.3f}")
+EOF
+    done
+    echo ""
+done
+
+echo "========================================"
+echo -e "${GREEN}✅ HRR 시나리오 측정 완료!${NC}"
+echo "========================================"
+echo "결과: $HRR_CSV"
+echo "========================================"
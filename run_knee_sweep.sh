@@ -0,0 +1,98 @@
+#!/bin/bash
+
+# PQC Hybrid TLS open-loop knee 탐색 스크립트
+# 모든 조합을 로드한 서버를 한 번만 띄우고(SNI로 조합 선택) 도착률을 올려가며 p99 SLO를 만족하는 최대 처리율을 찾는다
+
+set -e
+
+# 설정
+SERVER_PORT=4433
+SERVER_THREADS=$(nproc)
+CLIENT_THREADS=$(nproc)
+SWEEP="${SWEEP:-50:2000:50}"          # start:stop:step (handshakes/s)
+SLO_P99_MS="${SLO_P99_MS:-50}"
+STEP_DURATION="${STEP_DURATION:-5}"   # 단계별 측정 시간(초)
+ARRIVAL="${ARRIVAL:-poisson}"
+CERTS_DIR="certs"
+RESULTS_DIR="results"
+SERVER_BIN="build/tls_server"
+CLIENT_BIN="build/tls_client"
+KNEE_CSV="$RESULTS_DIR/knee_sweep.csv"
+
+# 색상
+GREEN='\033[0;32m'
+BLUE='\033[0;34m'
+RED='\033[0;31m'
+YELLOW='\033[1;33m'
+NC='\033[0m'
+
+echo "========================================"
+echo "PQC Hybrid TLS open-loop knee 탐색"
+echo "========================================"
+echo "Sweep: $SWEEP handshakes/s, 단계당 ${STEP_DURATION}s ($ARRIVAL)"
+echo "p99 SLO: ${SLO_P99_MS} ms"
+echo "서버 워커: $SERVER_THREADS, 클라이언트 스레드: $CLIENT_THREADS"
+echo ""
+
+mkdir -p $RESULTS_DIR
+
+# 빌드 확인
+if [ ! -f "$SERVER_BIN" ] || [ ! -f "$CLIENT_BIN" ]; then
+    echo -e "${YELLOW}⚠️  빌드 파일이 없습니다. 먼저 'make'를 실행하세요.${NC}"
+    exit 1
+fi
+
+# 인증서 확인
+if [ ! -d "$CERTS_DIR" ] || [ ! -f "$CERTS_DIR/ca.crt" ]; then
+    echo -e "${YELLOW}⚠️  인증서가 없습니다. 먼저 './generate_certs.sh'를 실행하세요.${NC}"
+    exit 1
+fi
+
+# 알고리즘 조합 (algorithms.conf, 한 줄: 이름 그룹/서명 + OpenSSL 그룹/서명 + 인증서 키)
+mapfile -t COMBOS < <(./algo_matrix.sh combos)
+
+echo "group,sigalg,knee_handshakes_per_sec,slo_p99_ms" > $KNEE_CSV
+
+total_combos=${#COMBOS[@]}
+current=0
+
+# 다중 조합 서버는 스윕 전체에서 한 번만 시작 (워커 모드, 조합별 SSL_CTX를 시작 시 생성)
+$SERVER_BIN -t $SERVER_THREADS --certs-dir "$CERTS_DIR" $SERVER_PORT > "$RESULTS_DIR/knee_server.log" 2>&1 &
+SERVER_PID=$!
+trap 'kill -INT $SERVER_PID 2>/dev/null || true' EXIT
+sleep 1
+
+for combo in "${COMBOS[@]}"; do
+    read -r name_group name_sigalg group sigalg _ <<< "$combo"
+    current=$((current + 1))
+
+    echo -e "${BLUE}━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━${NC}"
+    echo -e "${BLUE}[$current/$total_combos] $name_group + $name_sigalg${NC}"
+    echo -e "${BLUE}━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━${NC}"
+
+    prefix="${group}_${sigalg}"
+    server_cert="$CERTS_DIR/${prefix}_server.crt"
+    client_cert="$CERTS_DIR/${prefix}_client.crt"
+    client_key="$CERTS_DIR/${prefix}_client.key"
+    ca_cert="$CERTS_DIR/ca.crt"
+
+    if [ ! -f "$server_cert" ] || [ ! -f "$client_cert" ]; then
+        echo -e "${RED}  ❌ 인증서 파일을 찾을 수 없습니다. 건너뜁니다.${NC}"
+        continue
+    fi
+
+    sweep_out=$($CLIENT_BIN -t $CLIENT_THREADS --sweep "$SWEEP" --slo-p99 $SLO_P99_MS \
+        --arrival $ARRIVAL -d $STEP_DURATION --sni "$name_group.$name_sigalg" \
+        "$client_cert" "$client_key" "$ca_cert" "$group" "$sigalg" "127.0.0.1" $SERVER_PORT 2>/dev/null || true)
+
+    echo "$sweep_out" | sed -n '/target\/s/,$p' | sed 's/^/  /'
+    knee=$(echo "$sweep_out" | awk '/^Knee:/ {print $2}')
+    echo "$name_group,$name_sigalg,${knee:-0},$SLO_P99_MS" >> $KNEE_CSV
+    echo ""
+done
+
+echo "========================================"
+echo -e "${GREEN}✅ knee 탐색 완료!${NC}"
+echo "========================================"
+echo "결과: $KNEE_CSV"
+echo "========================================"